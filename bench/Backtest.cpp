@@ -0,0 +1,141 @@
+#include "../include/BacktestRunner.h"
+#include "FlowGenerator.h"
+#include <cstdlib>
+#include <cstring>
+
+// ============================================================================
+// HISTORICAL REPLAY - make backtest
+// ============================================================================
+//
+// Replays recorded order flow (CSV or binary journal) through private engines,
+// one scenario per input x matching algorithm x batch interval, and prints one
+// line per scenario:
+//
+//   backtest scenario=flow.csv/fifo/0us events=1000000 trades=412233 volume=... vwap=100.02 ...
+//
+// Options: --input=path (repeatable) --algorithms=fifo,pro_rata,fifo_pro_rata
+//          --batch-us=0,500 --workers= --tape-dir=
+//          --generate=path --events=N --seed=   (write a synthetic journal; .bin = binary)
+//
+// Replay threads take the "journal" group of $TRADING_THREAD_LAYOUT, e.g.
+// TRADING_THREAD_LAYOUT="journal=2-5" (see include/ThreadPlacement.h).
+
+using namespace TradingSystem;
+using namespace TradingSystem::Bench;
+
+namespace {
+
+    std::vector<std::string> splitList(const std::string& list) {
+        std::vector<std::string> items;
+        std::stringstream stream(list);
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            if (!item.empty()) items.push_back(item);
+        }
+        return items;
+    }
+    
+    bool parseAlgorithm(const std::string& name, MatchingAlgorithm& algorithm) {
+        if (name == "fifo") algorithm = MatchingAlgorithm::FIFO;
+        else if (name == "pro_rata") algorithm = MatchingAlgorithm::PRO_RATA;
+        else if (name == "fifo_pro_rata") algorithm = MatchingAlgorithm::FIFO_PRO_RATA;
+        else return false;
+        return true;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::string> inputs;
+    std::vector<std::string> algorithms = {"fifo", "pro_rata"};
+    std::vector<std::string> batchIntervals = {"0"};
+    unsigned workers = 0;
+    std::string tapeDir;
+    std::string generatePath;
+    size_t generateCount = 1000000;
+    std::uint64_t seed = 42;
+    
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&arg](const char* prefix) -> const char* {
+            size_t length = std::strlen(prefix);
+            return arg.compare(0, length, prefix) == 0 ? arg.c_str() + length : nullptr;
+        };
+        if (auto v = value("--input=")) inputs.push_back(v);
+        else if (auto v = value("--algorithms=")) algorithms = splitList(v);
+        else if (auto v = value("--batch-us=")) batchIntervals = splitList(v);
+        else if (auto v = value("--workers=")) workers = static_cast<unsigned>(std::max(0, std::atoi(v)));
+        else if (auto v = value("--tape-dir=")) tapeDir = v;
+        else if (auto v = value("--generate=")) generatePath = v;
+        else if (auto v = value("--events=")) generateCount = std::strtoull(v, nullptr, 10);
+        else if (auto v = value("--seed=")) seed = std::strtoull(v, nullptr, 10);
+        else {
+            std::cerr << "unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+    
+    if (!generatePath.empty()) {
+        writeFlowFile(generatePath, generateFlow(generateCount, seed));
+        std::cout << "generated " << generateCount << " events into " << generatePath << std::endl;
+        inputs.push_back(generatePath);
+    }
+    if (inputs.empty()) {
+        std::cerr << "nothing to replay: pass --input=path or --generate=path" << std::endl;
+        return 1;
+    }
+    
+    std::vector<BacktestScenario> scenarios;
+    for (const auto& input : inputs) {
+        for (const auto& name : algorithms) {
+            MatchingAlgorithm algorithm;
+            if (!parseAlgorithm(name, algorithm)) {
+                std::cerr << "unknown matching algorithm " << name << std::endl;
+                return 1;
+            }
+            for (const auto& interval : batchIntervals) {
+                BacktestScenario scenario;
+                scenario.inputPath = input;
+                scenario.matchingAlgorithm = algorithm;
+                scenario.batchInterval = std::chrono::microseconds(std::atoll(interval.c_str()));
+                scenario.name = input + "/" + name + "/" + interval + "us";
+                if (!tapeDir.empty()) {
+                    std::string base = input.substr(input.find_last_of('/') + 1);
+                    scenario.tapePath = tapeDir + "/" + base + "." + name + "." + interval + "us.trades.csv";
+                }
+                scenarios.push_back(scenario);
+            }
+        }
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    auto results = BacktestRunner(workers, ThreadLayout::fromEnvironment().group("journal")).run(scenarios);
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    int status = 0;
+    std::uint64_t totalEvents = 0;
+    for (const auto& stats : results) {
+        if (!stats.error.empty()) {
+            std::cerr << "backtest scenario=" << stats.scenario << " error=" << stats.error << std::endl;
+            status = 1;
+            continue;
+        }
+        totalEvents += stats.events;
+        std::cout << "backtest scenario=" << stats.scenario
+                  << " events=" << stats.events
+                  << " malformed=" << stats.malformed
+                  << " rejected=" << stats.rejected
+                  << " trades=" << stats.trades
+                  << " volume=" << stats.volume
+                  << std::fixed << std::setprecision(4)
+                  << " vwap=" << stats.vwap
+                  << " seconds=" << stats.seconds
+                  << std::setprecision(0)
+                  << " events_per_sec=" << stats.eventsPerSecond
+                  << std::defaultfloat << std::endl;
+    }
+    std::cout << "backtest total_events=" << totalEvents << std::fixed << std::setprecision(0)
+              << " wall_events_per_sec=" << (wall > 0 ? totalEvents / wall : 0.0)
+              << std::defaultfloat << std::endl;
+    return status;
+}
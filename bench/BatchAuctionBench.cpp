@@ -0,0 +1,136 @@
+#include "../include/TradingSystemCore.h"
+#include "../include/User.h"
+#include "../include/TradingEngine.h"
+
+// ============================================================================
+// FREQUENT BATCH AUCTION VS CONTINUOUS MATCHING ON ONE CONTENDED SYMBOL
+// ============================================================================
+//
+// Every producer thread hammers the same symbol. Continuous mode reports the
+// latency of each placeOrder call (lock wait + matching); batch mode reports the
+// queue latency from enqueue to batch cut. One result line per run.
+
+using namespace TradingSystem;
+
+class CountingObserver : public TradeObserver {
+public:
+    std::atomic<size_t> trades{0};
+    void onTradeExecuted(const std::shared_ptr<Trade>&) override { trades++; }
+    void onOrderStatusChanged(const std::shared_ptr<Order>&) override {}
+};
+
+struct RunResult {
+    double seconds = 0.0;
+    size_t orders = 0;
+    double avgLatencyNs = 0.0;
+    double maxLatencyNs = 0.0;
+};
+
+// Crossing flow around 100.00 so both modes produce trades
+static void produce(TradingEngine& engine, const Symbol& symbol, int threadIndex,
+                    int orders, std::vector<double>* latencies) {
+    std::mt19937 gen(1234 + threadIndex);
+    std::uniform_int_distribution<> tick(-20, 20);
+    double nsPerCycle = 1e9 / cycleCounterFrequency();
+    
+    for (int i = 0; i < orders; ++i) {
+        OrderType side = (i + threadIndex) % 2 == 0 ? OrderType::BUY : OrderType::SELL;
+        Price price = 100.0 + tick(gen) * 0.05;
+        CycleCount start = readCycleCounter();
+        engine.placeOrder("BENCH", side, symbol, 10, price);
+        if (latencies) {
+            latencies->push_back(static_cast<double>(readCycleCounter() - start) * nsPerCycle);
+        }
+    }
+}
+
+static RunResult runContinuous(TradingEngine& engine, int threads, int ordersPerThread) {
+    Symbol symbol = "CONT" + std::to_string(threads);
+    std::vector<std::vector<double>> latencies(threads);
+    std::vector<std::thread> producers;
+    
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < threads; ++t) {
+        latencies[t].reserve(ordersPerThread);
+        producers.emplace_back(produce, std::ref(engine), symbol, t, ordersPerThread, &latencies[t]);
+    }
+    for (auto& producer : producers) producer.join();
+    
+    RunResult result;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.orders = static_cast<size_t>(threads) * ordersPerThread;
+    double total = 0.0;
+    for (const auto& perThread : latencies) {
+        for (double latency : perThread) {
+            total += latency;
+            result.maxLatencyNs = std::max(result.maxLatencyNs, latency);
+        }
+    }
+    result.avgLatencyNs = total / result.orders;
+    return result;
+}
+
+static RunResult runBatch(TradingEngine& engine, int threads, int ordersPerThread,
+                          std::chrono::microseconds interval) {
+    Symbol symbol = "FBA" + std::to_string(threads);
+    engine.setBatchAuctionInterval(symbol, interval);
+    
+    std::atomic<bool> producing{true};
+    std::thread driver([&]() {
+        while (producing.load()) {
+            engine.runBatchAuctions();
+            std::this_thread::sleep_for(interval / 4);
+        }
+    });
+    
+    std::vector<std::thread> producers;
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < threads; ++t) {
+        producers.emplace_back(produce, std::ref(engine), symbol, t, ordersPerThread, nullptr);
+    }
+    for (auto& producer : producers) producer.join();
+    producing = false;
+    driver.join();
+    engine.setBatchAuctionInterval(symbol, std::chrono::microseconds(0));
+    
+    RunResult result;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    auto stats = engine.getBatchAuctionStats(symbol);
+    result.orders = stats.ordersBatched;
+    result.avgLatencyNs = stats.ordersBatched ? stats.totalQueueLatencyNs / stats.ordersBatched : 0.0;
+    result.maxLatencyNs = stats.maxQueueLatencyNs;
+    return result;
+}
+
+static void report(const char* mode, int threads, const RunResult& result, size_t trades) {
+    std::cout << std::fixed << std::setprecision(1)
+              << "bench=batch_auction mode=" << mode
+              << " threads=" << threads
+              << " orders=" << result.orders
+              << " trades=" << trades
+              << " ops_per_sec=" << result.orders / result.seconds
+              << " avg_latency_ns=" << result.avgLatencyNs
+              << " max_latency_ns=" << result.maxLatencyNs << std::endl;
+}
+
+int main(int argc, char** argv) {
+    int ordersPerThread = argc > 1 ? std::atoi(argv[1]) : 20000;
+    
+    auto& engine = TradingEngine::getInstance();
+    engine.registerUser(std::make_shared<User>("BENCH", "Bench", "0000000000", "bench@test.com"));
+    CountingObserver observer;
+    engine.registerObserver(&observer);
+    
+    for (int threads : {1, 2, 4, 8}) {
+        observer.trades = 0;
+        RunResult continuous = runContinuous(engine, threads, ordersPerThread);
+        report("continuous", threads, continuous, observer.trades);
+        
+        observer.trades = 0;
+        RunResult batch = runBatch(engine, threads, ordersPerThread, std::chrono::milliseconds(1));
+        report("batch_1ms", threads, batch, observer.trades);
+    }
+    
+    engine.unregisterObserver(&observer);
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include "BenchHarness.h"
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<std::uint64_t> allocations{0};
+}
+
+// GLOBAL ALLOCATION COUNTING - relaxed increments keep the overhead to a few ns
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size ? size : 1)) return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+
+namespace TradingSystem::Bench {
+
+    std::uint64_t allocationCount() {
+        return allocations.load(std::memory_order_relaxed);
+    }
+    
+    BenchRunner::BenchRunner(int argc, char** argv) : repetitions_(5) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg.rfind("--filter=", 0) == 0) {
+                filter_ = arg.substr(9);
+            } else if (arg.rfind("--repetitions=", 0) == 0) {
+                repetitions_ = std::max(1, std::atoi(arg.c_str() + 14));
+            }
+        }
+    }
+    
+    void BenchRunner::run(const std::string& name, std::uint64_t ops, const BenchCase& makeCase) {
+        if (!filter_.empty() && name.find(filter_) == std::string::npos) return;
+        
+        // Warm-up instance: faults in code and allocator arenas
+        makeCase()();
+        
+        std::vector<double> nsPerOp;
+        std::vector<double> allocsPerOp;
+        for (int rep = 0; rep < repetitions_; ++rep) {
+            BenchBody body = makeCase();
+            
+            std::uint64_t allocsBefore = allocationCount();
+            auto start = std::chrono::steady_clock::now();
+            body();
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            std::uint64_t allocsAfter = allocationCount();
+            
+            nsPerOp.push_back(std::chrono::duration<double, std::nano>(elapsed).count() / ops);
+            allocsPerOp.push_back(static_cast<double>(allocsAfter - allocsBefore) / ops);
+        }
+        
+        std::sort(nsPerOp.begin(), nsPerOp.end());
+        std::sort(allocsPerOp.begin(), allocsPerOp.end());
+        
+        BenchResult result;
+        result.name = name;
+        result.ops = ops;
+        result.nsPerOp = nsPerOp[nsPerOp.size() / 2];
+        result.opsPerSec = 1e9 / result.nsPerOp;
+        result.allocsPerOp = allocsPerOp[allocsPerOp.size() / 2];
+        results_.push_back(result);
+        
+        std::cout << "bench=" << result.name
+                  << " ops=" << result.ops
+                  << std::fixed << std::setprecision(1)
+                  << " ns_per_op=" << result.nsPerOp
+                  << std::setprecision(0)
+                  << " ops_per_sec=" << result.opsPerSec
+                  << std::setprecision(2)
+                  << " allocs_per_op=" << result.allocsPerOp
+                  << std::defaultfloat << std::endl;
+    }
+    
+    const std::vector<BenchResult>& BenchRunner::getResults() const {
+        return results_;
+    }
+
+} // namespace TradingSystem::Bench
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "../include/TradingSystemCore.h"
+#include <functional>
+
+// ============================================================================
+// MICROBENCHMARK HARNESS - NO EXTERNAL DEPENDENCIES
+// ============================================================================
+//
+// A case is a factory that builds its state untimed and returns the body to time.
+// Each case runs a warm-up plus `repetitions` fresh instances and reports the
+// median, one key=value line per case so runs can be diffed between builds:
+//
+//   bench=book_add_deep ops=100000 ns_per_op=84.1 ops_per_sec=11890606 allocs_per_op=2.00
+//
+// Allocation counts come from the global operator new replacement in
+// BenchHarness.cpp, so every benchmark binary must link it.
+
+namespace TradingSystem::Bench {
+
+    // Heap allocations made by the whole process so far
+    std::uint64_t allocationCount();
+    
+    // The body performs all `ops` operations of one repetition and owns its state
+    using BenchBody = std::function<void()>;
+    using BenchCase = std::function<BenchBody()>;
+    
+    struct BenchResult {
+        std::string name;
+        std::uint64_t ops = 0;
+        double nsPerOp = 0.0;
+        double opsPerSec = 0.0;
+        double allocsPerOp = 0.0;
+    };
+
+    class BenchRunner {
+    private:
+        std::string filter_;
+        int repetitions_;
+        std::vector<BenchResult> results_;
+        
+    public:
+        // Accepts --filter=<substring> and --repetitions=<n>
+        BenchRunner(int argc, char** argv);
+        
+        void run(const std::string& name, std::uint64_t ops, const BenchCase& makeCase);
+        const std::vector<BenchResult>& getResults() const;
+    };
+
+    // Keeps the optimizer from discarding a computed value
+    template <typename T>
+    inline void doNotOptimize(const T& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+} // namespace TradingSystem::Bench
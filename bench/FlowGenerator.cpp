@@ -0,0 +1,64 @@
+#include "FlowGenerator.h"
+#include <cmath>
+#include <fstream>
+
+namespace TradingSystem::Bench {
+
+    std::vector<FlowEvent> generateFlow(size_t count, std::uint64_t seed) {
+        static constexpr std::string_view users[] = {"U1", "U2", "U3", "U4", "U5", "U6", "U7", "U8"};
+        static constexpr std::string_view symbols[] = {"INFY", "TCS", "WIPRO", "HCL"};
+        
+        std::mt19937_64 rng(seed);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        auto pick = [&](size_t size) { return static_cast<size_t>(unit(rng) * size); };
+        
+        std::vector<FlowEvent> events;
+        events.reserve(count);
+        std::vector<FlowEvent> live;   // NEW events that may still be cancelled / modified
+        std::int64_t now = 1700000000000000000LL;
+        double mid = 100.0;
+        
+        for (size_t i = 0; i < count; ++i) {
+            now += 1000 + static_cast<std::int64_t>(unit(rng) * 9000);
+            double roll = unit(rng);
+            FlowEvent event;
+            
+            if (roll < 0.15 && !live.empty()) {
+                size_t index = pick(live.size());
+                event = live[index];
+                if (roll < 0.10) {
+                    event.action = FlowAction::CANCEL;
+                    live[index] = live.back();
+                    live.pop_back();
+                } else {
+                    event.action = FlowAction::MODIFY;
+                    event.quantity = 10 * (1 + static_cast<Quantity>(unit(rng) * 20));
+                }
+            } else {
+                mid = std::max(1.0, mid + (unit(rng) - 0.5) * 0.1);
+                event.action = FlowAction::NEW;
+                event.side = unit(rng) < 0.5 ? OrderType::BUY : OrderType::SELL;
+                event.user = users[pick(std::size(users))];
+                event.symbol = symbols[pick(std::size(symbols))];
+                event.quantity = 10 * (1 + static_cast<Quantity>(unit(rng) * 20));
+                double offset = (unit(rng) - 0.3) * 0.5;
+                double price = event.side == OrderType::BUY ? mid - offset : mid + offset;
+                event.price = std::round(price * 20.0) / 20.0;
+                event.reference = i + 1;
+                live.push_back(event);
+            }
+            event.timestampNs = now;
+            events.push_back(event);
+        }
+        return events;
+    }
+    
+    void writeFlowFile(const std::string& path, const std::vector<FlowEvent>& events) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("cannot write " + path);
+        bool binary = path.size() > 4 && path.compare(path.size() - 4, 4, ".bin") == 0;
+        if (binary) writeBinaryFlow(out, events);
+        else writeCsvFlow(out, events);
+    }
+
+} // namespace TradingSystem::Bench
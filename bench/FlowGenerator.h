@@ -0,0 +1,21 @@
+#pragma once
+
+#include "../include/OrderFlow.h"
+
+// ============================================================================
+// SYNTHETIC JOURNALS FOR THE REPLAY TOOLS
+// ============================================================================
+//
+// A random walk around 100 over a handful of users and symbols: resting limits,
+// about a third of new orders crossing the mid, and cancels / modifies of
+// earlier orders. Ids are views of string literals, so events stay valid after
+// the generator returns.
+
+namespace TradingSystem::Bench {
+
+    std::vector<FlowEvent> generateFlow(size_t count, std::uint64_t seed = 42);
+    
+    // Writes the binary format when the path ends in ".bin", CSV otherwise
+    void writeFlowFile(const std::string& path, const std::vector<FlowEvent>& events);
+
+} // namespace TradingSystem::Bench
@@ -0,0 +1,120 @@
+#include "../include/OrderFlow.h"
+#include "../include/TradingEngine.h"
+#include "BenchHarness.h"
+#include "FlowGenerator.h"
+#include <cstdlib>
+#include <cstring>
+
+// ============================================================================
+// JOURNAL INGESTION THROUGHPUT - make ingest
+// ============================================================================
+//
+// Converts a CSV journal to the binary format once, then reports for each format
+// how fast it parses (best of --repetitions passes over the mapped file) and how
+// fast it loads into a fresh engine in batches:
+//
+//   ingest format=csv stage=parse bytes=52428800 events=1000000 seconds=0.031 gb_per_sec=1.69 events_per_sec=32258064
+//   ingest format=csv stage=load bytes=... events=... seconds=... gb_per_sec=... events_per_sec=...
+//
+// Options: --input=flow.csv (default: a generated journal in /tmp) --binary=path
+//          --events=N --repetitions= --batch= --no-load
+
+using namespace TradingSystem;
+using namespace TradingSystem::Bench;
+
+namespace {
+
+    void report(const char* format, const char* stage, size_t bytes, size_t events, double seconds) {
+        std::cout << "ingest format=" << format << " stage=" << stage
+                  << " bytes=" << bytes << " events=" << events
+                  << std::fixed << std::setprecision(4) << " seconds=" << seconds
+                  << std::setprecision(3) << " gb_per_sec=" << bytes / seconds / 1e9
+                  << std::setprecision(0) << " events_per_sec=" << events / seconds
+                  << std::defaultfloat << std::endl;
+    }
+    
+    // Parse only; every field is consumed so none of the parsing can be discarded
+    void benchParse(const char* format, const MappedFile& file, int repetitions) {
+        double best = 1e30;
+        size_t events = 0;
+        std::uint64_t checksum = 0;
+        for (int r = 0; r < repetitions; ++r) {
+            OrderFlowReader reader(file);
+            FlowEvent event;
+            events = 0;
+            auto start = std::chrono::steady_clock::now();
+            while (reader.next(event)) {
+                checksum += event.reference + event.quantity + event.user.size() + event.symbol.size();
+                ++events;
+            }
+            best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        }
+        doNotOptimize(checksum);
+        report(format, "parse", file.size(), events, best);
+    }
+    
+    void benchLoad(const char* format, const MappedFile& file, size_t batchSize) {
+        auto clock = std::make_shared<SimulatedClock>();
+        TradingEngine engine(clock, std::make_shared<SequentialIdGenerator>("IN"));
+        OrderFlowLoader loader(engine, clock.get(), batchSize);
+        OrderFlowReader reader(file);
+        auto start = std::chrono::steady_clock::now();
+        size_t events = loader.load(reader);
+        report(format, "load", file.size(), events,
+               std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string input;
+    std::string binary;
+    size_t events = 1000000;
+    int repetitions = 5;
+    size_t batchSize = OrderFlowLoader::DEFAULT_BATCH_SIZE;
+    bool load = true;
+    
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&arg](const char* prefix) -> const char* {
+            size_t length = std::strlen(prefix);
+            return arg.compare(0, length, prefix) == 0 ? arg.c_str() + length : nullptr;
+        };
+        if (auto v = value("--input=")) input = v;
+        else if (auto v = value("--binary=")) binary = v;
+        else if (auto v = value("--events=")) events = std::strtoull(v, nullptr, 10);
+        else if (auto v = value("--repetitions=")) repetitions = std::max(1, std::atoi(v));
+        else if (auto v = value("--batch=")) batchSize = std::strtoull(v, nullptr, 10);
+        else if (arg == "--no-load") load = false;
+        else {
+            std::cerr << "unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+    
+    try {
+        if (input.empty()) {
+            input = "/tmp/trading_system_ingest.csv";
+            writeFlowFile(input, generateFlow(events));
+        }
+        if (binary.empty()) binary = input + ".bin";
+        
+        auto start = std::chrono::steady_clock::now();
+        size_t converted = convertCsvToBinary(input, binary);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        MappedFile csv(input);
+        report("csv", "convert", csv.size(), converted, seconds);
+        
+        MappedFile bin(binary);
+        benchParse("csv", csv, repetitions);
+        benchParse("binary", bin, repetitions);
+        if (load) {
+            benchLoad("csv", csv, batchSize);
+            benchLoad("binary", bin, batchSize);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "ingest error=" << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
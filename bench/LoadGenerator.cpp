@@ -0,0 +1,212 @@
+#include "LoadGenerator.h"
+#include "../include/User.h"
+#include "../include/LatencyHistogram.h"
+#include <cmath>
+
+namespace TradingSystem::Bench {
+
+    namespace {
+    
+        class TradeCounter : public TradeObserver {
+        public:
+            std::atomic<std::uint64_t> trades{0};
+            void onTradeExecuted(const std::shared_ptr<Trade>&) override {
+                trades.fetch_add(1, std::memory_order_relaxed);
+            }
+            void onOrderStatusChanged(const std::shared_ptr<Order>&) override {}
+        };
+        
+        struct LiveOrder {
+            OrderId orderId;
+            std::uint32_t user;
+            OrderType side;
+        };
+        
+        Price priceFor(OrderType side, Price mid, int ticks, Price tickSize) {
+            Price price = side == OrderType::BUY ? mid - ticks * tickSize : mid + ticks * tickSize;
+            return std::max(tickSize, std::round(price / tickSize) * tickSize);
+        }
+        
+        // Sleeps through long gaps, then yields for the last stretch so the event
+        // fires close to its due time without pinning a core
+        void waitUntil(std::chrono::steady_clock::time_point due) {
+            auto now = std::chrono::steady_clock::now();
+            if (due - now > std::chrono::microseconds(100)) {
+                std::this_thread::sleep_until(due - std::chrono::microseconds(50));
+            }
+            while (std::chrono::steady_clock::now() < due) std::this_thread::yield();
+        }
+        
+    } // namespace
+    
+    LoadGenerator::LoadGenerator(const LoadConfig& config) : config_(config), runs_(0) {
+        for (int u = 0; u < config_.users; ++u) userIds_.push_back("LOAD" + std::to_string(u));
+    }
+    
+    const LoadConfig& LoadGenerator::getConfig() const {
+        return config_;
+    }
+    
+    void LoadGenerator::setTargetRate(double rate) {
+        config_.targetRate = rate;
+    }
+    
+    // ARRIVAL SCHEDULE - ONE TIME-ORDERED EVENT LIST PER WORKER THREAD
+    // DESIGN DECISION: Bursty arrivals are a non-homogeneous Poisson process
+    // generated by thinning: candidates arrive at the burst rate and are kept with
+    // probability rate(t) / burst rate. The mid walk is global per symbol, so
+    // every worker quotes around the same market.
+    std::vector<std::vector<LoadGenerator::Event>> LoadGenerator::buildSchedule() const {
+        std::mt19937_64 gen(config_.seed + runs_);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        std::uniform_int_distribution<std::uint32_t> userDist(0, config_.users - 1);
+        std::uniform_int_distribution<std::uint32_t> pickDist;
+        std::uniform_int_distribution<Quantity> quantityDist(1, config_.maxQuantity);
+        std::geometric_distribution<int> distanceDist(config_.levelDecay);
+        std::normal_distribution<double> midStep(0.0, config_.midStepTicks);
+        
+        std::vector<double> zipfCdf(config_.symbols);
+        double total = 0.0;
+        for (int k = 0; k < config_.symbols; ++k) {
+            total += 1.0 / std::pow(k + 1, config_.zipfExponent);
+            zipfCdf[k] = total;
+        }
+        for (auto& weight : zipfCdf) weight /= total;
+        
+        double quietRate = config_.targetRate /
+            (1.0 - config_.burstDuty + config_.burstDuty * config_.burstMultiplier);
+        double burstRate = quietRate * config_.burstMultiplier;
+        std::exponential_distribution<double> gapNs(burstRate / 1e9);
+        auto periodNs = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(config_.burstPeriod).count());
+        auto durationNs = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(config_.duration).count());
+            
+        // Mid offsets from initialMid, in ticks
+        std::vector<double> midWalk(config_.symbols, 0.0);
+        double floorTicks = -0.9 * config_.initialMid / config_.tickSize;
+        
+        std::vector<std::vector<Event>> schedule(config_.threads);
+        for (auto& events : schedule) {
+            events.reserve(static_cast<size_t>(config_.targetRate * durationNs / 1e9 / config_.threads) + 16);
+        }
+        
+        for (double at = gapNs(gen); at < durationNs; at += gapNs(gen)) {
+            bool inBurst = std::fmod(at, periodNs) < config_.burstDuty * periodNs;
+            if (!inBurst && uniform(gen) * config_.burstMultiplier > 1.0) continue;
+            
+            Event event;
+            event.atNs = static_cast<std::int64_t>(at);
+            event.symbol = static_cast<std::uint16_t>(
+                std::lower_bound(zipfCdf.begin(), zipfCdf.end(), uniform(gen)) - zipfCdf.begin());
+            event.symbol = std::min<std::uint16_t>(event.symbol, config_.symbols - 1);
+            event.user = userDist(gen);
+            event.pick = pickDist(gen);
+            event.side = uniform(gen) < 0.5 ? OrderType::BUY : OrderType::SELL;
+            event.quantity = quantityDist(gen);
+            
+            double action = uniform(gen);
+            event.action = action < config_.cancelRatio ? Action::CANCEL
+                         : action < config_.cancelRatio + config_.modifyRatio ? Action::MODIFY
+                         : Action::NEW;
+            
+            double& walk = midWalk[event.symbol];
+            if (event.action == Action::NEW) walk = std::max(floorTicks, walk + midStep(gen));
+            event.mid = config_.initialMid + std::round(walk) * config_.tickSize;
+            
+            int distance = 1 + distanceDist(gen);
+            event.ticks = uniform(gen) < config_.marketableRatio ? -distance : distance;
+            
+            schedule[event.user % config_.threads].push_back(event);
+        }
+        return schedule;
+    }
+    
+    LoadReport LoadGenerator::run(TradingEngine& engine) {
+        for (const auto& userId : userIds_) {
+            if (!engine.getUser(userId)) {
+                engine.registerUser(std::make_shared<User>(userId, userId, "0000000000", "load@test.com"));
+            }
+        }
+        
+        std::vector<std::string> symbols;
+        for (int k = 0; k < config_.symbols; ++k) {
+            symbols.push_back("L" + std::to_string(runs_) + "S" + std::to_string(k));
+        }
+        auto schedule = buildSchedule();
+        ++runs_;
+        
+        TradeCounter counter;
+        engine.registerObserver(&counter);
+        
+        // Each worker records into its own histogram; values here are nanoseconds
+        auto histograms = std::make_unique<LatencyHistogram[]>(config_.threads);
+        std::vector<std::uint64_t> rejected(config_.threads, 0);
+        std::vector<std::chrono::steady_clock::time_point> finished(config_.threads);
+        
+        auto start = std::chrono::steady_clock::now() + std::chrono::milliseconds(10);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < config_.threads; ++t) {
+            workers.emplace_back([&, t] {
+                std::vector<LiveOrder> live;
+                Price tick = config_.tickSize;
+                
+                for (const Event& event : schedule[t]) {
+                    auto due = start + std::chrono::nanoseconds(event.atNs);
+                    waitUntil(due);
+                    
+                    const UserId& userId = userIds_[event.user];
+                    bool ok = true;
+                    if (event.action == Action::NEW || live.empty()) {
+                        auto order = engine.placeOrder(userId, event.side, symbols[event.symbol],
+                                                       event.quantity,
+                                                       priceFor(event.side, event.mid, event.ticks, tick));
+                        ok = order != nullptr;
+                        if (ok) live.push_back({order->getOrderId(), event.user, event.side});
+                    } else {
+                        size_t index = event.pick % live.size();
+                        const LiveOrder& target = live[index];
+                        const UserId& owner = userIds_[target.user];
+                        if (event.action == Action::CANCEL) {
+                            ok = engine.cancelOrder(owner, target.orderId);
+                            live[index] = std::move(live.back());
+                            live.pop_back();
+                        } else {
+                            ok = engine.modifyOrder(owner, target.orderId, event.quantity,
+                                                    priceFor(target.side, event.mid, event.ticks, tick));
+                        }
+                    }
+                    
+                    auto done = std::chrono::steady_clock::now();
+                    histograms[t].record(static_cast<CycleCount>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(done - due).count()));
+                    if (!ok) ++rejected[t];
+                    finished[t] = done;
+                }
+            });
+        }
+        for (auto& worker : workers) worker.join();
+        engine.unregisterObserver(&counter);
+        
+        LatencyHistogram merged;
+        LoadReport report;
+        auto last = start;
+        for (int t = 0; t < config_.threads; ++t) {
+            histograms[t].mergeInto(merged);
+            report.rejected += rejected[t];
+            if (!schedule[t].empty()) last = std::max(last, finished[t]);
+        }
+        
+        report.operations = merged.getCount();
+        report.trades = counter.trades.load();
+        report.offeredRate = config_.targetRate;
+        double seconds = std::chrono::duration<double>(last - start).count();
+        report.achievedRate = seconds > 0 ? report.operations / seconds : 0.0;
+        report.p50Ns = static_cast<double>(merged.valueAtQuantile(0.50));
+        report.p99Ns = static_cast<double>(merged.valueAtQuantile(0.99));
+        report.p999Ns = static_cast<double>(merged.valueAtQuantile(0.999));
+        report.maxNs = static_cast<double>(merged.getMax());
+        return report;
+    }
+
+} // namespace TradingSystem::Bench
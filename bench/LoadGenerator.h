@@ -0,0 +1,100 @@
+#pragma once
+
+#include "../include/TradingSystemCore.h"
+#include "../include/TradingEngine.h"
+
+// ============================================================================
+// SYNTHETIC ORDER FLOW - OPEN-LOOP LOAD GENERATOR
+// ============================================================================
+//
+// The whole schedule is generated up front from a seed: arrival times follow a
+// Poisson process whose rate steps up during periodic bursts, symbols are drawn
+// from a Zipf distribution, and new orders are priced around a per-symbol mid
+// that random-walks as flow arrives. Worker threads each own a slice of the users
+// and fire their events at the scheduled times regardless of how far behind the
+// engine is, so latency is measured from the scheduled arrival to completion and
+// queueing delay past saturation shows up in the percentiles instead of being
+// hidden by a slower send rate.
+
+namespace TradingSystem::Bench {
+
+    struct LoadConfig {
+        double targetRate = 20000.0;                 // operations per second, all threads
+        std::chrono::milliseconds duration{2000};
+        int threads = 2;
+        int users = 500;
+        
+        // Symbol popularity: rank k is drawn with weight 1 / k^zipfExponent
+        int symbols = 200;
+        double zipfExponent = 1.1;
+        
+        // Operation mix; whatever is left over are new orders
+        double cancelRatio = 0.30;
+        double modifyRatio = 0.10;
+        
+        // Pricing around each symbol's mid, in ticks
+        Price initialMid = 100.0;
+        Price tickSize = 0.01;
+        double midStepTicks = 0.5;                   // stddev of the mid move per new order
+        double levelDecay = 0.25;                    // geometric p of the distance from mid
+        double marketableRatio = 0.05;               // new orders priced through the mid
+        Quantity maxQuantity = 100;
+        
+        // For burstDuty of every burstPeriod the arrival rate is burstMultiplier
+        // times the quiet rate; the average stays at targetRate
+        std::chrono::milliseconds burstPeriod{100};
+        double burstDuty = 0.1;
+        double burstMultiplier = 8.0;
+        
+        std::uint64_t seed = 42;
+    };
+
+    struct LoadReport {
+        double offeredRate = 0.0;
+        double achievedRate = 0.0;
+        std::uint64_t operations = 0;
+        std::uint64_t rejected = 0;                  // includes cancels of already-filled orders
+        std::uint64_t trades = 0;
+        
+        // Scheduled arrival to completion
+        double p50Ns = 0.0;
+        double p99Ns = 0.0;
+        double p999Ns = 0.0;
+        double maxNs = 0.0;
+    };
+
+    class LoadGenerator {
+    public:
+        enum class Action : std::uint8_t { NEW, CANCEL, MODIFY };
+        
+        struct Event {
+            std::int64_t atNs;                       // offset from the run start
+            Action action;
+            OrderType side;
+            std::uint16_t symbol;
+            std::uint32_t user;
+            std::uint32_t pick;                      // selects the live order to cancel/modify
+            Quantity quantity;
+            Price mid;                               // symbol mid when the event was generated
+            int ticks;                               // distance from mid, negative = marketable
+        };
+        
+    private:
+        LoadConfig config_;
+        std::vector<std::string> userIds_;
+        int runs_;
+        
+        std::vector<std::vector<Event>> buildSchedule() const;
+        
+    public:
+        explicit LoadGenerator(const LoadConfig& config);
+        
+        // Registers the load users on first use and drives `engine` for one run;
+        // every run trades a fresh set of symbols so books do not carry over
+        LoadReport run(TradingEngine& engine);
+        
+        const LoadConfig& getConfig() const;
+        void setTargetRate(double rate);
+    };
+
+} // namespace TradingSystem::Bench
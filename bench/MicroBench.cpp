@@ -0,0 +1,291 @@
+#include "BenchHarness.h"
+#include "../include/User.h"
+#include "../include/OrderBook.h"
+#include "../include/TradingEngine.h"
+#include "../include/LatencyHistogram.h"
+#include "../include/OrderGateway.h"
+
+// ============================================================================
+// CORE ENGINE MICROBENCHMARKS - make bench
+// ============================================================================
+//
+// Book cases pre-build their orders so only the book operation is timed; each
+// book case runs on the engine's default book and on the single-writer shard
+// book. Engine cases go through the full placeOrder path (user lookup, throttle,
+// book lookup, matching, observers).
+
+using namespace TradingSystem;
+using namespace TradingSystem::Bench;
+
+namespace {
+
+    constexpr std::uint64_t BOOK_OPS = 100000;
+    constexpr std::uint64_t ENGINE_OPS = 50000;
+    
+    using Orders = std::vector<std::shared_ptr<Order>>;
+    
+    // Non-crossing bids spread over `levels` prices below 100.00
+    Orders makeBids(const std::string& prefix, std::uint64_t count, int levels) {
+        Orders orders;
+        orders.reserve(count);
+        for (std::uint64_t i = 0; i < count; ++i) {
+            Price price = 100.0 - 0.01 * static_cast<double>(1 + i % levels);
+            orders.push_back(std::make_shared<LimitOrder>(
+                prefix + std::to_string(i), "BENCH", OrderType::BUY, "MICRO", 10, price));
+        }
+        return orders;
+    }
+    
+    template <typename Book>
+    BenchCase addCase(int levels) {
+        return [levels] {
+            auto book = std::make_shared<Book>("MICRO");
+            auto orders = std::make_shared<Orders>(makeBids("A", BOOK_OPS, levels));
+            return BenchBody([book, orders] {
+                for (const auto& order : *orders) book->addOrder(order);
+            });
+        };
+    }
+    
+    // Cancels a populated book in shuffled order
+    template <typename Book>
+    BenchCase cancelCase(int levels) {
+        return [levels] {
+            auto book = std::make_shared<Book>("MICRO");
+            auto ids = std::make_shared<std::vector<OrderId>>();
+            for (const auto& order : makeBids("C", BOOK_OPS, levels)) {
+                book->addOrder(order);
+                ids->push_back(order->getOrderId());
+            }
+            std::shuffle(ids->begin(), ids->end(), std::mt19937(7));
+            return BenchBody([book, ids] {
+                for (const auto& id : *ids) book->cancelOrder(id);
+            });
+        };
+    }
+    
+    // Quote-style flow: every new order is followed by the cancel of an older one
+    template <typename Book>
+    BenchCase cancelHeavyCase() {
+        return [] {
+            auto book = std::make_shared<Book>("MICRO");
+            auto orders = std::make_shared<Orders>(makeBids("Q", BOOK_OPS / 2, 50));
+            return BenchBody([book, orders] {
+                const size_t lag = 16;
+                for (size_t i = 0; i < orders->size(); ++i) {
+                    book->addOrder((*orders)[i]);
+                    if (i >= lag) book->cancelOrder((*orders)[i - lag]->getOrderId());
+                }
+            });
+        };
+    }
+    
+    template <typename Book>
+    BenchCase modifyCase() {
+        return [] {
+            auto book = std::make_shared<Book>("MICRO");
+            auto ids = std::make_shared<std::vector<OrderId>>();
+            for (const auto& order : makeBids("M", BOOK_OPS, 100)) {
+                book->addOrder(order);
+                ids->push_back(order->getOrderId());
+            }
+            return BenchBody([book, ids] {
+                Quantity quantity = 5;
+                for (const auto& id : *ids) {
+                    book->modifyOrder(id, quantity, 99.50);
+                    quantity = quantity == 5 ? 15 : 5;
+                }
+            });
+        };
+    }
+    
+    // Each op is one aggressive buy that sweeps `depth` single-order ask levels
+    template <typename Book>
+    BenchCase sweepCase(int depth) {
+        return [depth] {
+            auto book = std::make_shared<Book>("MICRO");
+            std::uint64_t sweeps = BOOK_OPS / depth;
+            for (std::uint64_t i = 0; i < sweeps * depth; ++i) {
+                book->addOrder(std::make_shared<LimitOrder>(
+                    "S" + std::to_string(i), "BENCH", OrderType::SELL, "MICRO", 10,
+                    100.0 + 0.01 * static_cast<double>(i)));
+            }
+            auto buys = std::make_shared<Orders>();
+            for (std::uint64_t i = 0; i < sweeps; ++i) {
+                buys->push_back(std::make_shared<LimitOrder>(
+                    "B" + std::to_string(i), "BENCH", OrderType::BUY, "MICRO", 10 * depth,
+                    100.0 + 0.01 * static_cast<double>((i + 1) * depth)));
+            }
+            return BenchBody([book, buys] {
+                for (const auto& buy : *buys) {
+                    book->addOrder(buy);
+                    doNotOptimize(book->matchOrders().size());
+                }
+            });
+        };
+    }
+    
+    template <typename Book>
+    void runBookCases(BenchRunner& runner, const std::string& bookName) {
+        runner.run("book_add_shallow/" + bookName, BOOK_OPS, addCase<Book>(8));
+        runner.run("book_add_deep/" + bookName, BOOK_OPS, addCase<Book>(5000));
+        runner.run("book_cancel/" + bookName, BOOK_OPS, cancelCase<Book>(100));
+        runner.run("book_cancel_heavy/" + bookName, BOOK_OPS / 2, cancelHeavyCase<Book>());
+        runner.run("book_modify/" + bookName, BOOK_OPS, modifyCase<Book>());
+        runner.run("book_sweep_1/" + bookName, BOOK_OPS, sweepCase<Book>(1));
+        runner.run("book_sweep_10/" + bookName, BOOK_OPS / 10, sweepCase<Book>(10));
+    }
+    
+    // Engine cases use a fresh symbol per repetition so books do not grow across runs
+    std::string nextSymbol(const std::string& prefix) {
+        static std::atomic<int> counter{0};
+        return prefix + std::to_string(counter++);
+    }
+    
+    BenchCase enginePlaceCase(bool crossing) {
+        return [crossing] {
+            auto symbol = std::make_shared<std::string>(nextSymbol(crossing ? "XMAT" : "XADD"));
+            return BenchBody([symbol, crossing] {
+                auto& engine = TradingEngine::getInstance();
+                for (std::uint64_t i = 0; i < ENGINE_OPS; ++i) {
+                    OrderType side = crossing && i % 2 ? OrderType::SELL : OrderType::BUY;
+                    Price price = crossing ? 100.0 : 100.0 - 0.01 * static_cast<double>(i % 50);
+                    doNotOptimize(engine.placeOrder("BENCH", side, *symbol, 10, price));
+                }
+            });
+        };
+    }
+    
+    // Same flow as enginePlaceCase, submitted through placeOrders in batches
+    BenchCase enginePlaceBatchCase(bool crossing, size_t batchSize) {
+        return [crossing, batchSize] {
+            auto requests = std::make_shared<std::vector<OrderRequest>>(ENGINE_OPS);
+            std::string symbol = nextSymbol(crossing ? "XBMT" : "XBAD");
+            for (std::uint64_t i = 0; i < ENGINE_OPS; ++i) {
+                OrderRequest& request = (*requests)[i];
+                request.userId = "BENCH";
+                request.symbol = symbol;
+                request.orderType = crossing && i % 2 ? OrderType::SELL : OrderType::BUY;
+                request.quantity = 10;
+                request.price = crossing ? 100.0 : 100.0 - 0.01 * static_cast<double>(i % 50);
+            }
+            return BenchBody([requests, batchSize] {
+                auto& engine = TradingEngine::getInstance();
+                std::vector<std::shared_ptr<Order>> results(batchSize);
+                for (std::uint64_t i = 0; i < ENGINE_OPS; i += batchSize) {
+                    size_t count = std::min<std::uint64_t>(batchSize, ENGINE_OPS - i);
+                    doNotOptimize(engine.placeOrders(std::span(*requests).subspan(i, count), results));
+                }
+            });
+        };
+    }
+    
+    BenchCase engineConcurrentCase(int threads, bool sharedSymbol) {
+        return [threads, sharedSymbol] {
+            auto symbols = std::make_shared<std::vector<std::string>>();
+            std::string shared = nextSymbol("XSHR");
+            for (int t = 0; t < threads; ++t) {
+                symbols->push_back(sharedSymbol ? shared : nextSymbol("XOWN"));
+            }
+            return BenchBody([threads, symbols] {
+                std::vector<std::thread> workers;
+                for (int t = 0; t < threads; ++t) {
+                    workers.emplace_back([t, threads, symbols] {
+                        auto& engine = TradingEngine::getInstance();
+                        for (std::uint64_t i = 0; i < ENGINE_OPS / threads; ++i) {
+                            OrderType side = (i + t) % 2 ? OrderType::SELL : OrderType::BUY;
+                            engine.placeOrder("BENCH", side, (*symbols)[t], 10,
+                                              100.0 + 0.01 * static_cast<double>(i % 7));
+                        }
+                    });
+                }
+                for (auto& worker : workers) worker.join();
+            });
+        };
+    }
+
+    
+    // Same flow as the own-symbol case, but every thread drives a private engine
+    BenchCase engineParallelEnginesCase(int threads) {
+        return [threads] {
+            auto engines = std::make_shared<std::vector<std::unique_ptr<TradingEngine>>>();
+            for (int t = 0; t < threads; ++t) {
+                engines->push_back(std::make_unique<TradingEngine>());
+                engines->back()->registerUser(
+                    std::make_shared<User>("BENCH", "Bench", "0000000000", "bench@test.com"));
+            }
+            return BenchBody([threads, engines] {
+                std::vector<std::thread> workers;
+                for (int t = 0; t < threads; ++t) {
+                    workers.emplace_back([t, threads, engines] {
+                        TradingEngine& engine = *(*engines)[t];
+                        for (std::uint64_t i = 0; i < ENGINE_OPS / threads; ++i) {
+                            OrderType side = (i + t) % 2 ? OrderType::SELL : OrderType::BUY;
+                            engine.placeOrder("BENCH", side, "XENG", 10,
+                                              100.0 + 0.01 * static_cast<double>(i % 7));
+                        }
+                    });
+                }
+                for (auto& worker : workers) worker.join();
+            });
+        };
+    }
+    
+    // One client pipelining through the async gateway: submit everything, then wait
+    // for the queue to drain; the timed span includes polling every completion
+    BenchCase gatewayPipelinedCase(size_t workers, bool publisher) {
+        return [workers, publisher] {
+            auto engine = std::make_shared<TradingEngine>();
+            engine->registerUser(std::make_shared<User>("BENCH", "Bench", "0000000000", "bench@test.com"));
+            GatewayConfig config;
+            config.workers = workers;
+            config.publisher = publisher;
+            auto gateway = std::make_shared<AsyncOrderGateway>(*engine, config);
+            auto queue = gateway->connect("BENCH");
+            return BenchBody([engine, gateway, queue] {
+                for (std::uint64_t i = 0; i < ENGINE_OPS; ++i) {
+                    OrderType side = i % 2 ? OrderType::SELL : OrderType::BUY;
+                    gateway->submitOrder("BENCH", side, "XGTW", 10, 100.0 + 0.01 * static_cast<double>(i % 7));
+                }
+                gateway->flush();
+                Completion completions[256];
+                while (size_t count = queue->poll(completions, 256)) doNotOptimize(count);
+            });
+        };
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchRunner runner(argc, argv);
+    
+    auto& engine = TradingEngine::getInstance();
+    engine.registerUser(std::make_shared<User>("BENCH", "Bench", "0000000000", "bench@test.com"));
+    
+    runBookCases<OrderBook>(runner, "default");
+    runBookCases<ShardOrderBook>(runner, "shard");
+    
+    runner.run("engine_place_resting", ENGINE_OPS, enginePlaceCase(false));
+    runner.run("engine_place_matching", ENGINE_OPS, enginePlaceCase(true));
+    for (size_t batchSize : {16, 256}) {
+        runner.run("engine_place_batch_resting/b" + std::to_string(batchSize),
+                   ENGINE_OPS, enginePlaceBatchCase(false, batchSize));
+        runner.run("engine_place_batch_matching/b" + std::to_string(batchSize),
+                   ENGINE_OPS, enginePlaceBatchCase(true, batchSize));
+    }
+    for (int threads : {2, 4}) {
+        runner.run("engine_place_concurrent_own_symbol/t" + std::to_string(threads),
+                   ENGINE_OPS, engineConcurrentCase(threads, false));
+        runner.run("engine_place_concurrent_shared_symbol/t" + std::to_string(threads),
+                   ENGINE_OPS, engineConcurrentCase(threads, true));
+        runner.run("engine_place_parallel_engines/t" + std::to_string(threads),
+                   ENGINE_OPS, engineParallelEnginesCase(threads));
+    }
+    runner.run("gateway_place_pipelined/w1", ENGINE_OPS, gatewayPipelinedCase(1, false));
+    runner.run("gateway_place_pipelined/w1_publisher", ENGINE_OPS, gatewayPipelinedCase(1, true));
+    
+    // Per-entry-point latency distribution accumulated over all engine cases
+    LatencyMetrics::dump(std::cout);
+    
+    return 0;
+}
@@ -0,0 +1,153 @@
+#include "BenchHarness.h"
+#include "../include/RingQueue.h"
+#include <deque>
+
+// ============================================================================
+// RING QUEUE THROUGHPUT AND LATENCY - make rings
+// ============================================================================
+//
+// Throughput: producers push RING_OPS items in batches of b through one ring to a
+// consumer popping in batches of b; the mutex+deque cases run the same transfer
+// through a mutex-protected deque.
+//
+//   bench=spsc/b32 ops=2000000 ns_per_op=3.1 ops_per_sec=322580645 allocs_per_op=0.00
+//   bench=mpsc/p4/b1 ...   bench=mutex_deque/p4/b1 ...
+//
+// Latency: one producer sends timestamped items one at a time, spaced so the ring
+// stays near empty, and the consumer records send-to-receive time per item:
+//
+//   ring_latency ring=spsc wait=busy-spin samples=20000 p50_ns=95 p99_ns=310 p999_ns=1800 max_ns=41000
+//
+// On a machine with fewer cores than threads the spinning strategies only show
+// scheduler time slices; run on pinned, isolated cores for real numbers.
+
+using namespace TradingSystem;
+using namespace TradingSystem::Bench;
+
+namespace {
+
+    constexpr std::uint64_t RING_OPS = 2000000;
+    constexpr size_t RING_CAPACITY = 4096;
+    constexpr size_t LATENCY_SAMPLES = 20000;
+    
+    // Baseline: a mutex-protected deque, locked once per batch on each side
+    class MutexQueue {
+    private:
+        std::mutex mutex_;
+        std::deque<std::uint64_t> items_;
+        
+    public:
+        explicit MutexQueue(size_t) {}
+        
+        size_t tryPushBatch(std::uint64_t* items, size_t count) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (items_.size() >= RING_CAPACITY) return 0;
+            items_.insert(items_.end(), items, items + count);
+            return count;
+        }
+        
+        size_t tryPopBatch(std::uint64_t* out, size_t max) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            size_t count = std::min(max, items_.size());
+            std::copy(items_.begin(), items_.begin() + count, out);
+            items_.erase(items_.begin(), items_.begin() + count);
+            return count;
+        }
+    };
+
+    // Producers spin-yield on a full queue and the consumer on an empty one, so the
+    // numbers measure the queue rather than a wake-up path
+    template <typename Queue>
+    BenchCase throughputCase(size_t producers, size_t batch) {
+        return [producers, batch] {
+            return BenchBody([producers, batch] {
+                Queue queue(RING_CAPACITY);
+                std::uint64_t perProducer = RING_OPS / producers;
+                std::vector<std::thread> threads;
+                for (size_t p = 0; p < producers; ++p) {
+                    threads.emplace_back([&queue, perProducer, batch] {
+                        std::vector<std::uint64_t> items(batch);
+                        for (std::uint64_t sent = 0; sent < perProducer;) {
+                            size_t count = std::min<std::uint64_t>(batch, perProducer - sent);
+                            for (size_t i = 0; i < count; ++i) items[i] = sent + i;
+                            size_t pushed = 0;
+                            while (pushed < count) {
+                                size_t n = queue.tryPushBatch(items.data() + pushed, count - pushed);
+                                if (n == 0) std::this_thread::yield();
+                                pushed += n;
+                            }
+                            sent += count;
+                        }
+                    });
+                }
+                std::vector<std::uint64_t> out(batch);
+                std::uint64_t sum = 0;
+                for (std::uint64_t received = 0; received < perProducer * producers;) {
+                    size_t n = queue.tryPopBatch(out.data(), batch);
+                    if (n == 0) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    for (size_t i = 0; i < n; ++i) sum += out[i];
+                    received += n;
+                }
+                for (auto& thread : threads) thread.join();
+                doNotOptimize(sum);
+            });
+        };
+    }
+    
+    template <typename Ring>
+    void runLatency(const char* name, WaitStrategy strategy) {
+        using Clock = std::chrono::steady_clock;
+        Ring ring(RING_CAPACITY);
+        std::vector<std::int64_t> samples;
+        samples.reserve(LATENCY_SAMPLES);
+        
+        std::thread consumer([&ring, &samples, strategy] {
+            Clock::rep sent[64];
+            while (samples.size() < LATENCY_SAMPLES) {
+                size_t n = ring.popBatch(sent, 64, strategy);
+                Clock::rep now = Clock::now().time_since_epoch().count();
+                for (size_t i = 0; i < n; ++i) samples.push_back(now - sent[i]);
+            }
+        });
+        for (size_t i = 0; i < LATENCY_SAMPLES; ++i) {
+            ring.push(Clock::now().time_since_epoch().count(), strategy);
+            auto until = Clock::now() + std::chrono::microseconds(5);
+            while (Clock::now() < until) cpuRelax();
+        }
+        consumer.join();
+        
+        std::sort(samples.begin(), samples.end());
+        auto percentile = [&samples](double p) {
+            return samples[std::min(samples.size() - 1, static_cast<size_t>(p * static_cast<double>(samples.size())))];
+        };
+        std::cout << "ring_latency ring=" << name << " wait=" << toString(strategy)
+                  << " samples=" << samples.size() << " p50_ns=" << percentile(0.50)
+                  << " p99_ns=" << percentile(0.99) << " p999_ns=" << percentile(0.999)
+                  << " max_ns=" << samples.back() << "\n";
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchRunner runner(argc, argv);
+    
+    for (size_t batch : {1, 32}) {
+        std::string b = "/b" + std::to_string(batch);
+        runner.run("spsc" + b, RING_OPS, throughputCase<SpscRing<std::uint64_t>>(1, batch));
+        runner.run("mutex_deque/p1" + b, RING_OPS, throughputCase<MutexQueue>(1, batch));
+        for (size_t producers : {2, 4}) {
+            std::string p = "/p" + std::to_string(producers);
+            runner.run("mpsc" + p + b, RING_OPS, throughputCase<MpscRing<std::uint64_t>>(producers, batch));
+            runner.run("mutex_deque" + p + b, RING_OPS, throughputCase<MutexQueue>(producers, batch));
+        }
+    }
+    
+    for (WaitStrategy strategy : {WaitStrategy::BLOCK, WaitStrategy::SPIN_YIELD, WaitStrategy::BUSY_SPIN}) {
+        runLatency<SpscRing<std::chrono::steady_clock::rep>>("spsc", strategy);
+        runLatency<MpscRing<std::chrono::steady_clock::rep>>("mpsc", strategy);
+    }
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include "../include/RingQueue.h"
+
+// ============================================================================
+// RING QUEUE STRESS TEST - make ring-stress (built with -fsanitize=thread)
+// ============================================================================
+//
+// Pushes heap-owning payloads through small rings, so positions wrap many times
+// and producers keep running into a full ring, with every wait strategy and mixed
+// batch sizes. Checks that each producer's items arrive exactly once, in order and
+// intact; ThreadSanitizer reports any unsynchronized slot access.
+//
+//   ring_stress ring=mpsc wait=block producers=4 items=200000 ok
+//
+// Options: --items=<per producer> (default 50000)
+
+using namespace TradingSystem;
+
+namespace {
+
+    struct Payload {
+        std::uint32_t producer = 0;
+        std::uint64_t sequence = 0;
+        std::string text;                        // allocated, so a torn move shows up
+        std::shared_ptr<std::uint64_t> check;    // must point at `sequence`'s value
+    };
+
+    Payload makePayload(std::uint32_t producer, std::uint64_t sequence) {
+        return Payload{producer, sequence, "payload-" + std::to_string(producer) + "-" + std::to_string(sequence),
+                       std::make_shared<std::uint64_t>(sequence)};
+    }
+    
+    void fail(const std::string& message) {
+        std::cerr << "ring_stress FAILED: " << message << std::endl;
+        std::exit(1);
+    }
+    
+    // Producer p pushes items in batches of 1..7 (and singly through push()), the
+    // consumer pops in batches of up to 5 through popBatch()
+    template <typename Ring>
+    void stress(const char* name, size_t producers, std::uint64_t items, WaitStrategy strategy) {
+        Ring ring(64);
+        std::vector<std::thread> threads;
+        for (size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&ring, p, items, strategy] {
+                std::uint32_t producer = static_cast<std::uint32_t>(p);
+                std::vector<Payload> batch;
+                for (std::uint64_t sent = 0; sent < items;) {
+                    size_t count = std::min<std::uint64_t>(1 + sent % 7, items - sent);
+                    if (count == 1) {
+                        ring.push(makePayload(producer, sent), strategy);
+                        ++sent;
+                        continue;
+                    }
+                    batch.clear();
+                    for (size_t i = 0; i < count; ++i) batch.push_back(makePayload(producer, sent + i));
+                    size_t pushed = 0;
+                    while (pushed < count) {
+                        size_t n = ring.tryPushBatch(batch.data() + pushed, count - pushed);
+                        if (n == 0) ring.writable().waitUntil([&ring] { return ring.size() < ring.capacity(); },
+                                                              strategy, std::chrono::microseconds(1000));
+                        pushed += n;
+                    }
+                    sent += count;
+                }
+            });
+        }
+        
+        std::vector<std::uint64_t> expected(producers, 0);
+        Payload out[5];
+        for (std::uint64_t received = 0; received < items * producers;) {
+            size_t n = ring.popBatch(out, 5, strategy, std::chrono::microseconds(1000));
+            for (size_t i = 0; i < n; ++i) {
+                const Payload& item = out[i];
+                if (item.producer >= producers) fail("bad producer index");
+                if (item.sequence != expected[item.producer]) {
+                    fail(std::string(name) + ": producer " + std::to_string(item.producer) + " expected " +
+                         std::to_string(expected[item.producer]) + " got " + std::to_string(item.sequence));
+                }
+                if (!item.check || *item.check != item.sequence ||
+                    item.text != "payload-" + std::to_string(item.producer) + "-" + std::to_string(item.sequence)) {
+                    fail(std::string(name) + ": corrupted payload");
+                }
+                ++expected[item.producer];
+                out[i] = Payload();
+            }
+            received += n;
+        }
+        for (auto& thread : threads) thread.join();
+        
+        Payload extra;
+        if (ring.tryPop(extra) || !ring.empty()) fail(std::string(name) + ": items left over");
+        std::cout << "ring_stress ring=" << name << " wait=" << toString(strategy) << " producers=" << producers
+                  << " items=" << items * producers << " ok" << std::endl;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::uint64_t items = 50000;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--items=", 0) == 0) items = std::stoull(arg.substr(8));
+    }
+    
+    for (WaitStrategy strategy : {WaitStrategy::BLOCK, WaitStrategy::SPIN_YIELD, WaitStrategy::BUSY_SPIN}) {
+        stress<SpscRing<Payload>>("spsc", 1, items, strategy);
+        stress<MpscRing<Payload>>("mpsc", 4, items / 4, strategy);
+    }
+    return 0;
+}
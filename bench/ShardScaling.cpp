@@ -0,0 +1,182 @@
+#include "BenchHarness.h"
+#include "../include/OrderBook.h"
+#include "../include/SymbolScheduler.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+// ============================================================================
+// SYMBOL SHARD SCALING - make shards
+// ============================================================================
+//
+// Zipf-skewed flow over single-writer ShardOrderBooks, one per symbol, run by the
+// SymbolScheduler in three modes for each worker count:
+//
+//   static    - fixed symbol-to-worker partition, no stealing
+//   stealing  - idle workers steal queued symbols from busy ones
+//   pinned    - stealing, plus the hot symbols found in the warm-up window each
+//               get a dedicated worker
+//
+//   shards mode=stealing workers=4 symbols=64 zipf=1.2 commands=900000 seconds=0.412
+//          commands_per_sec=2184466 steals=1502 imbalance=1.08 pinned=0 wait=block
+//
+// imbalance is the busiest worker's share of the commands over the mean. Every
+// mode replays the same flow; the first 10% is an untimed warm-up.
+//
+// Options: --commands= --symbols= --zipf= --workers=1,2,4 --quantum= --hot-share=
+//          --wait=block|spin-yield|busy-spin
+//
+// Workers take the "shard" group of $TRADING_THREAD_LAYOUT, e.g.
+// TRADING_THREAD_LAYOUT="shard=2-9 shard.wait=busy-spin"; --wait overrides its strategy.
+
+using namespace TradingSystem;
+using namespace TradingSystem::Bench;
+
+namespace {
+
+    struct Flow {
+        std::vector<int> symbols;      // symbol index per command
+        std::vector<OrderType> sides;
+    };
+
+    // Each symbol alternates buys and sells at one price, so every second order trades
+    Flow makeFlow(size_t commands, int symbols, double zipf) {
+        std::vector<double> cdf(symbols);
+        double total = 0.0;
+        for (int k = 0; k < symbols; ++k) {
+            total += 1.0 / std::pow(k + 1, zipf);
+            cdf[k] = total;
+        }
+        for (auto& weight : cdf) weight /= total;
+        
+        Flow flow;
+        flow.symbols.reserve(commands);
+        flow.sides.reserve(commands);
+        std::mt19937_64 gen(72);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        std::vector<size_t> perSymbol(symbols, 0);
+        for (size_t i = 0; i < commands; ++i) {
+            int symbol = std::min(symbols - 1, static_cast<int>(
+                std::lower_bound(cdf.begin(), cdf.end(), uniform(gen)) - cdf.begin()));
+            flow.symbols.push_back(symbol);
+            flow.sides.push_back(perSymbol[symbol]++ % 2 ? OrderType::SELL : OrderType::BUY);
+        }
+        return flow;
+    }
+    
+    std::vector<size_t> parseList(const std::string& list) {
+        std::vector<size_t> values;
+        std::stringstream stream(list);
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            if (!item.empty()) values.push_back(std::strtoull(item.c_str(), nullptr, 10));
+        }
+        return values;
+    }
+    
+    void runMode(const char* mode, const Flow& flow, int symbols, double zipf,
+                 SymbolSchedulerConfig config) {
+        std::vector<std::unique_ptr<SequentialIdGenerator>> ids;
+        std::vector<std::unique_ptr<ShardOrderBook>> books;
+        std::vector<Symbol> names;
+        for (int s = 0; s < symbols; ++s) {
+            names.push_back("SHARD" + std::to_string(s));
+            ids.push_back(std::make_unique<SequentialIdGenerator>(names.back()));
+            books.push_back(std::make_unique<ShardOrderBook>(names.back(), RealTimeClock::instance(), *ids.back()));
+        }
+        // Orders are consumed by matching, so every mode builds its own (untimed)
+        std::vector<std::shared_ptr<Order>> orders;
+        orders.reserve(flow.symbols.size());
+        for (size_t i = 0; i < flow.symbols.size(); ++i) {
+            orders.push_back(std::make_shared<LimitOrder>(
+                "S" + std::to_string(i), "BENCH", flow.sides[i], names[flow.symbols[i]], 10, 100.0));
+        }
+        
+        SymbolScheduler scheduler(config);
+        auto submit = [&](size_t i) {
+            ShardOrderBook* book = books[flow.symbols[i]].get();
+            const std::shared_ptr<Order>* order = &orders[i];
+            scheduler.submit(names[flow.symbols[i]], [book, order] {
+                book->addOrder(*order);
+                doNotOptimize(book->matchOrders().size());
+            });
+        };
+        
+        size_t warmup = orders.size() / 10;
+        for (size_t i = 0; i < warmup; ++i) submit(i);
+        scheduler.drain();
+        scheduler.rebalance();
+        SymbolSchedulerStats before = scheduler.getStats();
+        
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = warmup; i < orders.size(); ++i) submit(i);
+        scheduler.drain();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        
+        SymbolSchedulerStats after = scheduler.getStats();
+        size_t commands = orders.size() - warmup;
+        std::uint64_t busiest = 0;
+        for (size_t w = 0; w < after.executedPerWorker.size(); ++w) {
+            busiest = std::max(busiest, after.executedPerWorker[w] - before.executedPerWorker[w]);
+        }
+        double mean = static_cast<double>(commands) / static_cast<double>(scheduler.getWorkerCount());
+        int pinned = 0;
+        for (const auto& name : names) pinned += scheduler.getDedicatedWorker(name) >= 0;
+        
+        std::cout << "shards mode=" << mode << " workers=" << scheduler.getWorkerCount()
+                  << " symbols=" << symbols << " zipf=" << zipf << " commands=" << commands
+                  << std::fixed << std::setprecision(3) << " seconds=" << seconds
+                  << std::setprecision(0) << " commands_per_sec=" << commands / seconds
+                  << " steals=" << after.steals - before.steals
+                  << std::setprecision(2) << " imbalance=" << busiest / mean
+                  << " pinned=" << pinned << " wait=" << toString(config.threads.waitStrategy)
+                  << std::defaultfloat << std::endl;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t commands = 1000000;
+    int symbols = 64;
+    double zipf = 1.2;
+    std::vector<size_t> workerCounts = {1, 2, 4};
+    size_t quantum = SymbolSchedulerConfig().quantum;
+    double hotShare = 0.1;
+    ThreadGroupConfig threads = ThreadLayout::fromEnvironment().group("shard");
+    
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&arg](const char* prefix) -> const char* {
+            size_t length = std::strlen(prefix);
+            return arg.compare(0, length, prefix) == 0 ? arg.c_str() + length : nullptr;
+        };
+        if (auto v = value("--commands=")) commands = std::strtoull(v, nullptr, 10);
+        else if (auto v = value("--symbols=")) symbols = std::max(1, std::atoi(v));
+        else if (auto v = value("--zipf=")) zipf = std::atof(v);
+        else if (auto v = value("--workers=")) workerCounts = parseList(v);
+        else if (auto v = value("--quantum=")) quantum = std::strtoull(v, nullptr, 10);
+        else if (auto v = value("--hot-share=")) hotShare = std::atof(v);
+        else if (auto v = value("--wait=")) threads.waitStrategy = parseWaitStrategy(v);
+        else {
+            std::cerr << "unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+    
+    Flow flow = makeFlow(commands, symbols, zipf);
+    for (size_t workers : workerCounts) {
+        SymbolSchedulerConfig config;
+        config.workers = std::max<size_t>(1, workers);
+        config.quantum = quantum;
+        config.hotShare = hotShare;
+        config.threads = threads;
+        
+        config.workStealing = false;
+        runMode("static", flow, symbols, zipf, config);
+        config.workStealing = true;
+        runMode("stealing", flow, symbols, zipf, config);
+        config.maxDedicated = config.workers / 2;
+        runMode("pinned", flow, symbols, zipf, config);
+    }
+    return 0;
+}
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <map>
+#include <vector>
+#include <optional>
+#include <iterator>
+#include <functional>
+#include <type_traits>
+#include <limits>
+
+namespace TradingSystem {
+
+    // ARRAY LADDER - DENSE PRICE LADDER INDEXED BY TICK
+    // DESIGN DECISION: Levels near the touch live in a fixed window of slots, so find
+    // and insert are one subtraction and best-level moves scan a few adjacent slots.
+    // Keys outside the window (far-away prices, market order sentinels) fall back to
+    // a small ordered map; the window re-centres on the next insert once it empties.
+    // Same interface subset as std::map, iterated in Compare order.
+    template <typename Key, typename Value, typename Compare = std::less<Key>,
+              size_t WindowSize = 1024>
+    class ArrayLadder {
+        static_assert(std::is_integral_v<Key>, "ArrayLadder needs integral (tick) keys");
+        static constexpr bool ASCENDING = std::is_same_v<Compare, std::less<Key>>;
+        static_assert(ASCENDING || std::is_same_v<Compare, std::greater<Key>>,
+                      "ArrayLadder supports std::less or std::greater ordering");
+        
+    public:
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = std::pair<const Key, Value>;
+        
+    private:
+        using Outer = std::map<Key, Value, Compare>;
+        static constexpr size_t NONE = WindowSize;
+        
+        // Slot i holds the i-th key of the window in Compare order
+        std::vector<std::optional<value_type>> slots_;
+        Key origin_ = 0;          // key of slot 0
+        size_t count_ = 0;        // occupied slots
+        size_t first_ = NONE;     // lowest occupied slot
+        size_t last_ = NONE;      // highest occupied slot
+        Outer outer_;
+        
+        // Slot of a key, or NONE when it lies outside the window
+        size_t slotOf(Key key) const {
+            if (ASCENDING ? key < origin_ : key > origin_) return NONE;
+            using Unsigned = std::make_unsigned_t<Key>;
+            Unsigned offset = ASCENDING ? Unsigned(key) - Unsigned(origin_)
+                                        : Unsigned(origin_) - Unsigned(key);
+            return offset < WindowSize ? static_cast<size_t>(offset) : NONE;
+        }
+        
+        Key keyOf(size_t slot) const {
+            return ASCENDING ? Key(origin_ + Key(slot)) : Key(origin_ - Key(slot));
+        }
+        
+        size_t nextSlot(size_t slot) const {
+            for (size_t i = slot + 1; i <= last_ && last_ != NONE; ++i) {
+                if (slots_[i]) return i;
+            }
+            return NONE;
+        }
+        
+        size_t prevSlot(size_t slot) const {
+            for (size_t i = slot; i-- > first_ && first_ != NONE;) {
+                if (slots_[i]) return i;
+            }
+            return NONE;
+        }
+        
+        // First outer key that sorts after the window start
+        auto split() const { return outer_.lower_bound(origin_); }
+        auto split() { return outer_.lower_bound(origin_); }
+        
+        // Centres an empty window on key and pulls in any outer keys it now covers
+        void recentre(Key key) {
+            constexpr Key HALF = Key(WindowSize / 2);
+            if (ASCENDING) {
+                origin_ = key < std::numeric_limits<Key>::min() + HALF
+                    ? std::numeric_limits<Key>::min() : Key(key - HALF);
+            } else {
+                origin_ = key > std::numeric_limits<Key>::max() - HALF
+                    ? std::numeric_limits<Key>::max() : Key(key + HALF);
+            }
+            
+            for (auto it = outer_.begin(); it != outer_.end();) {
+                size_t slot = slotOf(it->first);
+                if (slot == NONE) {
+                    ++it;
+                    continue;
+                }
+                occupy(slot, std::move(it->second));
+                it = outer_.erase(it);
+            }
+        }
+        
+        Value& occupy(size_t slot, Value&& value) {
+            slots_[slot].emplace(keyOf(slot), std::move(value));
+            ++count_;
+            if (first_ == NONE || slot < first_) first_ = slot;
+            if (last_ == NONE || slot > last_) last_ = slot;
+            return slots_[slot]->second;
+        }
+        
+    public:
+        template <bool Const>
+        class Iterator {
+            friend class ArrayLadder;
+            template <bool> friend class Iterator;
+            using Owner = std::conditional_t<Const, const ArrayLadder, ArrayLadder>;
+            using OuterIt = std::conditional_t<Const, typename Outer::const_iterator,
+                                               typename Outer::iterator>;
+            
+            Owner* owner_ = nullptr;
+            size_t slot_ = NONE;      // != NONE while inside the window
+            OuterIt outerIt_{};
+            
+            Iterator(Owner* owner, size_t slot, OuterIt outerIt)
+                : owner_(owner), slot_(slot), outerIt_(outerIt) {}
+                
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = ArrayLadder::value_type;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::conditional_t<Const, const value_type&, value_type&>;
+            using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+            
+            Iterator() = default;
+            template <bool C = Const, typename = std::enable_if_t<C>>
+            Iterator(const Iterator<false>& other)
+                : owner_(other.owner_), slot_(other.slot_), outerIt_(other.outerIt_) {}
+                
+            reference operator*() const {
+                return slot_ != NONE ? *owner_->slots_[slot_] : *outerIt_;
+            }
+            pointer operator->() const { return &**this; }
+            
+            // Walk: outer keys before the window, the window, outer keys after it
+            Iterator& operator++() {
+                if (slot_ != NONE) {
+                    slot_ = owner_->nextSlot(slot_);
+                    if (slot_ == NONE) outerIt_ = owner_->split();
+                    return *this;
+                }
+                // Only a step out of the keys before the window can land on split()
+                ++outerIt_;
+                if (outerIt_ == owner_->split() && owner_->count_ > 0) slot_ = owner_->first_;
+                return *this;
+            }
+            
+            Iterator& operator--() {
+                if (slot_ != NONE) {
+                    slot_ = owner_->prevSlot(slot_);
+                    if (slot_ == NONE) outerIt_ = std::prev(owner_->split());
+                    return *this;
+                }
+                if (outerIt_ == owner_->split() && owner_->count_ > 0) {
+                    slot_ = owner_->last_;
+                    return *this;
+                }
+                --outerIt_;
+                return *this;
+            }
+            
+            Iterator operator++(int) { Iterator old = *this; ++*this; return old; }
+            Iterator operator--(int) { Iterator old = *this; --*this; return old; }
+            
+            bool operator==(const Iterator& other) const {
+                if (slot_ != other.slot_) return false;
+                return slot_ != NONE || outerIt_ == other.outerIt_;
+            }
+            bool operator!=(const Iterator& other) const { return !(*this == other); }
+        };
+        
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        
+        ArrayLadder() : slots_(WindowSize) {}
+        ArrayLadder(const ArrayLadder&) = delete;
+        ArrayLadder& operator=(const ArrayLadder&) = delete;
+        
+        iterator begin() {
+            auto outerIt = outer_.begin();
+            if (count_ > 0 && outerIt == split()) return iterator(this, first_, outerIt);
+            return iterator(this, NONE, outerIt);
+        }
+        const_iterator begin() const {
+            auto outerIt = outer_.begin();
+            if (count_ > 0 && outerIt == split()) return const_iterator(this, first_, outerIt);
+            return const_iterator(this, NONE, outerIt);
+        }
+        iterator end() { return iterator(this, NONE, outer_.end()); }
+        const_iterator end() const { return const_iterator(this, NONE, outer_.end()); }
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+        
+        bool empty() const { return count_ == 0 && outer_.empty(); }
+        size_t size() const { return count_ + outer_.size(); }
+        
+        iterator find(Key key) {
+            size_t slot = slotOf(key);
+            if (slot != NONE) return slots_[slot] ? iterator(this, slot, {}) : end();
+            auto it = outer_.find(key);
+            return it != outer_.end() ? iterator(this, NONE, it) : end();
+        }
+        
+        Value& operator[](Key key) {
+            if (count_ == 0 && slotOf(key) == NONE) recentre(key);
+            
+            size_t slot = slotOf(key);
+            if (slot == NONE) return outer_[key];
+            if (slots_[slot]) return slots_[slot]->second;
+            return occupy(slot, Value());
+        }
+        
+        void erase(iterator it) {
+            if (it.slot_ == NONE) {
+                outer_.erase(it.outerIt_);
+                return;
+            }
+            
+            size_t slot = it.slot_;
+            slots_[slot].reset();
+            if (--count_ == 0) {
+                first_ = last_ = NONE;
+                return;
+            }
+            if (slot == first_) first_ = nextSlot(slot);
+            if (slot == last_) last_ = prevSlot(slot);
+        }
+    };
+
+} // namespace TradingSystem
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "TradingSystemCore.h"
+#include "OrderFlow.h"
+#include "ThreadPlacement.h"
+
+namespace TradingSystem {
+
+    // ONE REPLAY: AN INPUT JOURNAL PLUS THE MATCHING RULES TO REPLAY IT UNDER
+    struct BacktestScenario {
+        std::string name;
+        std::string inputPath;                                  // CSV or binary journal
+        MatchingAlgorithm matchingAlgorithm = MatchingAlgorithm::FIFO;
+        std::chrono::microseconds batchInterval{0};             // > 0 = frequent batch auctions
+        std::string tapePath;                                   // trade tape CSV, empty = none
+    };
+
+    struct BacktestStats {
+        std::string scenario;
+        std::uint64_t events = 0;
+        std::uint64_t malformed = 0;     // input lines / records skipped
+        std::uint64_t rejected = 0;      // requests the engine refused
+        std::uint64_t trades = 0;
+        std::uint64_t volume = 0;
+        double notional = 0.0;
+        double vwap = 0.0;
+        double seconds = 0.0;            // wall time of the replay
+        double eventsPerSecond = 0.0;
+        std::string error;               // set when the scenario could not run
+    };
+
+    // BACKTEST RUNNER - SCENARIOS REPLAYED IN PARALLEL, ONE ENGINE PER SCENARIO
+    // DESIGN DECISION: Each replay owns a private engine driven by a SimulatedClock
+    // that jumps to every event's timestamp, with sequential ids, so a scenario runs
+    // as fast as one core allows and its trade tape is identical on every run.
+    // Workers pull scenarios from a shared index; nothing else is shared.
+    class BacktestRunner {
+    private:
+        unsigned workers_;
+        ThreadGroupConfig threads_;
+        
+    public:
+        // 0 workers = one per hardware thread. `threads` places the replay threads the
+        // runner starts; the calling thread, which replays too, is left where it is.
+        explicit BacktestRunner(unsigned workers = 0, ThreadGroupConfig threads = ThreadGroupConfig());
+        
+        // Results come back in scenario order
+        std::vector<BacktestStats> run(const std::vector<BacktestScenario>& scenarios) const;
+        
+        static BacktestStats runScenario(const BacktestScenario& scenario);
+    };
+
+} // namespace TradingSystem
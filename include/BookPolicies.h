@@ -0,0 +1,150 @@
+#pragma once
+
+#include "TradingSystemCore.h"
+#include "MatchingPolicy.h"
+#include "ArrayLadder.h"
+#include "SkipList.h"
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace TradingSystem {
+
+    // ORDER BOOK POLICIES - EACH PRODUCT CLASS PICKS THE CHEAPEST COMBINATION AND
+    // PAYS NOTHING FOR THE REST. BasicOrderBook<BookPolicies<...>> is explicitly
+    // instantiated in OrderBook.cpp for every supported combination.
+    
+    // PRICE REPRESENTATION - HOW LEVEL KEYS ARE STORED. Orders always carry a
+    // Price; the book converts once when an order enters a ladder.
+    struct FloatingPrice {
+        using Key = Price;
+        
+        static Key toKey(Price price) { return price; }
+        static Price toPrice(Key key) { return key; }
+        static constexpr Key marketBuyKey() { return std::numeric_limits<Key>::max(); }
+        static constexpr Key marketSellKey() { return 0.0; }
+    };
+
+    // Integer ticks: exact level equality and cheap comparisons; TicksPerUnit = 100
+    // for a 0.01 tick size
+    template <std::int64_t TicksPerUnit>
+    struct FixedPointPrice {
+        using Key = std::int64_t;
+        
+        static Key toKey(Price price) { return std::llround(price * TicksPerUnit); }
+        static Price toPrice(Key key) { return static_cast<Price>(key) / TicksPerUnit; }
+        static constexpr Key marketBuyKey() { return std::numeric_limits<Key>::max(); }
+        static constexpr Key marketSellKey() { return 0; }
+    };
+
+    // LEVEL CONTAINERS - ANY ORDERED MAP-LIKE TYPE OVER (key, PriceLevel)
+    template <typename Key, typename Value, typename Compare>
+    using TreeLevels = std::map<Key, Value, Compare>;
+    
+    template <typename Key, typename Value, typename Compare>
+    using ArrayLadderLevels = ArrayLadder<Key, Value, Compare>;
+    
+    template <typename Key, typename Value, typename Compare>
+    using SkipListLevels = SkipList<Key, Value, Compare>;
+    
+    // MATCHING - A FIXED ALLOCATION POLICY (FifoAllocation, ProRataAllocation,
+    // FifoProRataAllocation) COMPILES ONE LOOP; SelectableAllocation KEEPS ALL THREE
+    // AND SWITCHES ON THE BOOK'S MatchingAlgorithm
+    struct SelectableAllocation {};
+    
+    // LOCKING
+    // No locking: the book is owned by a single writer thread (a shard)
+    struct NullMutex {
+        void lock() {}
+        bool try_lock() { return true; }
+        void unlock() {}
+        void lock_shared() {}
+        void unlock_shared() {}
+    };
+
+    // Test-and-test-and-set spin lock; readers take it exclusively too, which is
+    // cheaper than a reader count when critical sections are a few hundred ns
+    class SpinMutex {
+    private:
+        std::atomic<bool> locked_{false};
+        
+    public:
+        void lock() {
+            for (;;) {
+                if (!locked_.exchange(true, std::memory_order_acquire)) return;
+                while (locked_.load(std::memory_order_relaxed)) {
+#if defined(__x86_64__) || defined(__i386__)
+                    _mm_pause();
+#endif
+                }
+            }
+        }
+        bool try_lock() {
+            return !locked_.load(std::memory_order_relaxed) &&
+                   !locked_.exchange(true, std::memory_order_acquire);
+        }
+        void unlock() { locked_.store(false, std::memory_order_release); }
+        void lock_shared() { lock(); }
+        void unlock_shared() { unlock(); }
+    };
+
+    // Mutex guards the book, BatchMutex the frequent batch auction buffer
+    struct SharedMutexLocking {
+        using Mutex = std::shared_mutex;
+        using BatchMutex = std::mutex;
+    };
+
+    struct SpinLocking {
+        using Mutex = SpinMutex;
+        using BatchMutex = SpinMutex;
+    };
+
+    struct NoLocking {
+        using Mutex = NullMutex;
+        using BatchMutex = NullMutex;
+    };
+
+    // ORDER FEATURES - PEGS, STOPS, GTD / DAY EXPIRY AND FREQUENT BATCH AUCTIONS.
+    // A book built without a feature rejects the orders that need it, holds none of
+    // its state and runs none of its checks on the order entry and matching paths
+    template <bool Pegs, bool Stops, bool Expiry, bool BatchAuctions>
+    struct BookFeatures {
+        static constexpr bool pegs = Pegs;
+        static constexpr bool stops = Stops;
+        static constexpr bool expiry = Expiry;
+        static constexpr bool batchAuctions = BatchAuctions;
+    };
+    
+    using AllFeatures = BookFeatures<true, true, true, true>;
+    // Limit, market and iceberg orders only, good till cancelled
+    using CoreFeatures = BookFeatures<false, false, false, false>;
+    
+    // Takes the place of a compiled-out feature's state; accepts and ignores any
+    // initializer so the book's constructor is the same for every feature set
+    struct DisabledFeature {
+        template <typename... Args>
+        constexpr DisabledFeature(Args&&...) {}
+    };
+    
+    template <bool Enabled, typename State>
+    using FeatureState = std::conditional_t<Enabled, State, DisabledFeature>;
+
+    template <typename PriceRep = FloatingPrice,
+              template <typename, typename, typename> class LevelContainer = TreeLevels,
+              typename Matching = SelectableAllocation,
+              typename Locking = SharedMutexLocking,
+              typename Features = AllFeatures>
+    struct BookPolicies {
+        using PriceRepresentation = PriceRep;
+        template <typename Key, typename Value, typename Compare>
+        using Levels = LevelContainer<Key, Value, Compare>;
+        using Allocation = Matching;
+        using LockPolicy = Locking;
+        using FeatureSet = Features;
+    };
+
+    // Today's behaviour: double prices, tree ladders, per-symbol algorithm, shared_mutex,
+    // every order feature
+    using DefaultBookPolicies = BookPolicies<>;
+
+} // namespace TradingSystem
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "TradingSystemCore.h"
+
+namespace TradingSystem {
+
+    // ENGINE TIME SOURCE - EVERY STAMP THE ENGINE TAKES GOES THROUGH ONE OF THESE
+    // DESIGN DECISION: Ticks are opaque to everything but the clock that produced
+    // them; orders, trades and books keep a pointer to their clock and convert on the
+    // way out. The real-time clock's ticks are TSC cycles, the simulated clock's are
+    // nanoseconds since the epoch, so neither pays a conversion on the hot path.
+    class Clock {
+    public:
+        virtual ~Clock() = default;
+        
+        virtual CycleCount now() const = 0;
+        virtual double ticksPerSecond() const = 0;
+        virtual Timestamp toTimestamp(CycleCount ticks) const = 0;
+        
+        Timestamp currentTimestamp() const { return toTimestamp(now()); }
+    };
+
+    // Calibrated TSC (TscClock); the process-wide default
+    class RealTimeClock : public Clock {
+    public:
+        static const RealTimeClock& instance();
+        
+        CycleCount now() const override { return TscClock::now(); }
+        double ticksPerSecond() const override;
+        Timestamp toTimestamp(CycleCount ticks) const override;
+    };
+
+    // SIMULATED CLOCK - TIME ONLY MOVES WHEN THE DRIVER ADVANCES IT
+    // Replays advance it to each input event's timestamp, so a run is as fast as the
+    // CPU allows and two runs over the same input stamp identical times. Time never
+    // moves backwards; advancing to an earlier instant is ignored.
+    class SimulatedClock : public Clock {
+    private:
+        std::atomic<std::int64_t> nowNs_;
+        
+    public:
+        explicit SimulatedClock(Timestamp start = Timestamp());
+        
+        CycleCount now() const override;
+        double ticksPerSecond() const override;
+        Timestamp toTimestamp(CycleCount ticks) const override;
+        
+        void advanceTo(Timestamp timestamp);
+        void advanceBy(std::chrono::nanoseconds elapsed);
+    };
+
+} // namespace TradingSystem
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "TradingSystemCore.h"
+
+namespace TradingSystem {
+
+    // SOURCE OF ORDER AND TRADE IDS
+    class IdGenerator {
+    public:
+        virtual ~IdGenerator() = default;
+        virtual std::string next() = 0;
+    };
+
+    // Random v4 UUIDs (generateUUID); the process-wide default
+    class UuidGenerator : public IdGenerator {
+    public:
+        static UuidGenerator& instance();
+        std::string next() override;
+    };
+
+    // Deterministic ids "<prefix>-<n>" from 1 up, for replays and regression tests
+    // where two runs over the same input must produce the same output
+    class SequentialIdGenerator : public IdGenerator {
+    private:
+        std::string prefix_;
+        std::atomic<std::uint64_t> next_{1};
+        
+    public:
+        explicit SequentialIdGenerator(const std::string& prefix = "ID");
+        std::string next() override;
+    };
+
+} // namespace TradingSystem
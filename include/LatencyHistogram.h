@@ -0,0 +1,121 @@
+#pragma once
+
+#include "TradingSystemCore.h"
+#include <array>
+
+// Build with -DTRADING_LATENCY_METRICS=0 to compile every LatencyTimer away
+#ifndef TRADING_LATENCY_METRICS
+#define TRADING_LATENCY_METRICS 1
+#endif
+
+namespace TradingSystem {
+
+    enum class LatencyMetric { PLACE_ORDER, CANCEL_ORDER, MODIFY_ORDER, MATCH_ORDERS, OBSERVER_DISPATCH,
+                               PLACE_ORDER_BATCH };
+    constexpr size_t LATENCY_METRIC_COUNT = 6;
+    
+    const char* toString(LatencyMetric metric);
+    
+    // LOG-LINEAR (HDR-STYLE) HISTOGRAM OF CYCLE COUNTS
+    // DESIGN DECISION: 32 linear sub-buckets per power of two give ~3% relative
+    // precision over the full 64-bit range in a fixed 15 KB array, so recording is an
+    // index computation plus one increment and histograms merge by adding arrays.
+    // Each histogram has a single writer thread; counts are relaxed atomics only so
+    // a concurrent merge reads them without a data race.
+    class LatencyHistogram {
+    public:
+        static constexpr int SUB_BUCKET_BITS = 5;
+        static constexpr size_t SUB_BUCKETS = size_t(1) << SUB_BUCKET_BITS;
+        static constexpr size_t BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+        
+        static size_t bucketOf(CycleCount value) {
+            if (value < 2 * SUB_BUCKETS) return static_cast<size_t>(value);
+            int exponent = 63 - __builtin_clzll(value) - SUB_BUCKET_BITS;
+            return static_cast<size_t>(exponent) * SUB_BUCKETS + static_cast<size_t>(value >> exponent);
+        }
+        
+        // Highest value that falls into a bucket
+        static CycleCount bucketUpperBound(size_t bucket);
+        
+        // Single-writer increment: a plain load/add/store, no locked instruction
+        void record(CycleCount value) {
+            bump(counts_[bucketOf(value)], 1);
+            bump(total_, 1);
+            if (value > max_.load(std::memory_order_relaxed)) {
+                max_.store(value, std::memory_order_relaxed);
+            }
+        }
+        
+        void mergeInto(LatencyHistogram& target) const;
+        void clear();
+        
+        std::uint64_t getCount() const;
+        CycleCount getMax() const;
+        // Smallest recorded bucket bound covering `quantile` (0..1) of the samples
+        CycleCount valueAtQuantile(double quantile) const;
+        
+    private:
+        std::array<std::atomic<std::uint64_t>, BUCKETS> counts_{};
+        std::atomic<std::uint64_t> total_{0};
+        std::atomic<CycleCount> max_{0};
+        
+        static void bump(std::atomic<std::uint64_t>& counter, std::uint64_t delta) {
+            counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+        }
+    };
+
+    // MERGED VIEW OF ONE METRIC ACROSS ALL THREADS, IN NANOSECONDS
+    struct LatencySnapshot {
+        std::uint64_t count = 0;
+        double p50Ns = 0.0;
+        double p99Ns = 0.0;
+        double p999Ns = 0.0;
+        double maxNs = 0.0;
+    };
+
+    // LATENCY METRICS REGISTRY - PER-THREAD HISTOGRAMS, MERGED ON DEMAND
+    // Each recording thread lazily registers its own set of histograms, so the hot
+    // path never shares a cache line with another thread. Exiting threads fold their
+    // counts into a retired set. All functions except record() take the registry lock.
+    class LatencyMetrics {
+    public:
+        static void record(LatencyMetric metric, CycleCount cycles);
+        
+        static LatencySnapshot snapshot(LatencyMetric metric);
+        static void reset();
+        
+        // One line per metric with samples:
+        // latency metric=place_order count= p50_ns= p99_ns= p999_ns= max_ns=
+        static void dump(std::ostream& out);
+        
+        // Background thread that dumps every `interval` until stopped
+        static void startPeriodicDump(std::chrono::milliseconds interval, std::ostream& out);
+        static void stopPeriodicDump();
+    };
+
+    // SCOPED TIMER - RECORDS THE CYCLES SPENT IN ITS SCOPE (AN EMPTY OBJECT WHEN
+    // TRADING_LATENCY_METRICS IS 0)
+    template <bool Enabled>
+    class BasicLatencyTimer {
+    private:
+        LatencyMetric metric_;
+        CycleCount start_;
+        
+    public:
+        explicit BasicLatencyTimer(LatencyMetric metric)
+            : metric_(metric), start_(readCycleCounter()) {}
+        ~BasicLatencyTimer() { LatencyMetrics::record(metric_, readCycleCounter() - start_); }
+        
+        BasicLatencyTimer(const BasicLatencyTimer&) = delete;
+        BasicLatencyTimer& operator=(const BasicLatencyTimer&) = delete;
+    };
+
+    template <>
+    class BasicLatencyTimer<false> {
+    public:
+        explicit BasicLatencyTimer(LatencyMetric) {}
+    };
+
+    using LatencyTimer = BasicLatencyTimer<TRADING_LATENCY_METRICS != 0>;
+
+} // namespace TradingSystem
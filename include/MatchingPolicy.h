@@ -0,0 +1,93 @@
+#pragma once
+
+#include "TradingSystemCore.h"
+#include "Order.h"
+#include <list>
+
+namespace TradingSystem {
+
+    // PRICE LEVEL - FIFO QUEUE OF RESTING ORDERS AT ONE PRICE
+    // DESIGN DECISION: The level keeps a running total of displayed quantity so depth
+    // queries never walk the queue, and orders are list nodes so re-queueing an
+    // order (iceberg refresh) is a splice rather than a tree reinsert
+    using OrderQueue = std::list<std::shared_ptr<Order>>;
+    
+    struct PriceLevel {
+        OrderQueue orders;
+        Quantity displayedQuantity = 0;
+    };
+
+    // One resting order's share of an incoming order
+    struct LevelAllocation {
+        OrderQueue::iterator position;
+        Quantity quantity;
+    };
+    using AllocationList = std::vector<LevelAllocation>;
+    
+    // ALLOCATION POLICIES - HOW AN INCOMING ORDER IS SHARED OUT AMONG THE RESTING
+    // ORDERS OF THE LEVEL IT HITS. Each policy is a compile-time parameter of the
+    // book's matching loop, so every algorithm gets its own inlined loop.
+    // allocate() appends (order, quantity) pairs in queue order; levelQuantity is
+    // the level's displayed total and incoming never exceeds it.
+    
+    // PRICE-TIME (FIFO) - THE FRONT ORDER TAKES EVERYTHING IT CAN; THE MATCHING LOOP
+    // COMES BACK FOR THE NEXT ORDER
+    struct FifoAllocation {
+        static void allocate(OrderQueue& queue, Quantity /*levelQuantity*/, Quantity incoming,
+                             AllocationList& out) {
+            auto front = queue.begin();
+            out.push_back({front, std::min(incoming, (*front)->getDisplayedQuantity())});
+        }
+    };
+
+    // PRO-RATA - EACH ORDER GETS floor(incoming * size / levelQuantity) IN ONE PASS
+    // OVER THE LEVEL; THE REMAINING LOTS (FEWER THAN THE ORDER COUNT) GO ONE EACH
+    // IN TIME PRIORITY, SO THE RESULT IS DETERMINISTIC
+    struct ProRataAllocation {
+        static void allocate(OrderQueue& queue, Quantity levelQuantity, Quantity incoming,
+                             AllocationList& out) {
+            allocateRange(queue.begin(), queue.end(), levelQuantity, incoming, out);
+        }
+        
+        static void allocateRange(OrderQueue::iterator first, OrderQueue::iterator last,
+                                  Quantity levelQuantity, Quantity incoming,
+                                  AllocationList& out) {
+            if (incoming <= 0 || first == last) return;
+            
+            size_t begin = out.size();
+            Quantity assigned = 0;
+            for (auto it = first; it != last; ++it) {
+                Quantity size = (*it)->getDisplayedQuantity();
+                Quantity share = incoming >= levelQuantity ? size : static_cast<Quantity>(
+                    static_cast<std::int64_t>(incoming) * size / levelQuantity);
+                out.push_back({it, share});
+                assigned += share;
+            }
+            
+            // Every share is strictly below its order's size here, so one sweep
+            // always places the whole remainder
+            Quantity remainder = incoming - assigned;
+            for (size_t i = begin; i < out.size() && remainder > 0; ++i) {
+                if (out[i].quantity < (*out[i].position)->getDisplayedQuantity()) {
+                    ++out[i].quantity;
+                    --remainder;
+                }
+            }
+        }
+    };
+
+    // FIFO + PRO-RATA (TOP ORDER) - THE OLDEST ORDER AT THE LEVEL IS FILLED FIRST,
+    // THE REST OF THE INCOMING QUANTITY IS SHARED PRO-RATA AMONG THE OTHERS
+    struct FifoProRataAllocation {
+        static void allocate(OrderQueue& queue, Quantity levelQuantity, Quantity incoming,
+                             AllocationList& out) {
+            auto top = queue.begin();
+            Quantity topSize = (*top)->getDisplayedQuantity();
+            Quantity topFill = std::min(incoming, topSize);
+            out.push_back({top, topFill});
+            ProRataAllocation::allocateRange(std::next(top), queue.end(),
+                                             levelQuantity - topSize, incoming - topFill, out);
+        }
+    };
+
+} // namespace TradingSystem
@@ -2,6 +2,7 @@
 
 #include "TradingSystemCore.h"
 #include "User.h"
+#include "Clock.h"
 #include <memory>
 
 namespace TradingSystem {
@@ -15,10 +16,12 @@ namespace TradingSystem {
         Symbol symbol_;
         Quantity quantity_;
         Price price_;
-        Timestamp timestamp_;
+        CycleCount entryTicks_;  // time priority, raw ticks of clock_; 0 until entry
+        const Clock* clock_;     // must outlive the order
         OrderStatus status_;
         OrderTimeInForce timeInForce_;
         Quantity filledQuantity_;
+        Timestamp expireTime_;   // only meaningful for GTD orders
         
     public:
         Order(const OrderId& orderId, const UserId& userId, OrderType orderType,
@@ -34,16 +37,33 @@ namespace TradingSystem {
         const Symbol& getSymbol() const;
         Quantity getQuantity() const;
         Price getPrice() const;
-        const Timestamp& getTimestamp() const;
+        Timestamp getTimestamp() const;        // converted on demand
+        CycleCount getEntryTicks() const;
+        const Clock& getClock() const;
         OrderStatus getStatus() const;
         OrderTimeInForce getTimeInForce() const;
+        const Timestamp& getExpireTime() const;
         Quantity getFilledQuantity() const;
         Quantity getRemainingQuantity() const;
         
+        // Quantity visible to the market; less than remaining for reserve orders
+        virtual Quantity getDisplayedQuantity() const;
+        
+        // RESERVE HOOK - true once a reserve order's displayed quantity is used up with
+        // quantity still hidden; replenish() shows the next part and returns it
+        virtual bool needsReplenish() const;
+        virtual Quantity replenish();
+        
         // SETTER METHODS WITH VALIDATION
         virtual bool setQuantity(Quantity newQuantity);
         virtual bool setPrice(Price newPrice);
         virtual bool setStatus(OrderStatus newStatus);
+        bool setTimeInForce(OrderTimeInForce timeInForce, Timestamp expireTime = Timestamp());
+        
+        // Stamps time priority from `clock`, which then also converts the order's
+        // timestamps; the engine calls this on creation and the book again on insert,
+        // each with its own clock
+        void stampEntry(const Clock& clock);
         
         // ORDER OPERATIONS
         virtual bool canModify() const;
@@ -53,6 +73,11 @@ namespace TradingSystem {
         // VALIDATION METHOD
         virtual bool isValid() const;
         
+        // ORDER KIND QUERIES - USED BY THE BOOK TO ROUTE AND PRIORITISE ORDERS
+        virtual bool isMarketOrder() const;
+        virtual bool isStopOrder() const;
+        virtual bool isPeggedOrder() const;
+        
         // PROTOTYPE PATTERN - VIRTUAL CLONE METHOD
         virtual std::unique_ptr<Order> clone() const = 0;
     };
@@ -66,6 +91,31 @@ namespace TradingSystem {
         std::unique_ptr<Order> clone() const override;
     };
 
+    // ICEBERG ORDER - LIMIT ORDER THAT SHOWS ONLY A TIP OF ITS TOTAL QUANTITY.
+    // When the tip is fully filled it is refreshed from the hidden reserve in place;
+    // the book re-queues the same object at the back of its level
+    class IcebergOrder : public LimitOrder {
+    private:
+        Quantity peakQuantity_;   // configured tip size
+        Quantity tipRemaining_;   // unfilled part of the current tip
+        
+    public:
+        IcebergOrder(const OrderId& orderId, const UserId& userId, OrderType orderType,
+                     const Symbol& symbol, Quantity quantity, Price price, Quantity peakQuantity);
+        
+        std::unique_ptr<Order> clone() const override;
+        
+        Quantity getPeakQuantity() const;
+        Quantity getDisplayedQuantity() const override;
+        
+        bool needsReplenish() const override;
+        Quantity replenish() override;
+        
+        bool setQuantity(Quantity newQuantity) override;
+        void fill(Quantity fillQuantity) override;
+        bool isValid() const override;
+    };
+
     // MARKET ORDER - CONCRETE IMPLEMENTATION WITH DIFFERENT VALIDATION
     class MarketOrder : public Order {
     public:
@@ -79,6 +129,78 @@ namespace TradingSystem {
         
         // Market orders cannot set price (they execute at market price)
         bool setPrice(Price newPrice) override;
+        
+        bool isMarketOrder() const override;
+    };
+
+    // STOP ORDER - HELD OUTSIDE THE ACTIVE BOOK UNTIL THE LAST TRADE PRICE CROSSES
+    // ITS STOP PRICE, THEN ENTERS THE BOOK AS A MARKET ORDER
+    class StopOrder : public Order {
+    protected:
+        Price stopPrice_;
+        bool triggered_;
+        
+        StopOrder(const OrderId& orderId, const UserId& userId, OrderType orderType,
+                  const Symbol& symbol, Quantity quantity, Price stopPrice, Price limitPrice);
+        
+    public:
+        StopOrder(const OrderId& orderId, const UserId& userId, OrderType orderType,
+                  const Symbol& symbol, Quantity quantity, Price stopPrice);
+        
+        std::unique_ptr<Order> clone() const override;
+        
+        Price getStopPrice() const;
+        bool isTriggered() const;
+        
+        // True when a trade at lastTradePrice activates this stop
+        bool isTriggeredBy(Price lastTradePrice) const;
+        
+        // Activation takes a fresh timestamp: time priority starts at the trigger
+        void trigger();
+        
+        bool isValid() const override;
+        bool setPrice(Price newPrice) override;
+        bool canModify() const override;
+        bool isMarketOrder() const override;
+        bool isStopOrder() const override;
+    };
+
+    // STOP-LIMIT ORDER - SAME TRIGGER AS A STOP ORDER, BUT ENTERS THE BOOK AS A LIMIT ORDER
+    class StopLimitOrder : public StopOrder {
+    public:
+        StopLimitOrder(const OrderId& orderId, const UserId& userId, OrderType orderType,
+                       const Symbol& symbol, Quantity quantity, Price stopPrice, Price limitPrice);
+        
+        std::unique_ptr<Order> clone() const override;
+        
+        bool isValid() const override;
+        bool setPrice(Price newPrice) override;
+        bool isMarketOrder() const override;
+    };
+
+    // PEGGED ORDER - PRICE TRACKS A BBO REFERENCE PLUS A FIXED OFFSET.
+    // The book ranks pegs by offset and derives the effective price from the current
+    // reference; price_ is only materialized when the order is executed
+    class PeggedOrder : public Order {
+    private:
+        PegType pegType_;
+        Price offset_;
+        
+    public:
+        PeggedOrder(const OrderId& orderId, const UserId& userId, OrderType orderType,
+                    const Symbol& symbol, Quantity quantity, PegType pegType, Price offset);
+                    
+        std::unique_ptr<Order> clone() const override;
+        
+        PegType getPegType() const;
+        Price getOffset() const;
+        
+        // Materializes the effective price computed by the book
+        void reprice(Price effectivePrice);
+        
+        bool isValid() const override;
+        bool setPrice(Price newPrice) override;   // only 0: keep the peg
+        bool isPeggedOrder() const override;
     };
 
     // ORDER COMPARATORS - STRATEGY PATTERN FOR DIFFERENT SORTING STRATEGIES
@@ -3,31 +3,253 @@
 #include "TradingSystemCore.h"
 #include "Order.h"
 #include "Trade.h"
+#include "Clock.h"
+#include "IdGenerator.h"
+#include "TimerWheel.h"
+#include "MatchingPolicy.h"
+#include "BookPolicies.h"
 #include <set>
 #include <map>
 #include <shared_mutex>
+#include <unordered_map>
 
 namespace TradingSystem {
 
-    class OrderBook {
+    // L2 DEPTH ENTRY - AGGREGATED DISPLAYED QUANTITY AT ONE PRICE
+    struct DepthLevel {
+        Price price;
+        Quantity quantity;
+        size_t orderCount;
+    };
+
+    // INDICATIVE AUCTION RESULT - PRICE THAT MAXIMISES EXECUTABLE VOLUME
+    struct AuctionIndicative {
+        Price price = 0.0;
+        Quantity volume = 0;
+        Quantity imbalance = 0;   // bid surplus (> 0) or ask surplus (< 0) at price
+    };
+
+    // FREQUENT BATCH AUCTION COUNTERS - QUEUE LATENCY IS ENQUEUE TO BATCH CUT
+    struct BatchAuctionStats {
+        std::uint64_t batches = 0;
+        std::uint64_t ordersBatched = 0;
+        double totalQueueLatencyNs = 0.0;
+        double maxQueueLatencyNs = 0.0;
+    };
+
+    // POLICY-BASED ORDER BOOK - SEE BookPolicies.h. OrderBook (the default policies)
+    // is the engine's book; the other aliases below are the supported combinations
+    template <typename Policies = DefaultBookPolicies>
+    class BasicOrderBook {
     private:
+        using PriceRep = typename Policies::PriceRepresentation;
+        using Key = typename PriceRep::Key;
+        using Allocation = typename Policies::Allocation;
+        using Mutex = typename Policies::LockPolicy::Mutex;
+        using BatchMutex = typename Policies::LockPolicy::BatchMutex;
+        using Features = typename Policies::FeatureSet;
+        
         Symbol symbol_;
         
-        std::multiset<std::shared_ptr<Order>, BuyOrderComparator> buyOrders_;
-        std::multiset<std::shared_ptr<Order>, SellOrderComparator> sellOrders_;
+        // Time and trade-id sources; both must outlive the book
+        const Clock& clock_;
+        IdGenerator& idGenerator_;
+        
+        // Market orders are keyed beyond every valid limit price so they sit at the
+        // top of their ladder (see levelKey)
+        using BidLevels = typename Policies::template Levels<Key, PriceLevel, std::greater<Key>>;
+        using AskLevels = typename Policies::template Levels<Key, PriceLevel, std::less<Key>>;
+        BidLevels bidLevels_;
+        AskLevels askLevels_;
+        
+        // PEGGED LADDERS - KEYED BY OFFSET, ONE PER SIDE AND PEG TYPE.
+        // A reference move shifts every peg of a ladder by the same amount, so their
+        // relative order never changes and nothing is re-sorted on a BBO tick
+        [[no_unique_address]] FeatureState<Features::pegs, BidLevels> bidPrimaryPegs_;
+        [[no_unique_address]] FeatureState<Features::pegs, BidLevels> bidMidpointPegs_;
+        [[no_unique_address]] FeatureState<Features::pegs, AskLevels> askPrimaryPegs_;
+        [[no_unique_address]] FeatureState<Features::pegs, AskLevels> askMidpointPegs_;
+        
+        // Peg references, recomputed only when the regular best bid/ask moves
+        struct PegReferences {
+            Price bestBid = 0.0;
+            Price bestAsk = 0.0;
+            Price midpoint = 0.0;
+        };
+        [[no_unique_address]] FeatureState<Features::pegs, PegReferences> pegRefs_;
+        
+        // Best level of one ladder in the merged (regular + pegged) view
+        template <typename Levels>
+        struct LadderTop {
+            Levels* levels = nullptr;
+            typename Levels::iterator level;
+            Price price = 0.0;
+            Key key{};   // price as a level key; market levels keep their sentinel
+        };
+        
+        // One ladder level on an auction supply or demand curve
+        struct CurvePoint {
+            Key key;
+            Quantity quantity;
+        };
+        
+        // STOP TRIGGER INDEXES - UNTRIGGERED STOPS NEVER ENTER THE ACTIVE LADDERS.
+        // Buy stops fire as the price rises (ascending), sell stops as it falls
+        // (descending), so the crossed stops are always a prefix of each index.
+        using BuyStops = std::multimap<Price, std::shared_ptr<Order>>;
+        using SellStops = std::multimap<Price, std::shared_ptr<Order>, std::greater<Price>>;
+        [[no_unique_address]] FeatureState<Features::stops, BuyStops> buyStops_;
+        [[no_unique_address]] FeatureState<Features::stops, SellStops> sellStops_;
+        Price lastTradePrice_;
+        
+        // Lookup entry remembers the order's queue node while it rests in a level
+        struct OrderEntry {
+            std::shared_ptr<Order> order;
+            OrderQueue::iterator position;
+            bool resting = false;
+        };
+        
+        mutable Mutex mutex_;
+        std::map<OrderId, OrderEntry> orderLookup_;
+        
+        // EXPIRY - GTD ORDERS ON THE BOOK'S OWN TIMING WHEEL, DAY ORDERS IN A SESSION
+        // BUCKET THAT IS SWAPPED OUT AND EXPIRED AS ONE BATCH AT SESSION END
+        [[no_unique_address]] FeatureState<Features::expiry, TimerWheel> expiryWheel_;
+        [[no_unique_address]] FeatureState<Features::expiry, std::vector<std::shared_ptr<Order>>> dayOrders_;
         
-        mutable std::shared_mutex mutex_;
-        std::map<OrderId, std::shared_ptr<Order>> orderLookup_;
+        // CALL AUCTION STATE - THE INDICATIVE IS CACHED AND ONLY INVALIDATED BY ORDERS
+        // THAT CAN CHANGE THE CROSSED PART OF THE CURVES
+        TradingPhase phase_;
+        AuctionIndicative indicative_;
+        bool indicativeDirty_;
+        
+        // FREQUENT BATCH AUCTION - INCOMING ORDERS ARE BUFFERED UNDER A SMALL MUTEX OF
+        // THEIR OWN, SO SUBMITTERS NEVER QUEUE ON THE BOOK LOCK; THE BATCH IS MATCHED
+        // IN ONE UNCROSS EVERY INTERVAL
+        struct PendingOrder {
+            std::shared_ptr<Order> order;
+            CycleCount enqueuedAt;
+            std::uint64_t sequence;
+        };
+        template <typename State>
+        using BatchState = FeatureState<Features::batchAuctions, State>;
+        [[no_unique_address]] BatchState<std::atomic<CycleCount>> batchInterval_;   // 0 = continuous matching
+        [[no_unique_address]] mutable BatchState<BatchMutex> batchMutex_;
+        [[no_unique_address]] BatchState<BatchMutex> batchRunMutex_;
+        [[no_unique_address]] BatchState<std::vector<PendingOrder>> pendingBatch_;
+        [[no_unique_address]] BatchState<std::unordered_map<OrderId, std::shared_ptr<Order>>> batchLookup_;
+        [[no_unique_address]] BatchState<CycleCount> lastBatchCycles_;
+        [[no_unique_address]] BatchState<std::uint64_t> batchSequence_;
+        [[no_unique_address]] BatchState<BatchAuctionStats> batchStats_;
+        
+        // Level allocation rule; with SelectableAllocation it picks which
+        // instantiation of the matching loop runs, otherwise it is fixed
+        MatchingAlgorithm matchingAlgorithm_;
+        AllocationList allocations_;   // scratch buffer reused by every match step
+        
+        static bool isSupported(const Order& order);
+        static Key levelKey(const Order& order);
+        static bool isParkedStop(const Order& order);
+        BidLevels& bidLadderFor(const Order& order);
+        AskLevels& askLadderFor(const Order& order);
+        
+        void refreshPegReferences();
+        Price pegReference(const Order& order) const;
+        LadderTop<BidLevels> bestBidTop(bool limitsOnly = false);
+        LadderTop<AskLevels> bestAskTop(bool limitsOnly = false);
+        template <typename Levels>
+        void collectPegDepth(const Levels& pegs, Price reference,
+                             std::vector<DepthLevel>& depth) const;
+        
+        void insertResting(OrderEntry& entry);
+        void removeResting(OrderEntry& entry);
+        template <typename Levels>
+        void settleFill(Levels& levels, typename Levels::iterator levelIt,
+                        OrderQueue::iterator position, Quantity fillQuantity);
+        template <typename Levels>
+        static std::vector<DepthLevel> collectDepth(const Levels& levels, size_t maxLevels);
+        template <typename Levels>
+        static Price bestLimitPrice(const Levels& levels);
+        
+        template <typename LevelAllocator>
+        void matchActiveOrders(std::vector<std::shared_ptr<Trade>>& trades);
+        void matchContinuous(std::vector<std::shared_ptr<Trade>>& trades);
+        size_t releaseTriggeredStops();
+        bool removeStopOrder(const std::shared_ptr<Order>& order);
+        bool expireOrder(const OrderId& orderId);
+        bool insertOrder(const std::shared_ptr<Order>& order);
+        
+        bool bufferOrder(std::shared_ptr<Order> order);
+        bool cancelBufferedOrder(const OrderId& orderId);
+        bool uncrossBatch(bool force, std::vector<std::shared_ptr<Trade>>& trades);
+        
+        void noteAuctionChange(const Order& order);
+        AuctionIndicative computeEquilibrium() const;
+        template <typename LevelAllocator>
+        void allocateUncross(const AuctionIndicative& result,
+                             std::vector<std::shared_ptr<Trade>>& trades);
+        void executeUncross(const AuctionIndicative& result,
+                            std::vector<std::shared_ptr<Trade>>& trades);
         
     public:
-        explicit OrderBook(const Symbol& symbol);
+        // Order features this book was built with (see BookFeatures)
+        using FeatureSet = Features;
         
+        explicit BasicOrderBook(const Symbol& symbol,
+                                const Clock& clock = RealTimeClock::instance(),
+                                IdGenerator& idGenerator = UuidGenerator::instance());
+        BasicOrderBook(const BasicOrderBook&) = delete;
+        BasicOrderBook& operator=(const BasicOrderBook&) = delete;
+        
+        // Rejects orders that need a feature this book was built without
         bool addOrder(std::shared_ptr<Order> order);
+        // Adds and matches a run of orders in sequence under one lock acquisition, with
+        // the same outcome as calling addOrder + matchOrders for each. Rejected entries
+        // are reset to null; the trades of orders[i] end at trades[tradeEnds[i]].
+        // In batch mode the run is only buffered and a due uncross runs once after it;
+        // its trades belong to the whole batch, not to one order, so they are all
+        // reported after the last order and every earlier order ends with none.
+        size_t addOrders(std::shared_ptr<Order>* orders, size_t count,
+                         std::vector<std::shared_ptr<Trade>>& trades, size_t* tradeEnds);
         bool cancelOrder(const OrderId& orderId);
+        // A pegged order keeps its peg when newPrice is 0 or the price it shows;
+        // any other price is refused
         bool modifyOrder(const OrderId& orderId, Quantity newQuantity, Price newPrice);
         std::shared_ptr<Order> getOrder(const OrderId& orderId) const;
         std::vector<std::shared_ptr<Order>> getBuyOrders() const;
         std::vector<std::shared_ptr<Order>> getSellOrders() const;
+        size_t getPendingStopCount() const;
+        
+        // Expire every GTD order due at `now`, returns the orders that expired
+        std::vector<std::shared_ptr<Order>> expireOrders(const Timestamp& now);
+        // Expire all DAY orders entered during the session
+        std::vector<std::shared_ptr<Order>> endSession();
+        size_t getScheduledExpiryCount() const;
+        
+        // CALL AUCTION - ORDERS REST WITHOUT MATCHING UNTIL THE UNCROSS, WHICH FILLS
+        // EVERYTHING EXECUTABLE AT ONE EQUILIBRIUM PRICE AND RESUMES CONTINUOUS TRADING
+        void beginCallAuction();
+        std::vector<std::shared_ptr<Trade>> uncrossAuction();
+        AuctionIndicative getIndicativeAuction();
+        TradingPhase getTradingPhase() const;
+        
+        // FREQUENT BATCH AUCTION MODE - A ZERO INTERVAL RESTORES CONTINUOUS MATCHING.
+        // Books built without batch auctions stay continuous and return false
+        bool setBatchInterval(std::chrono::microseconds interval);
+        bool isBatchMode() const;
+        // Uncrosses the buffered batch if the interval has elapsed (or when forced,
+        // e.g. to flush the buffer after switching back to continuous matching)
+        std::vector<std::shared_ptr<Trade>> runBatchAuction(bool force = false);
+        BatchAuctionStats getBatchAuctionStats() const;
+        
+        // LEVEL ALLOCATION - FIFO, PRO-RATA, OR FIFO TOP ORDER + PRO-RATA. Only books
+        // built with SelectableAllocation can switch; the others return false
+        bool setMatchingAlgorithm(MatchingAlgorithm algorithm);
+        MatchingAlgorithm getMatchingAlgorithm() const;
+        
+        // MARKET DATA - DEPTH REFLECTS DISPLAYED QUANTITY ONLY, BEST LEVEL FIRST
+        std::vector<DepthLevel> getBidDepth(size_t maxLevels) const;
+        std::vector<DepthLevel> getAskDepth(size_t maxLevels) const;
         
         // CORE MATCHING ENGINE - PRICE-TIME PRIORITY MATCHING ALGORITHM
         std::vector<std::shared_ptr<Trade>> matchOrders();
@@ -35,9 +257,32 @@ namespace TradingSystem {
         Price getBestBid() const;
         Price getBestAsk() const;
         Price getSpread() const;
+        Price getLastTradePrice() const;
         
         bool isValid() const;
         const Symbol& getSymbol() const;
     };
 
+    // SUPPORTED COMBINATIONS
+    // Engine default: double prices, tree ladders, per-symbol algorithm, shared_mutex
+    using OrderBook = BasicOrderBook<DefaultBookPolicies>;
+    // Single-writer shard: 0.01 ticks on a dense ladder, FIFO only, no locking, and
+    // none of the optional order features
+    using ShardOrderBook = BasicOrderBook<
+        BookPolicies<FixedPointPrice<100>, ArrayLadderLevels, FifoAllocation, NoLocking, CoreFeatures>>;
+    // Tick prices on a skip list behind a spin lock
+    using SkipListOrderBook = BasicOrderBook<
+        BookPolicies<FixedPointPrice<100>, SkipListLevels, SelectableAllocation, SpinLocking>>;
+    // Futures-style product matched pro-rata only
+    using ProRataOrderBook = BasicOrderBook<
+        BookPolicies<FloatingPrice, TreeLevels, ProRataAllocation>>;
+        
+    extern template class BasicOrderBook<DefaultBookPolicies>;
+    extern template class BasicOrderBook<
+        BookPolicies<FixedPointPrice<100>, ArrayLadderLevels, FifoAllocation, NoLocking, CoreFeatures>>;
+    extern template class BasicOrderBook<
+        BookPolicies<FixedPointPrice<100>, SkipListLevels, SelectableAllocation, SpinLocking>>;
+    extern template class BasicOrderBook<
+        BookPolicies<FloatingPrice, TreeLevels, ProRataAllocation>>;
+
 } // namespace TradingSystem
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "TradingSystemCore.h"
+#include "TradingEngine.h"
+#include "Clock.h"
+#include <functional>
+#include <string_view>
+#include <unordered_set>
+
+namespace TradingSystem {
+
+    // RECORDED ORDER FLOW - ONE EVENT PER NEW / CANCEL / MODIFY REQUEST
+    // `reference` is the journal's own order number; cancels and modifies name the
+    // order they act on by it, and the replayer maps it to the engine's order id.
+    enum class FlowAction : std::uint8_t { NEW, CANCEL, MODIFY };
+    
+    struct FlowEvent {
+        std::int64_t timestampNs = 0;          // nanoseconds since the epoch
+        FlowAction action = FlowAction::NEW;
+        OrderType side = OrderType::BUY;
+        std::string_view user;                 // views into the mapped input
+        std::string_view symbol;
+        Quantity quantity = 0;
+        Price price = 0.0;                     // 0 = market order
+        std::uint64_t reference = 0;
+    };
+
+    // READ-ONLY MEMORY MAPPING OF A WHOLE FILE
+    // DESIGN DECISION: Replays read through mmap so the page cache is the only copy of
+    // the input and events are parsed in place; throws std::runtime_error on failure
+    class MappedFile {
+    private:
+        const char* data_;
+        size_t size_;
+        
+    public:
+        explicit MappedFile(const std::string& path);
+        ~MappedFile();
+        
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        
+        const char* data() const { return data_; }
+        size_t size() const { return size_; }
+    };
+
+    // Fixed 64-byte record of the binary journal format, after an 8-byte magic
+    struct BinaryFlowRecord {
+        std::int64_t timestampNs;
+        std::uint64_t reference;
+        double price;
+        std::int32_t quantity;
+        std::uint8_t action;
+        std::uint8_t side;
+        std::uint8_t userLength;
+        std::uint8_t symbolLength;
+        char user[16];
+        char symbol[16];
+    };
+    static_assert(sizeof(BinaryFlowRecord) == 64, "binary flow records are 64 bytes");
+    
+    constexpr std::string_view BINARY_FLOW_MAGIC = "TSFLOW01";
+    
+    // SEQUENTIAL READER OVER A MAPPED JOURNAL
+    // The format is picked from the first bytes: binary when they hold the magic,
+    // otherwise CSV with one event per line:
+    //
+    //   timestamp_ns,action,user,symbol,side,quantity,price,reference
+    //   1700000000000000000,N,U1,INFY,B,100,1800.50,1
+    //   1700000000000500000,M,U1,INFY,,150,1801.00,1
+    //   1700000000001000000,C,U1,INFY,,,,1
+    //
+    // Action is N/C/M and side B/S; a header line and blank lines are skipped.
+    // Malformed lines are counted and skipped rather than aborting the replay.
+    class OrderFlowReader {
+    private:
+        const char* cursor_;
+        const char* end_;
+        bool binary_;
+        size_t malformed_;
+        
+        bool nextCsv(FlowEvent& event);
+        bool nextBinary(FlowEvent& event);
+        
+    public:
+        explicit OrderFlowReader(const MappedFile& file);
+        OrderFlowReader(const char* data, size_t size);
+        
+        bool next(FlowEvent& event);
+        
+        bool isBinary() const;
+        size_t getMalformedCount() const;
+    };
+
+    // Writers for tools and tests; the binary form holds ids of up to 16 bytes and
+    // writeBinaryFlow throws std::invalid_argument for a longer one
+    void writeCsvFlow(std::ostream& out, const std::vector<FlowEvent>& events);
+    void writeBinaryFlow(std::ostream& out, const std::vector<FlowEvent>& events);
+    
+    // Converts a CSV journal to the binary format once, so repeated replays skip text
+    // parsing. Malformed lines and events with an id over 16 bytes are dropped rather
+    // than cut short; `dropped` receives their count. Returns the number of events written.
+    size_t convertCsvToBinary(const std::string& csvPath, const std::string& binaryPath,
+                              size_t* dropped = nullptr);
+    
+    // ORDER FLOW LOADER - TURNS JOURNAL EVENTS INTO ENGINE COMMANDS
+    // Users are registered on first sight and journal references are mapped to engine
+    // order ids for cancels and modifies. With a SimulatedClock the clock is advanced
+    // to each event's timestamp before it is submitted. A reference is forgotten once
+    // its order is cancelled or filled.
+    // DESIGN DECISION: load() parses a batch of events, then submits the whole batch,
+    // so the parser and the engine each run over a block of work at a time instead of
+    // alternating per event; runs of new orders go through TradingEngine::placeOrders.
+    // Event views point into the reader's mapping, which must outlive the call.
+    class OrderFlowLoader {
+    private:
+        TradingEngine& engine_;
+        SimulatedClock* clock_;
+        size_t batchSize_;
+        std::vector<FlowEvent> batch_;
+        std::function<void(const Symbol&)> symbolSetup_;
+        
+        static constexpr size_t MIN_SWEEP_SIZE = 1024;
+        
+        std::unordered_map<std::uint64_t, std::shared_ptr<Order>> orders_;   // open orders only
+        size_t sweepAt_;                                                      // size that triggers a sweep
+        std::unordered_set<UserId> users_;
+        std::unordered_set<Symbol> symbols_;
+        UserId user_;       // scratch strings reused across events
+        Symbol symbol_;
+        
+        std::vector<OrderRequest> requests_;        // reused by every run of new orders
+        std::vector<std::shared_ptr<Order>> results_;
+        
+        std::uint64_t submitted_;
+        std::uint64_t rejected_;
+        
+        void prepare(const FlowEvent& event);
+        size_t placeRun(const FlowEvent* events, size_t count);
+        void track(std::uint64_t reference, std::shared_ptr<Order> order);
+        bool apply(const FlowEvent& event);
+        
+    public:
+        static constexpr size_t DEFAULT_BATCH_SIZE = 1024;
+        
+        explicit OrderFlowLoader(TradingEngine& engine, SimulatedClock* clock = nullptr,
+                                 size_t batchSize = DEFAULT_BATCH_SIZE);
+        
+        // Called once per symbol before its first order, e.g. to pick a matching rule
+        void setSymbolSetup(std::function<void(const Symbol&)> setup);
+        
+        // Replays the reader to its end; returns the number of events submitted
+        size_t load(OrderFlowReader& reader);
+        // Submits a parsed batch; returns how many requests the engine accepted
+        size_t submit(const FlowEvent* events, size_t count);
+        
+        const std::unordered_set<Symbol>& getSymbols() const;
+        std::uint64_t getSubmittedCount() const;
+        std::uint64_t getRejectedCount() const;   // refused requests and unknown references
+        size_t getOpenReferenceCount() const;     // references still mapped to an order
+    };
+
+} // namespace TradingSystem
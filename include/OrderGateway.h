@@ -0,0 +1,250 @@
+#pragma once
+
+#include "TradingSystemCore.h"
+#include "TradingEngine.h"
+#include "TradeObserver.h"
+#include "ThreadPlacement.h"
+#include "RingQueue.h"
+#include <condition_variable>
+#include <deque>
+#include <set>
+
+namespace TradingSystem {
+
+    // Handle for one asynchronous request; 0 is never issued
+    using Ticket = std::uint64_t;
+    
+    enum class CompletionType { ACCEPTED, REJECTED, FILL, CANCELLED, MODIFIED };
+    
+    // One event on a client's completion queue. Fills carry the ticket of the request
+    // that placed the order, acks and rejects the ticket of the request they answer.
+    struct Completion {
+        Ticket ticket = 0;
+        CompletionType type = CompletionType::REJECTED;
+        OrderId orderId;           // empty when a new order is rejected
+        Quantity quantity = 0;     // fill quantity
+        Price price = 0.0;         // fill price
+    };
+
+    // PER-CLIENT COMPLETION QUEUE - FILLED BY THE GATEWAY, DRAINED BY THE CLIENT
+    class CompletionQueue {
+    private:
+        mutable std::mutex mutex_;
+        std::condition_variable ready_;
+        std::deque<Completion> completions_;
+        
+    public:
+        void push(Completion completion);
+        // One lock and one wake-up for a run of completions
+        void push(const Completion* completions, size_t count);
+        
+        // Moves up to `max` completions into `out`, oldest first; never blocks
+        size_t poll(Completion* out, size_t max);
+        // Waits until a completion is queued or the timeout passes
+        bool waitFor(std::chrono::microseconds timeout);
+        size_t size() const;
+    };
+
+    struct GatewayConfig {
+        size_t workers = 1;
+        ThreadGroupConfig workerThreads;         // "gateway" placement and idle wait
+        size_t commandQueueCapacity = 4096;      // per worker; a full queue blocks submit*()
+        // Deliver completions from a dedicated publisher thread instead of the workers
+        bool publisher = false;
+        ThreadGroupConfig publisherThreads;      // "publisher" placement and idle wait
+        size_t eventQueueCapacity = 4096;        // per worker, worker -> publisher
+        // Priority lanes: cancels and size reductions (same price, smaller quantity)
+        // run ahead of queued new orders and other modifies. Each worker pass takes up
+        // to priorityBurst priority requests, then up to normalBurst others, so a
+        // flood of cancels still leaves new orders a share of the worker.
+        bool priorityLanes = false;
+        size_t priorityBurst = 64;
+        size_t normalBurst = 16;
+    };
+
+    // Depth of one worker lane; depth is a snapshot, peakDepth the deepest backlog
+    // the worker has found in the lane when it came to take from it
+    struct GatewayLaneStats {
+        size_t depth = 0;
+        size_t peakDepth = 0;
+        std::uint64_t executed = 0;
+    };
+
+    struct GatewayStats {
+        std::vector<GatewayLaneStats> priorityLane;   // per worker: cancels and reductions
+        std::vector<GatewayLaneStats> normalLane;     // per worker: new orders and other modifies
+    };
+
+    // ASYNCHRONOUS ORDER ENTRY IN FRONT OF A TradingEngine
+    // submit*() queues the request and returns a ticket at once; worker threads run
+    // the requests against the engine and the outcome (ack, reject, fills) lands on
+    // the client's CompletionQueue, so a client can keep many orders in flight and
+    // collect the results in batches.
+    // DESIGN DECISION: A client's requests always go to the same worker (hashed by
+    // user), so they execute in submission order, while different clients proceed on
+    // different workers. Acks are raised from the engine's order-status callback,
+    // which fires before the order is matched by its own request, so a client always
+    // sees ACCEPTED before any FILL of that order; a fill another worker makes in
+    // between is held back and delivered right after the ACCEPTED.
+    // Requests reach a worker through a lock-free MPSC ring; with a publisher, each
+    // worker hands its completions to the publisher over its own SPSC ring, so the
+    // worker never takes a client queue's lock. Events the engine raises on other
+    // threads (e.g. timer-driven expiries) are delivered directly and may overtake
+    // completions still in a worker's ring.
+    // With priority lanes, requests keep submission order within a lane and requests
+    // for one order never overtake each other: a cancel or reduction only takes the
+    // priority lane while no earlier request for that order waits in the normal lane,
+    // and while one waits in the priority lane, later requests for it follow it there.
+    class AsyncOrderGateway : public TradeObserver {
+    private:
+        enum class CommandType { NEW, CANCEL, MODIFY };
+        
+        struct Command {
+            CommandType type;
+            Ticket ticket;
+            UserId userId;
+            OrderType orderType;
+            Symbol symbol;
+            Quantity quantity;
+            Price price;
+            OrderTimeInForce timeInForce;
+            OrderId orderId;
+            std::shared_ptr<CompletionQueue> queue;
+        };
+        
+        struct Delivery {
+            std::shared_ptr<CompletionQueue> queue;
+            Completion completion;
+        };
+        
+        struct Lane {
+            MpscRing<Command> commands;
+            std::atomic<size_t> peakDepth{0};
+            std::atomic<std::uint64_t> executed{0};
+            
+            Lane(size_t capacity, WorkSignal* readable) : commands(capacity, readable) {}
+        };
+        
+        struct Worker {
+            size_t index;
+            WorkSignal signal;                            // readable signal of both lanes
+            Lane priority;                                // cancels and reductions
+            Lane normal;                                  // new orders and other modifies
+            std::unique_ptr<SpscRing<Delivery>> events;   // publisher mode only
+            // flush() bookkeeping: submitted is bumped before the push, completed after
+            // execution, raised/published count the events handed to the publisher
+            std::atomic<std::uint64_t> submitted{0};
+            std::atomic<std::uint64_t> completed{0};
+            std::atomic<std::uint64_t> raised{0};
+            std::atomic<std::uint64_t> published{0};
+            WorkSignal drained;                           // after each executed batch
+            std::thread thread;
+            
+            Worker(size_t index, size_t commandCapacity)
+                : index(index), priority(commandCapacity, &signal), normal(commandCapacity, &signal) {}
+        };
+        
+        // Live order placed through the gateway, for routing its fills
+        struct OrderRoute {
+            std::shared_ptr<CompletionQueue> queue;
+            Ticket ticket;
+            Quantity remaining;
+            Price price;
+        };
+        
+        // The request a worker is running right now, seen by the engine callbacks
+        // that fire on the worker's thread while the engine call is in progress
+        struct InFlight {
+            const AsyncOrderGateway* gateway;
+            const Command* command;
+            bool acknowledged;
+        };
+        static thread_local InFlight* inFlight_;
+        static thread_local Worker* currentWorker_;
+        
+        TradingEngine& engine_;
+        GatewayConfig config_;
+        WorkSignal publisherSignal_;     // readable signal shared by every worker's event ring
+        WorkSignal delivered_;           // after each batch the publisher delivers
+        std::vector<std::unique_ptr<Worker>> workers_;
+        std::thread publisher_;
+        std::atomic<bool> stopping_{false};
+        std::atomic<bool> publisherStopping_{false};
+        std::atomic<Ticket> nextTicket_{1};
+        
+        mutable std::mutex sessionMutex_;
+        std::unordered_map<UserId, std::shared_ptr<CompletionQueue>> sessions_;
+        
+        std::mutex routeMutex_;
+        std::unordered_map<OrderId, OrderRoute> routes_;
+        
+        // Queued cancels and modifies per order and lane (priority lanes only); at most
+        // one of the two counts is non-zero at a time
+        struct QueuedRequests {
+            size_t priority = 0;
+            size_t normal = 0;
+        };
+        std::unordered_map<OrderId, QueuedRequests> queued_;
+        
+        // EARLY FILLS - ANOTHER WORKER CAN MATCH A NEW ORDER BETWEEN THE ENGINE BOOKING
+        // IT AND RAISING ITS ACCEPTED, BEFORE THE ORDER HAS A ROUTE. While any NEW is in
+        // flight, fills nobody routes are held here in arrival order; the ACCEPTED
+        // replays the ones for its order, and the rest are dropped once every NEW that
+        // was in flight when they arrived has finished
+        struct EarlyFill {
+            std::uint64_t sequence;
+            OrderId orderId;
+            Quantity quantity;
+            Price price;
+        };
+        std::deque<EarlyFill> earlyFills_;
+        std::multiset<std::uint64_t> newsInFlight_;   // fill sequence at each running NEW's start
+        std::uint64_t fillSequence_ = 0;
+        
+        Ticket enqueue(Command command);
+        bool isPriority(const Command& command);
+        bool pickPriorityLane(const Command& command);
+        void dequeued(const Command& command, bool priority);
+        size_t takeFrom(Lane& lane, Command* out, size_t max);
+        void runWorker(Worker& worker);
+        void runPublisher();
+        void execute(Command& command);
+        void deliver(const std::shared_ptr<CompletionQueue>& queue, Completion completion);
+        void routeFill(const OrderId& orderId, const Trade& trade);
+        std::uint64_t beginNew();
+        void endNew(std::uint64_t start);
+        
+    public:
+        // `threads` places the workers and picks how an idle worker waits for requests
+        explicit AsyncOrderGateway(TradingEngine& engine, size_t workers = 1,
+                                   ThreadGroupConfig threads = ThreadGroupConfig());
+        AsyncOrderGateway(TradingEngine& engine, GatewayConfig config);
+        ~AsyncOrderGateway() override;   // finishes every queued request first
+        
+        AsyncOrderGateway(const AsyncOrderGateway&) = delete;
+        AsyncOrderGateway& operator=(const AsyncOrderGateway&) = delete;
+        
+        // Opens (or returns) the user's completion queue; requests from users
+        // without a session are refused with ticket 0
+        std::shared_ptr<CompletionQueue> connect(const UserId& userId);
+        
+        Ticket submitOrder(const UserId& userId, OrderType orderType, const Symbol& symbol,
+                           Quantity quantity, Price price = 0.0,
+                           OrderTimeInForce timeInForce = OrderTimeInForce::GTC);
+        Ticket submitCancel(const UserId& userId, const OrderId& orderId);
+        Ticket submitModify(const UserId& userId, const OrderId& orderId,
+                            Quantity newQuantity, Price newPrice);
+                            
+        // Blocks until every queued request has completed and, with a publisher, its
+        // completions have reached the clients' queues
+        void flush();
+        
+        // Per-worker lane depths and counts; without priority lanes everything
+        // travels in the normal lane
+        GatewayStats getStats() const;
+        
+        void onTradeExecuted(const std::shared_ptr<Trade>& trade) override;
+        void onOrderStatusChanged(const std::shared_ptr<Order>& order) override;
+    };
+
+} // namespace TradingSystem
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "TradingSystemCore.h"
+#include <atomic>
+
+namespace TradingSystem {
+
+    // THROTTLE CONFIGURATION - A RATE OF 0 MEANS UNLIMITED
+    struct ThrottleConfig {
+        double messagesPerSecond = 0.0;  // place + cancel + modify
+        double messageBurst = 1.0;
+        double ordersPerSecond = 0.0;    // new orders only
+        double orderBurst = 1.0;
+    };
+
+    // TOKEN BUCKET - LOCK-FREE RATE LIMITER
+    // DESIGN DECISION: Implemented in its GCRA form (a single "theoretical arrival
+    // time" word) so admission is one load plus one CAS, with no separate refill step
+    class TokenBucket {
+    private:
+        std::atomic<CycleCount> theoreticalArrival_{0};
+        std::atomic<CycleCount> emissionInterval_{0};  // cycles per token, 0 = unlimited
+        std::atomic<CycleCount> burstTolerance_{0};    // cycles of credit for bursts
+
+    public:
+        TokenBucket() = default;
+        TokenBucket(const TokenBucket&) = delete;
+        TokenBucket& operator=(const TokenBucket&) = delete;
+
+        // Rates are converted to ticks of a clock running at ticksPerSecond
+        void configure(double ratePerSecond, double burstSize,
+                       double ticksPerSecond = cycleCounterFrequency());
+        bool isLimited() const;
+
+        bool tryConsume(CycleCount now) {
+            CycleCount interval = emissionInterval_.load(std::memory_order_relaxed);
+            if (interval == 0) return true;
+
+            CycleCount limit = burstTolerance_.load(std::memory_order_relaxed) + interval;
+            CycleCount tat = theoreticalArrival_.load(std::memory_order_relaxed);
+            CycleCount next;
+            do {
+                next = std::max(tat, now) + interval;
+                if (next - now > limit) return false;
+            } while (!theoreticalArrival_.compare_exchange_weak(
+                         tat, next, std::memory_order_relaxed));
+            return true;
+        }
+        
+        // Gives back a token tryConsume took, for a request another limit turned away
+        void refund() {
+            CycleCount interval = emissionInterval_.load(std::memory_order_relaxed);
+            if (interval == 0) return;
+            
+            CycleCount tat = theoreticalArrival_.load(std::memory_order_relaxed);
+            while (!theoreticalArrival_.compare_exchange_weak(
+                       tat, tat > interval ? tat - interval : 0, std::memory_order_relaxed)) {}
+        }
+    };
+
+} // namespace TradingSystem
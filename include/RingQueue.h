@@ -0,0 +1,221 @@
+#pragma once
+
+#include "TradingSystemCore.h"
+#include "WaitStrategy.h"
+
+namespace TradingSystem {
+
+    constexpr size_t CACHE_LINE_SIZE = 64;
+    
+    // ============================================================================
+    // BOUNDED LOCK-FREE RING QUEUES FOR PASSING COMMANDS AND EVENTS BETWEEN THREADS
+    // ============================================================================
+    //
+    // SpscRing - one producer thread, one consumer thread
+    // MpscRing - any number of producer threads, one consumer thread
+    //
+    // Capacity is rounded up to a power of two and fixed at construction; a full
+    // ring refuses a push (tryPush*) or makes the producer wait (push), so a slow
+    // consumer pushes back on its producers instead of growing a queue without bound.
+    // Positions only ever increase and are mapped onto slots by masking, and each
+    // side's position lives on its own cache line so the producer and consumer do
+    // not invalidate each other's lines on every operation.
+    //
+    // Batch operations move a run of items with one position update, which is where
+    // most of the throughput comes from. The blocking forms wait on the ring's
+    // readable()/writable() WorkSignals with any WaitStrategy; several rings can
+    // share one readable signal so one consumer can wait on all of them.
+    
+    namespace RingDetail {
+        inline size_t roundUpCapacity(size_t capacity) {
+            size_t rounded = 2;
+            while (rounded < capacity) rounded <<= 1;
+            return rounded;
+        }
+    }
+    
+    // SINGLE-PRODUCER SINGLE-CONSUMER RING
+    // DESIGN DECISION: Each side keeps a private copy of the other side's position
+    // and only re-reads the shared one when the copy says the ring is full (or
+    // empty), so in steady state a push or pop touches no line the other side writes.
+    template <typename T>
+    class SpscRing {
+    private:
+        // Producer line: next position to write, and the consumer position last seen
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+        size_t cachedHead_ = 0;
+        
+        // Consumer line: next position to read, and the producer position last seen
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};
+        size_t cachedTail_ = 0;
+        
+        alignas(CACHE_LINE_SIZE) const size_t capacity_;
+        const size_t mask_;
+        std::unique_ptr<T[]> slots_;
+        WorkSignal ownReadable_;
+        WorkSignal* readable_;
+        WorkSignal writable_;
+        
+    public:
+        // `readable` replaces the ring's own readable signal, e.g. one signal shared by
+        // every ring a consumer drains
+        explicit SpscRing(size_t capacity, WorkSignal* readable = nullptr)
+            : capacity_(RingDetail::roundUpCapacity(capacity)), mask_(capacity_ - 1),
+              slots_(new T[capacity_]), readable_(readable ? readable : &ownReadable_) {}
+            
+        SpscRing(const SpscRing&) = delete;
+        SpscRing& operator=(const SpscRing&) = delete;
+        
+        size_t capacity() const { return capacity_; }
+        // Exact only when called from one of the two sides while the other is idle
+        size_t size() const { return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire); }
+        bool empty() const { return size() == 0; }
+        
+        // PRODUCER SIDE - moves from items[0..n) for the n items it returns
+        size_t tryPushBatch(T* items, size_t count) {
+            size_t tail = tail_.load(std::memory_order_relaxed);
+            if (capacity_ - (tail - cachedHead_) < count) cachedHead_ = head_.load(std::memory_order_acquire);
+            size_t pushed = std::min(count, capacity_ - (tail - cachedHead_));
+            if (pushed == 0) return 0;
+            for (size_t i = 0; i < pushed; ++i) slots_[(tail + i) & mask_] = std::move(items[i]);
+            tail_.store(tail + pushed, std::memory_order_release);
+            readable_->notifyIfWaiting();
+            return pushed;
+        }
+        
+        bool tryPush(T&& item) { return tryPushBatch(&item, 1) == 1; }
+        
+        void push(T item, WaitStrategy strategy = WaitStrategy::BLOCK) {
+            while (!tryPush(std::move(item))) {
+                writable_.waitUntil([this] { return size() < capacity_; }, strategy);
+            }
+        }
+        
+        // CONSUMER SIDE
+        size_t tryPopBatch(T* out, size_t max) {
+            size_t head = head_.load(std::memory_order_relaxed);
+            if (cachedTail_ - head < max) cachedTail_ = tail_.load(std::memory_order_acquire);
+            size_t popped = std::min(max, cachedTail_ - head);
+            if (popped == 0) return 0;
+            for (size_t i = 0; i < popped; ++i) out[i] = std::move(slots_[(head + i) & mask_]);
+            head_.store(head + popped, std::memory_order_release);
+            writable_.notifyIfWaiting();
+            return popped;
+        }
+        
+        bool tryPop(T& out) { return tryPopBatch(&out, 1) == 1; }
+        
+        // Waits for at least one item; 0 only when `timeout` passes first (BLOCK) or
+        // after one spin round (spinning strategies)
+        size_t popBatch(T* out, size_t max, WaitStrategy strategy = WaitStrategy::BLOCK,
+                        std::chrono::microseconds timeout = std::chrono::microseconds::zero()) {
+            if (size_t popped = tryPopBatch(out, max)) return popped;
+            readable_->waitUntil([this] { return !empty(); }, strategy, timeout);
+            return tryPopBatch(out, max);
+        }
+        
+        WorkSignal& readable() { return *readable_; }
+        WorkSignal& writable() { return writable_; }
+    };
+
+    // MULTI-PRODUCER SINGLE-CONSUMER RING
+    // DESIGN DECISION: Producers claim a run of slots with one CAS on the tail,
+    // bounded by the consumer's published head, then fill and publish each slot with
+    // its own sequence number. The consumer takes slots in order and stops at the
+    // first one not yet published, so a slow producer delays only the items behind
+    // its own, and no lock is ever held across a copy.
+    template <typename T>
+    class MpscRing {
+    private:
+        struct Slot {
+            std::atomic<size_t> sequence{0};   // position + 1 once published
+            T value;
+        };
+        
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};   // next position to claim
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};   // next position to read
+        
+        alignas(CACHE_LINE_SIZE) const size_t capacity_;
+        const size_t mask_;
+        std::unique_ptr<Slot[]> slots_;
+        WorkSignal ownReadable_;
+        WorkSignal* readable_;
+        WorkSignal writable_;
+        
+    public:
+        explicit MpscRing(size_t capacity, WorkSignal* readable = nullptr)
+            : capacity_(RingDetail::roundUpCapacity(capacity)), mask_(capacity_ - 1),
+              slots_(new Slot[capacity_]), readable_(readable ? readable : &ownReadable_) {}
+            
+        MpscRing(const MpscRing&) = delete;
+        MpscRing& operator=(const MpscRing&) = delete;
+        
+        size_t capacity() const { return capacity_; }
+        // Claimed but not yet consumed; includes slots still being filled
+        size_t size() const { return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire); }
+        bool empty() const { return size() == 0; }
+        
+        // PRODUCER SIDE (any thread) - the batch occupies consecutive positions, so it
+        // reaches the consumer uninterleaved with other producers' items
+        size_t tryPushBatch(T* items, size_t count) {
+            size_t tail = tail_.load(std::memory_order_relaxed);
+            size_t claimed;
+            do {
+                size_t free = capacity_ - (tail - head_.load(std::memory_order_acquire));
+                claimed = std::min(count, free);
+                if (claimed == 0) return 0;
+            } while (!tail_.compare_exchange_weak(tail, tail + claimed, std::memory_order_relaxed));
+            
+            for (size_t i = 0; i < claimed; ++i) {
+                Slot& slot = slots_[(tail + i) & mask_];
+                slot.value = std::move(items[i]);
+                slot.sequence.store(tail + i + 1, std::memory_order_release);
+            }
+            readable_->notifyIfWaiting();
+            return claimed;
+        }
+        
+        bool tryPush(T&& item) { return tryPushBatch(&item, 1) == 1; }
+        
+        void push(T item, WaitStrategy strategy = WaitStrategy::BLOCK) {
+            while (!tryPush(std::move(item))) {
+                writable_.waitUntil([this] { return size() < capacity_; }, strategy);
+            }
+        }
+        
+        // CONSUMER SIDE (one thread)
+        size_t tryPopBatch(T* out, size_t max) {
+            size_t head = head_.load(std::memory_order_relaxed);
+            size_t popped = 0;
+            while (popped < max) {
+                Slot& slot = slots_[(head + popped) & mask_];
+                if (slot.sequence.load(std::memory_order_acquire) != head + popped + 1) break;
+                out[popped] = std::move(slot.value);
+                ++popped;
+            }
+            if (popped == 0) return 0;
+            head_.store(head + popped, std::memory_order_release);
+            writable_.notifyIfWaiting();
+            return popped;
+        }
+        
+        bool tryPop(T& out) { return tryPopBatch(&out, 1) == 1; }
+        
+        size_t popBatch(T* out, size_t max, WaitStrategy strategy = WaitStrategy::BLOCK,
+                        std::chrono::microseconds timeout = std::chrono::microseconds::zero()) {
+            if (size_t popped = tryPopBatch(out, max)) return popped;
+            readable_->waitUntil([this] { return readyToPop(); }, strategy, timeout);
+            return tryPopBatch(out, max);
+        }
+        
+        // The next slot is published (claimed slots may still be in the producer's hands)
+        bool readyToPop() const {
+            size_t head = head_.load(std::memory_order_relaxed);
+            return slots_[head & mask_].sequence.load(std::memory_order_acquire) == head + 1;
+        }
+        
+        WorkSignal& readable() { return *readable_; }
+        WorkSignal& writable() { return writable_; }
+    };
+
+} // namespace TradingSystem
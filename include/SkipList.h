@@ -0,0 +1,181 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <functional>
+#include <type_traits>
+
+namespace TradingSystem {
+
+    // SKIP LIST - ORDERED PRICE LEVELS WITHOUT TREE REBALANCING
+    // DESIGN DECISION: The best level is always the first node, so the top of book is
+    // a single pointer read, and inserts near the touch only relink a few towers.
+    // Level heights come from a private xorshift generator, so layouts are
+    // reproducible run to run. Same interface subset as std::map, iterated in
+    // Compare order.
+    template <typename Key, typename Value, typename Compare = std::less<Key>>
+    class SkipList {
+    public:
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = std::pair<const Key, Value>;
+        
+    private:
+        static constexpr int MAX_HEIGHT = 16;
+        
+        struct Node {
+            value_type value;
+            Node* prev = nullptr;   // level-0 back link for reverse iteration
+            int height;
+            std::array<Node*, MAX_HEIGHT> next{};
+            
+            Node(const Key& key, int levels) : value(key, Value()), height(levels) {}
+        };
+        
+        std::array<Node*, MAX_HEIGHT> head_{};
+        Node* tail_ = nullptr;
+        int height_ = 1;
+        size_t size_ = 0;
+        std::uint64_t seed_ = 0x9E3779B97F4A7C15ull;
+        Compare compare_;
+        
+        // Geometric heights with p = 1/4
+        int randomHeight() {
+            seed_ ^= seed_ << 13;
+            seed_ ^= seed_ >> 7;
+            seed_ ^= seed_ << 17;
+            int height = 1;
+            for (std::uint64_t bits = seed_; height < MAX_HEIGHT && (bits & 3) == 0; bits >>= 2) {
+                ++height;
+            }
+            return height;
+        }
+        
+        // Last node before key at every level (nullptr = head)
+        void findPredecessors(const Key& key, std::array<Node*, MAX_HEIGHT>& preds) const {
+            Node* node = nullptr;
+            for (int level = height_ - 1; level >= 0; --level) {
+                Node* next = node ? node->next[level] : head_[level];
+                while (next && compare_(next->value.first, key)) {
+                    node = next;
+                    next = node->next[level];
+                }
+                preds[level] = node;
+            }
+        }
+        
+        Node* successor(Node* pred, int level) const {
+            return pred ? pred->next[level] : head_[level];
+        }
+        
+    public:
+        template <bool Const>
+        class Iterator {
+            friend class SkipList;
+            template <bool> friend class Iterator;
+            using Owner = std::conditional_t<Const, const SkipList, SkipList>;
+            
+            Owner* owner_ = nullptr;
+            Node* node_ = nullptr;   // nullptr = end()
+            
+            Iterator(Owner* owner, Node* node) : owner_(owner), node_(node) {}
+            
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = SkipList::value_type;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::conditional_t<Const, const value_type&, value_type&>;
+            using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+            
+            Iterator() = default;
+            template <bool C = Const, typename = std::enable_if_t<C>>
+            Iterator(const Iterator<false>& other) : owner_(other.owner_), node_(other.node_) {}
+            
+            reference operator*() const { return node_->value; }
+            pointer operator->() const { return &node_->value; }
+            
+            Iterator& operator++() { node_ = node_->next[0]; return *this; }
+            Iterator& operator--() { node_ = node_ ? node_->prev : owner_->tail_; return *this; }
+            Iterator operator++(int) { Iterator old = *this; ++*this; return old; }
+            Iterator operator--(int) { Iterator old = *this; --*this; return old; }
+            
+            bool operator==(const Iterator& other) const { return node_ == other.node_; }
+            bool operator!=(const Iterator& other) const { return node_ != other.node_; }
+        };
+        
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        
+        SkipList() = default;
+        SkipList(const SkipList&) = delete;
+        SkipList& operator=(const SkipList&) = delete;
+        
+        ~SkipList() {
+            for (Node* node = head_[0]; node;) {
+                Node* next = node->next[0];
+                delete node;
+                node = next;
+            }
+        }
+        
+        iterator begin() { return iterator(this, head_[0]); }
+        const_iterator begin() const { return const_iterator(this, head_[0]); }
+        iterator end() { return iterator(this, nullptr); }
+        const_iterator end() const { return const_iterator(this, nullptr); }
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+        
+        bool empty() const { return size_ == 0; }
+        size_t size() const { return size_; }
+        
+        iterator find(const Key& key) {
+            std::array<Node*, MAX_HEIGHT> preds;
+            findPredecessors(key, preds);
+            Node* node = successor(preds[0], 0);
+            bool found = node && !compare_(key, node->value.first);
+            return iterator(this, found ? node : nullptr);
+        }
+        
+        Value& operator[](const Key& key) {
+            std::array<Node*, MAX_HEIGHT> preds;
+            findPredecessors(key, preds);
+            Node* node = successor(preds[0], 0);
+            if (node && !compare_(key, node->value.first)) return node->value.second;
+            
+            int height = randomHeight();
+            for (int level = height_; level < height; ++level) preds[level] = nullptr;
+            height_ = std::max(height_, height);
+            
+            node = new Node(key, height);
+            for (int level = 0; level < height; ++level) {
+                node->next[level] = successor(preds[level], level);
+                (preds[level] ? preds[level]->next[level] : head_[level]) = node;
+            }
+            node->prev = preds[0];
+            (node->next[0] ? node->next[0]->prev : tail_) = node;
+            ++size_;
+            return node->value.second;
+        }
+        
+        void erase(iterator it) {
+            Node* node = it.node_;
+            std::array<Node*, MAX_HEIGHT> preds;
+            findPredecessors(node->value.first, preds);
+            
+            for (int level = 0; level < node->height; ++level) {
+                (preds[level] ? preds[level]->next[level] : head_[level]) = node->next[level];
+            }
+            (node->next[0] ? node->next[0]->prev : tail_) = node->prev;
+            while (height_ > 1 && !head_[height_ - 1]) --height_;
+            
+            delete node;
+            --size_;
+        }
+    };
+
+} // namespace TradingSystem
@@ -0,0 +1,208 @@
+#pragma once
+
+#include "TradingSystemCore.h"
+#include "OrderGateway.h"
+#include <coroutine>
+#include <optional>
+#include <utility>
+
+namespace TradingSystem {
+
+    // ============================================================================
+    // COROUTINE STRATEGIES OVER THE ASYNC GATEWAY
+    // ============================================================================
+    //
+    // A strategy is a coroutine returning StrategyTask that awaits its orders:
+    //
+    //   StrategyTask quote(StrategySession& session) {
+    //       OrderHandle bid = co_await session.place(OrderType::BUY, "INFY", 100, 1800.0);
+    //       while (auto fill = co_await bid.nextFill()) { ... }
+    //   }
+    //
+    // A StrategyScheduler runs on one thread (one per core) and owns its sessions'
+    // completion queues: it polls them in batches, hands each completion to the
+    // order or request it answers, and resumes the coroutine waiting on it. Nothing
+    // blocks and no strategy implements TradeObserver, so thousands of strategies
+    // can share a few threads.
+    
+    class StrategyScheduler;
+    
+    // Coroutine handle owned by the scheduler it is spawned on. Strategies start
+    // suspended and run when the scheduler first reaches them.
+    class StrategyTask {
+    public:
+        struct promise_type {
+            std::exception_ptr exception;
+            
+            StrategyTask get_return_object() {
+                return StrategyTask(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { exception = std::current_exception(); }
+        };
+        
+        StrategyTask(StrategyTask&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+        StrategyTask& operator=(StrategyTask&& other) noexcept;
+        StrategyTask(const StrategyTask&) = delete;
+        StrategyTask& operator=(const StrategyTask&) = delete;
+        ~StrategyTask();
+        
+    private:
+        friend class StrategyScheduler;
+        explicit StrategyTask(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+        std::coroutine_handle<promise_type> release() { return std::exchange(handle_, nullptr); }
+        
+        std::coroutine_handle<promise_type> handle_;
+    };
+
+    struct Fill {
+        Quantity quantity;
+        Price price;
+    };
+
+    // Per-order state the scheduler keeps while completions can still arrive
+    struct StrategyOrderState {
+        Ticket ticket = 0;
+        OrderId orderId;
+        bool answered = false;
+        bool accepted = false;
+        bool open = true;                    // false once filled, cancelled, expired or rejected
+        Quantity remaining = 0;
+        Quantity filled = 0;
+        std::deque<Fill> fills;              // delivered but not yet awaited
+        std::coroutine_handle<> waiter;
+    };
+
+    // Outcome of a cancel or modify request
+    struct StrategyRequestState {
+        Ticket ticket = 0;
+        OrderId orderId;
+        Quantity newQuantity = 0;            // modify only
+        bool answered = false;
+        bool succeeded = false;
+        std::coroutine_handle<> waiter;
+    };
+
+    // AN ORDER AS SEEN BY ITS STRATEGY
+    class OrderHandle {
+    private:
+        std::shared_ptr<StrategyOrderState> state_;
+        
+    public:
+        class FillAwaiter {
+        private:
+            std::shared_ptr<StrategyOrderState> state_;
+            
+        public:
+            explicit FillAwaiter(std::shared_ptr<StrategyOrderState> state) : state_(std::move(state)) {}
+            bool await_ready() const noexcept { return !state_->fills.empty() || !state_->open; }
+            void await_suspend(std::coroutine_handle<> handle) noexcept { state_->waiter = handle; }
+            std::optional<Fill> await_resume();
+        };
+        
+        explicit OrderHandle(std::shared_ptr<StrategyOrderState> state) : state_(std::move(state)) {}
+        
+        bool isAccepted() const { return state_->accepted; }
+        bool isOpen() const { return state_->open; }
+        const OrderId& getOrderId() const { return state_->orderId; }
+        Ticket getTicket() const { return state_->ticket; }
+        Quantity getFilledQuantity() const { return state_->filled; }
+        
+        // Next fill, or nullopt once the order is done and every fill was consumed
+        FillAwaiter nextFill() const { return FillAwaiter(state_); }
+    };
+
+    // ONE USER'S ORDER ENTRY INSIDE A SCHEDULER; all methods run on the scheduler's thread
+    class StrategySession {
+    private:
+        StrategyScheduler& scheduler_;
+        AsyncOrderGateway& gateway_;
+        UserId userId_;
+        std::shared_ptr<CompletionQueue> queue_;
+        
+        friend class StrategyScheduler;
+        
+    public:
+        class PlaceAwaiter {
+        private:
+            std::shared_ptr<StrategyOrderState> state_;
+            
+        public:
+            explicit PlaceAwaiter(std::shared_ptr<StrategyOrderState> state) : state_(std::move(state)) {}
+            bool await_ready() const noexcept { return state_->answered; }
+            void await_suspend(std::coroutine_handle<> handle) noexcept { state_->waiter = handle; }
+            OrderHandle await_resume() { return OrderHandle(state_); }
+        };
+        
+        class RequestAwaiter {
+        private:
+            std::shared_ptr<StrategyRequestState> state_;
+            
+        public:
+            explicit RequestAwaiter(std::shared_ptr<StrategyRequestState> state) : state_(std::move(state)) {}
+            bool await_ready() const noexcept { return state_->answered; }
+            void await_suspend(std::coroutine_handle<> handle) noexcept { state_->waiter = handle; }
+            bool await_resume() const { return state_->succeeded; }
+        };
+        
+        StrategySession(StrategyScheduler& scheduler, AsyncOrderGateway& gateway, const UserId& userId);
+        
+        // Resumes with the order once the engine has accepted or rejected it
+        PlaceAwaiter place(OrderType orderType, const Symbol& symbol, Quantity quantity,
+                           Price price = 0.0, OrderTimeInForce timeInForce = OrderTimeInForce::GTC);
+        // Resume with whether the engine applied the request
+        RequestAwaiter cancel(const OrderHandle& order);
+        RequestAwaiter modify(const OrderHandle& order, Quantity newQuantity, Price newPrice);
+        
+        const UserId& getUserId() const { return userId_; }
+    };
+
+    // SINGLE-THREADED COROUTINE SCHEDULER - RUN ONE PER CORE
+    // DESIGN DECISION: Completions are matched to coroutines by ticket on the
+    // scheduler's own thread, so no per-order state is shared between threads and
+    // awaiting costs a map lookup and a queue push. Resumption is deferred to the
+    // run loop rather than done inside dispatch, so a strategy never runs nested
+    // inside another one.
+    class StrategyScheduler {
+    private:
+        AsyncOrderGateway& gateway_;
+        std::vector<std::unique_ptr<StrategySession>> sessions_;
+        std::vector<std::coroutine_handle<StrategyTask::promise_type>> tasks_;
+        std::deque<std::coroutine_handle<>> ready_;
+        std::unordered_map<Ticket, std::shared_ptr<StrategyOrderState>> orders_;
+        std::unordered_map<Ticket, std::shared_ptr<StrategyRequestState>> requests_;
+        std::unordered_map<OrderId, Ticket> orderTickets_;   // accepted orders still open
+        std::vector<Completion> completions_;                // poll buffer
+        
+        friend class StrategySession;
+        
+        void wake(std::coroutine_handle<>& waiter);
+        void closeOrder(StrategyOrderState& order);
+        void dispatch(const Completion& completion);
+        size_t pollSessions();
+        bool resumeReady();
+        
+    public:
+        static constexpr size_t POLL_BATCH = 256;
+        
+        explicit StrategyScheduler(AsyncOrderGateway& gateway);
+        ~StrategyScheduler();
+        
+        StrategyScheduler(const StrategyScheduler&) = delete;
+        StrategyScheduler& operator=(const StrategyScheduler&) = delete;
+        
+        // A user belongs to one scheduler, which drains its completion queue
+        StrategySession& session(const UserId& userId);
+        
+        void spawn(StrategyTask task);
+        
+        // Runs until every spawned strategy has finished; rethrows the first
+        // exception a strategy let escape. Returns the number of resumptions.
+        std::uint64_t run();
+        
+        size_t getActiveCount() const;
+    };
+
+} // namespace TradingSystem
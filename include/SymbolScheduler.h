@@ -0,0 +1,141 @@
+#pragma once
+
+#include "TradingSystemCore.h"
+#include "ThreadPlacement.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+
+namespace TradingSystem {
+
+    // One unit of work against a symbol's state (typically its single-writer book).
+    // A symbol's commands run one at a time, in submission order.
+    using SymbolCommand = std::function<void()>;
+    
+    struct SymbolSchedulerConfig {
+        size_t workers = 0;              // 0 = one per hardware thread
+        bool workStealing = true;        // false = static partition: a symbol only runs on its home worker
+        size_t quantum = 64;             // commands run per turn before the symbol goes back in line
+        ThreadGroupConfig threads;       // worker CPUs, NUMA policy and idle wait strategy
+        
+        // HOT-SYMBOL REBALANCING - symbols carrying at least hotShare of a window's
+        // commands are pinned to a worker of their own, at most maxDedicated at a time
+        std::chrono::milliseconds rebalanceInterval{0};   // 0 = only on rebalance()
+        double hotShare = 0.2;
+        size_t maxDedicated = 0;
+    };
+
+    // One symbol's activity over the last rebalance window, busiest first
+    struct SymbolLoad {
+        Symbol symbol;
+        std::uint64_t commands = 0;
+        double share = 0.0;
+        int dedicatedWorker = -1;        // -1 = runs on the shared pool
+    };
+
+    struct SymbolSchedulerStats {
+        std::uint64_t executed = 0;
+        std::uint64_t failed = 0;        // commands that threw
+        std::uint64_t steals = 0;
+        std::vector<std::uint64_t> executedPerWorker;
+    };
+
+    // WORK-STEALING SCHEDULER FOR PER-SYMBOL COMMAND QUEUES
+    // Each symbol owns a FIFO of commands. A symbol with pending commands is a task
+    // on exactly one worker's run queue; the worker runs up to `quantum` of its
+    // commands and then re-queues it, so a busy symbol cannot starve the others on
+    // that worker. Idle workers steal queued symbols from busy ones, so skewed flow
+    // spreads over every core instead of saturating one static shard.
+    // DESIGN DECISION: A symbol is either queued on one worker, being run by one
+    // worker, or idle - the `scheduled` flag guarded by the symbol's own mutex is the
+    // only hand-off - so stealing moves whole symbols and never two threads run the
+    // same symbol. Hot symbols can be pinned to a dedicated worker, which runs
+    // nothing else once its queue drains and is never stolen from.
+    class SymbolScheduler {
+    private:
+        struct SymbolQueue {
+            Symbol symbol;
+            size_t hash;
+            std::mutex mutex;
+            std::deque<SymbolCommand> commands;
+            bool scheduled = false;      // queued on a worker or running
+            std::atomic<int> dedicatedWorker{-1};
+            bool autoPinned = false;     // pinned by rebalance(), released when it cools down
+            std::atomic<std::uint64_t> windowCommands{0};
+        };
+        
+        struct Worker {
+            size_t index = 0;
+            std::mutex mutex;
+            std::deque<SymbolQueue*> runnable;
+            WorkSignal signal;           // bumped whenever a symbol is queued here
+            std::atomic<bool> dedicated{false};
+            std::atomic<std::uint64_t> executed{0};
+            std::thread thread;
+        };
+        
+        static thread_local const SymbolScheduler* currentScheduler_;
+        static thread_local int currentWorker_;
+        
+        SymbolSchedulerConfig config_;
+        std::vector<std::unique_ptr<Worker>> workers_;
+        std::atomic<bool> stopping_{false};
+        
+        mutable std::shared_mutex symbolsMutex_;
+        std::unordered_map<Symbol, std::unique_ptr<SymbolQueue>> symbols_;
+        
+        // Pin assignments change under pinMutex_; workers read them lock-free
+        mutable std::mutex pinMutex_;
+        std::vector<SymbolQueue*> pinnedSymbol_;   // per worker
+        
+        std::atomic<std::uint64_t> pending_{0};
+        std::atomic<std::uint64_t> failed_{0};
+        std::atomic<std::uint64_t> steals_{0};
+        std::mutex drainMutex_;
+        std::condition_variable drained_;
+        
+        std::mutex monitorMutex_;
+        std::condition_variable monitorStop_;
+        std::thread monitor_;
+        
+        SymbolQueue& symbolQueue(const Symbol& symbol);
+        SymbolQueue* findSymbol(const Symbol& symbol) const;
+        size_t homeWorker(const SymbolQueue& queue) const;
+        void dispatch(SymbolQueue& queue, const Worker* current);
+        void wakeThief(const Worker& busy);
+        SymbolQueue* steal(Worker& thief);
+        void runSymbol(SymbolQueue& queue, Worker& worker, std::vector<SymbolCommand>& batch);
+        void runWorker(Worker& worker);
+        void runMonitor();
+        bool pinLocked(SymbolQueue& queue, size_t worker);
+        void unpinLocked(SymbolQueue& queue);
+        
+    public:
+        explicit SymbolScheduler(SymbolSchedulerConfig config = SymbolSchedulerConfig());
+        ~SymbolScheduler();   // runs every submitted command first
+        
+        SymbolScheduler(const SymbolScheduler&) = delete;
+        SymbolScheduler& operator=(const SymbolScheduler&) = delete;
+        
+        void submit(const Symbol& symbol, SymbolCommand command);
+        // Blocks until every command submitted so far has run
+        void drain();
+        
+        // Dedicates a worker to one symbol; refused if the worker is out of range,
+        // already dedicated, or the last one left in the shared pool
+        bool pin(const Symbol& symbol, size_t worker);
+        bool unpin(const Symbol& symbol);
+        int getDedicatedWorker(const Symbol& symbol) const;
+        
+        // Closes the current load window: pins symbols that went hot, releases the
+        // ones rebalance() pinned earlier that cooled down, and returns the window
+        std::vector<SymbolLoad> rebalance();
+        
+        SymbolSchedulerStats getStats() const;
+        size_t getWorkerCount() const;
+        
+        // Index of the calling thread's worker in this scheduler, -1 elsewhere
+        int currentWorker() const;
+    };
+
+} // namespace TradingSystem
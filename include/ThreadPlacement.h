@@ -0,0 +1,59 @@
+#pragma once
+
+#include "TradingSystemCore.h"
+#include "WaitStrategy.h"
+
+namespace TradingSystem {
+
+    // PLACEMENT AND WAITING FOR ONE GROUP OF ENGINE THREADS
+    struct ThreadGroupConfig {
+        std::vector<int> cpus;                  // thread i runs on cpus[i % size]; empty = unpinned
+        bool numaLocalMemory = true;            // prefer the pinned CPU's NUMA node for the thread's pages
+        WaitStrategy waitStrategy = WaitStrategy::BLOCK;
+        std::uint32_t spinIterations = 4096;    // spinning strategies: pause-spins per idle check
+    };
+
+    // RUNTIME THREAD LAYOUT - ONE GROUP PER THREAD ROLE ("shard", "gateway",
+    // "journal", ...), parsed from a whitespace-separated spec:
+    //
+    //   shard=2-5 gateway=1 journal=6 wait=busy-spin journal.wait=block numa=1
+    //
+    // `<role>=<cpu list>` pins a role; `wait=`, `spin=` and `numa=` set the defaults
+    // every role starts from and `<role>.wait=` etc. override them for one role.
+    struct ThreadLayout {
+        ThreadGroupConfig defaults;
+        std::map<std::string, ThreadGroupConfig> groups;
+        
+        // The role's group, or the defaults for a role the spec does not name
+        ThreadGroupConfig group(const std::string& role) const;
+        
+        // Throws std::invalid_argument on a malformed spec
+        static ThreadLayout parse(const std::string& spec);
+        // parse() of the variable's value; the default layout when it is unset
+        static ThreadLayout fromEnvironment(const char* variable = "TRADING_THREAD_LAYOUT");
+    };
+
+    // CPU AFFINITY AND NUMA MEMORY POLICY FOR THE CALLING THREAD (LINUX)
+    class ThreadPlacement {
+    public:
+        // "0-3,8,10-11" -> {0, 1, 2, 3, 8, 10, 11}; throws std::invalid_argument
+        static std::vector<int> parseCpuList(const std::string& list);
+        
+        static int cpuCount();
+        static int currentCpu();
+        // NUMA node of a CPU, -1 when the kernel does not report one
+        static int numaNodeOf(int cpu);
+        
+        static bool pinCurrentThread(int cpu);
+        // Pages the calling thread faults in from now on come from `node` while it
+        // has free memory
+        static bool preferNumaNode(int node);
+        
+        // Sets up the calling thread as thread `index` of the group: pins it and, with
+        // numaLocalMemory, moves its allocations to the CPU's node. Books and queues a
+        // pinned worker creates or first touches then live next to it. False when
+        // the CPU cannot be used (the thread stays where it was).
+        static bool apply(const ThreadGroupConfig& group, size_t index);
+    };
+
+} // namespace TradingSystem
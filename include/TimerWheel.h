@@ -0,0 +1,58 @@
+#pragma once
+
+#include "TradingSystemCore.h"
+#include "Order.h"
+#include <array>
+#include <vector>
+
+namespace TradingSystem {
+
+    // HIERARCHICAL TIMING WHEEL - O(1) SCHEDULING OF ORDER EXPIRATIONS
+    // DESIGN DECISION: Five levels of 1 ms ticks (256 slots, then 4 x 64 slots) cover
+    // ~49 days; a timer moves down one level at most four times before it fires.
+    // Timers are never removed on cancel - the owner re-checks the order when it fires.
+    class TimerWheel {
+    public:
+        using Tick = std::uint64_t;
+        
+        explicit TimerWheel(Tick startTick);
+        
+        // nowTick re-bases an empty wheel, so a wheel created long before its first
+        // timer does not walk the gap on the next advance
+        void schedule(Tick expiry, Tick nowTick, std::shared_ptr<Order> order);
+        
+        // Advances to nowTick and appends every order whose timer fell due. With the
+        // root level empty it jumps straight to the next cascade that has work
+        void advance(Tick nowTick, std::vector<std::shared_ptr<Order>>& due);
+        
+        size_t size() const;
+        Tick getCurrentTick() const;
+        
+        static Tick toTick(const Timestamp& timestamp);
+        
+    private:
+        static constexpr int LEVELS = 5;
+        static constexpr int ROOT_BITS = 8;
+        static constexpr int LEVEL_BITS = 6;
+        static constexpr Tick ROOT_SIZE = Tick(1) << ROOT_BITS;
+        static constexpr Tick LEVEL_SIZE = Tick(1) << LEVEL_BITS;
+        
+        struct Timer {
+            Tick expiry;
+            std::shared_ptr<Order> order;
+        };
+        using Slot = std::vector<Timer>;
+        
+        std::array<std::vector<Slot>, LEVELS> levels_;
+        Slot overflow_;   // beyond the wheel's horizon, re-placed on the top-level cascade
+        Tick currentTick_;
+        size_t size_;
+        size_t rootCount_;   // timers currently in the 1 ms level
+        
+        static int levelShift(int level);
+        Tick nextCascadeTick() const;
+        void place(Timer timer);
+        void cascade(int level);
+    };
+
+} // namespace TradingSystem
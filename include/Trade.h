@@ -14,12 +14,14 @@ namespace TradingSystem {
         Symbol symbol_;
         Quantity quantity_;
         Price price_;
-        Timestamp timestamp_;
+        CycleCount executionTicks_;   // raw ticks of clock_
+        const Clock* clock_;
         
     public:
         Trade(const TradeId& tradeId, OrderType tradeType,
               const OrderId& buyerOrderId, const OrderId& sellerOrderId,
-              const Symbol& symbol, Quantity quantity, Price price);
+              const Symbol& symbol, Quantity quantity, Price price,
+              const Clock& clock = RealTimeClock::instance());
         
         const TradeId& getTradeId() const;
         OrderType getTradeType() const;
@@ -28,7 +30,8 @@ namespace TradingSystem {
         const Symbol& getSymbol() const;
         Quantity getQuantity() const;
         Price getPrice() const;
-        const Timestamp& getTimestamp() const;
+        Timestamp getTimestamp() const;   // converted on demand
+        CycleCount getExecutionTicks() const;
     };
 
 } // namespace TradingSystem
@@ -4,18 +4,38 @@
 #include "User.h"
 #include "OrderBook.h"
 #include "TradeObserver.h"
+#include "LatencyHistogram.h"
+#include "Clock.h"
+#include "IdGenerator.h"
 #include <unordered_map>
 #include <vector>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
+#include <span>
 
 namespace TradingSystem {
 
+    // ONE NEW ORDER OF A BATCH SUBMISSION - THE ARGUMENTS OF placeOrder
+    struct OrderRequest {
+        UserId userId;
+        OrderType orderType = OrderType::BUY;
+        Symbol symbol;
+        Quantity quantity = 0;
+        Price price = 0.0;                                   // 0 = market order
+        OrderTimeInForce timeInForce = OrderTimeInForce::GTC;
+        Timestamp expireTime{};                              // GTD only
+    };
+
+    // DESIGN DECISION: Engines share no state, so a process can run any number of
+    // them (parallel backtests, one per simulated venue, one per test). Each owns its
+    // books, users, orders, clock and id source; getInstance() is only a convenience
+    // default engine.
     class TradingEngine {
     private:
-        static TradingEngine* instance_;
-        static std::mutex instanceMutex_;
+        // Declared first so they outlive the books that hold references to them
+        std::shared_ptr<const Clock> clock_;
+        std::shared_ptr<IdGenerator> idGenerator_;
         
         std::unordered_map<Symbol, std::unique_ptr<OrderBook>> orderBooks_;
         std::unordered_map<UserId, std::shared_ptr<User>> users_;
@@ -23,24 +43,66 @@ namespace TradingSystem {
         
         mutable std::shared_mutex mutex_;
         
+        // Venue-wide kill switch, checked before anything else on order entry
+        std::atomic<bool> killSwitch_{false};
+        
         // Track all orders for status queries
         std::unordered_map<OrderId, std::shared_ptr<Order>> allOrders_;
         
-        TradingEngine() = default;
-        
     public:
+        // Process-wide default engine, constructed on first use (thread-safe static
+        // initialization, no lock on later calls) and destroyed at exit
         static TradingEngine& getInstance();
         
+        // Null sources select the real-time clock and random UUIDs. A SimulatedClock
+        // with a SequentialIdGenerator makes a replay run at full speed and produce the
+        // same orders, trades and timestamps on every run. Orders and trades keep a
+        // pointer to the clock, so it must outlive anything handed out by the engine.
+        explicit TradingEngine(std::shared_ptr<const Clock> clock = nullptr,
+                               std::shared_ptr<IdGenerator> idGenerator = nullptr);
+        
         TradingEngine(const TradingEngine&) = delete;
         TradingEngine& operator=(const TradingEngine&) = delete;
         
         bool registerUser(const std::shared_ptr<User>& user);
         std::shared_ptr<User> getUser(const UserId& userId) const;
+        bool setUserThrottle(const UserId& userId, const ThrottleConfig& config);
         
         std::shared_ptr<Order> placeOrder(const UserId& userId, OrderType orderType,
                                          const Symbol& symbol, Quantity quantity, 
                                          Price price = 0.0);
         
+        // GTD / DAY variant of placeOrder; expireTime is only used for GTD
+        std::shared_ptr<Order> placeOrder(const UserId& userId, OrderType orderType,
+                                         const Symbol& symbol, Quantity quantity,
+                                         Price price, OrderTimeInForce timeInForce,
+                                         Timestamp expireTime = Timestamp());
+        
+        // BATCH ORDER ENTRY - results[i] is the placed order or null if requests[i] was
+        // rejected (results must be at least as long as requests); returns the number
+        // placed. Each book ends up exactly as if the requests had been placed one by
+        // one in array order, but the engine maps are locked once per batch and each
+        // book once per symbol in the batch, in the order symbols first appear.
+        // Observers hear about an order after its symbol's run has been matched, so
+        // they see its status at that point, followed by its trades.
+        size_t placeOrders(std::span<const OrderRequest> requests,
+                           std::span<std::shared_ptr<Order>> results);
+        
+        // Stop (limitPrice == 0) or stop-limit order, parked until a trade crosses stopPrice
+        std::shared_ptr<Order> placeStopOrder(const UserId& userId, OrderType orderType,
+                                             const Symbol& symbol, Quantity quantity,
+                                             Price stopPrice, Price limitPrice = 0.0);
+        
+        // Iceberg order showing at most peakQuantity at a time
+        std::shared_ptr<Order> placeIcebergOrder(const UserId& userId, OrderType orderType,
+                                                const Symbol& symbol, Quantity quantity,
+                                                Price price, Quantity peakQuantity);
+                                                
+        // Pegged order tracking the same-side best price or the midpoint, plus offset
+        std::shared_ptr<Order> placePeggedOrder(const UserId& userId, OrderType orderType,
+                                               const Symbol& symbol, Quantity quantity,
+                                               PegType pegType, Price offset = 0.0);
+                                                
         bool cancelOrder(const UserId& userId, const OrderId& orderId);
         bool modifyOrder(const UserId& userId, const OrderId& orderId,
                         Quantity newQuantity, Price newPrice);
@@ -48,11 +110,61 @@ namespace TradingSystem {
         std::shared_ptr<Order> getOrderStatus(const UserId& userId, const OrderId& orderId) const;
         std::vector<std::shared_ptr<Order>> getUserOrders(const UserId& userId) const;
         
+        // EXPIRY - FIRES DUE GTD ORDERS ACROSS ALL BOOKS, ONE BATCH PER BOOK
+        // Order entry, modifies and batch auctions also expire whatever is due in the
+        // book they touch at the engine clock's time, so a GTD order never trades past
+        // its expiry even when nothing calls these
+        size_t processExpirations();   // at the engine clock's current time
+        size_t processExpirations(Timestamp now);
+        size_t endTradingSession();
+        
+        // CALL AUCTIONS (OPEN / CLOSE) - uncrossAuction returns the number of trades
+        void beginCallAuction(const Symbol& symbol);
+        size_t uncrossAuction(const Symbol& symbol);
+        AuctionIndicative getIndicativeAuction(const Symbol& symbol) const;
+        
+        // FREQUENT BATCH AUCTIONS - A ZERO INTERVAL RETURNS THE SYMBOL TO CONTINUOUS
+        // MATCHING. runBatchAuctions() is meant to be driven by a timer thread; order
+        // entry also cuts a batch once its interval has elapsed
+        void setBatchAuctionInterval(const Symbol& symbol, std::chrono::microseconds interval);
+        size_t runBatchAuctions();
+        BatchAuctionStats getBatchAuctionStats(const Symbol& symbol) const;
+        
+        // Level allocation rule of a symbol's product class (FIFO by default)
+        void setMatchingAlgorithm(const Symbol& symbol, MatchingAlgorithm algorithm);
+        
+        // L2 market data for a symbol, best level first (displayed quantity only)
+        std::vector<DepthLevel> getBidDepth(const Symbol& symbol, size_t maxLevels) const;
+        std::vector<DepthLevel> getAskDepth(const Symbol& symbol, size_t maxLevels) const;
+        
+        // KILL SWITCHES - ACTIVATION IS A SINGLE ATOMIC STORE AND NEVER TAKES mutex_,
+        // SO IT TAKES EFFECT EVEN WHILE THE ENGINE IS SATURATED
+        void setKillSwitch(bool active);
+        bool isKillSwitchActive() const;
+        bool setUserKillSwitch(const UserId& userId, bool active, bool cancelOpenOrders = false);
+        
+        // Mass-cancel every open order of a user, returns the number cancelled
+        int cancelAllOrders(const UserId& userId);
+        
         void registerObserver(TradeObserver* observer);
         void unregisterObserver(TradeObserver* observer);
         
+        const Clock& getClock() const;
+        
     private:
+        template <typename OrderT, typename... Args>
+        std::unique_ptr<Order> newOrder(Args&&... args) {
+            auto order = std::make_unique<OrderT>(idGenerator_->next(), std::forward<Args>(args)...);
+            order->stampEntry(*clock_);
+            return order;
+        }
+        
+        std::shared_ptr<User> admitNewOrder(const UserId& userId);
+        bool cancelIfFrozen(OrderBook& orderBook, const User& user, const std::shared_ptr<Order>& order);
+        void expireDue(OrderBook& orderBook);
+        std::shared_ptr<Order> submitOrder(std::unique_ptr<Order> order, const User& user);
         OrderBook* getOrCreateOrderBook(const Symbol& symbol);
+        OrderBook* findOrderBook(const Symbol& symbol) const;
         void notifyTradeExecuted(const std::shared_ptr<Trade>& trade);
         void notifyOrderStatusChanged(const std::shared_ptr<Order>& order);
     };
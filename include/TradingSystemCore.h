@@ -19,13 +19,21 @@
 #include <cassert>
 #include <stdexcept>
 #include <future>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
 namespace TradingSystem {
 
     // DESIGN PRINCIPLE: Use strong typing with enums instead of primitive types
     enum class OrderType { BUY, SELL };
-    enum class OrderStatus { PENDING, ACCEPTED, PARTIALLY_FILLED, FILLED, CANCELLED, REJECTED };
-    enum class OrderTimeInForce { GTC, IOC, FOK }; // Good Till Cancel, Immediate or Cancel, Fill or Kill
+    enum class OrderStatus { PENDING, ACCEPTED, PARTIALLY_FILLED, FILLED, CANCELLED, REJECTED, EXPIRED };
+    enum class OrderTimeInForce { GTC, IOC, FOK, GTD, DAY }; // Good Till Cancel, Immediate or Cancel, Fill or Kill, Good Till Date, Day
+    enum class TradingPhase { CONTINUOUS, CALL_AUCTION }; // Call: orders accumulate, no matching
+    enum class PegType { PRIMARY, MIDPOINT }; // Same-side best price, or BBO midpoint
+    enum class MatchingAlgorithm { FIFO, PRO_RATA, FIFO_PRO_RATA }; // Level allocation rule of a product
 
     // DESIGN DECISION: Define system-wide constraints to prevent invalid states
     constexpr int MAX_ORDER_QUANTITY = 1000000;
@@ -40,16 +48,70 @@ namespace TradingSystem {
     using Quantity = int;
     using Price = double;
     using Timestamp = std::chrono::system_clock::time_point;
+    using CycleCount = std::uint64_t;
 
     // Utility function declarations
     std::string generateUUID();
-    Timestamp getCurrentTimestamp();
+    Timestamp getCurrentTimestamp();   // wall time via TscClock, no system_clock call
+
+    // DESIGN DECISION: Hot-path rate accounting reads the CPU cycle counter directly
+    // instead of system_clock::now() - a few cycles versus a clock_gettime call
+    inline CycleCount readCycleCounter() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<CycleCount>(
+            std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    // Cycles per second of readCycleCounter(), from the current TscClock calibration
+    double cycleCounterFrequency();
+    
+    // ONE PAIRED READING OF THE CYCLE COUNTER AND BOTH KERNEL CLOCKS
+    struct ClockCalibration {
+        CycleCount ticks = 0;
+        std::int64_t realtimeNs = 0;    // CLOCK_REALTIME at `ticks`
+        std::int64_t monotonicNs = 0;   // CLOCK_MONOTONIC at `ticks`
+        double nsPerTick = 1.0;
+        // After a recalibration that found a clock behind the previous anchor's
+        // extrapolation, that clock runs at half rate for this many ticks instead
+        // of stepping back
+        CycleCount realtimeCatchUpTicks = 0;
+        CycleCount monotonicCatchUpTicks = 0;
+    };
+
+    // CALIBRATED CYCLE-COUNTER CLOCK
+    // DESIGN DECISION: Orders and trades stamp raw readCycleCounter() ticks, which
+    // are monotonic on an invariant TSC and cost a few ns; the calibration against
+    // CLOCK_MONOTONIC (rate) and CLOCK_REALTIME (epoch) is applied only when a time
+    // leaves the engine. Calibration runs once at startup; recalibrate() re-anchors
+    // it to bound drift against NTP-disciplined wall time in long-running processes.
+    // The last CALIBRATION_HISTORY anchors are kept and a tick converts through the
+    // anchor in effect when it was taken, so earlier stamps never move; a stamp older
+    // than every kept anchor converts through the oldest one. Each new anchor picks up
+    // where the previous one's extrapolation left off if the kernel clock is behind
+    // it, and slews back, so converted stamps never go backwards.
+    class TscClock {
+    public:
+        static CycleCount now() { return readCycleCounter(); }
+        
+        static constexpr size_t CALIBRATION_HISTORY = 64;
+        
+        // The newest anchor; stays valid until CALIBRATION_HISTORY more recalibrations
+        static const ClockCalibration& calibration();
+        static void recalibrate();
+        
+        static std::chrono::nanoseconds toDuration(CycleCount elapsedTicks);
+        static std::int64_t toMonotonicNs(CycleCount ticks);
+        static Timestamp toTimestamp(CycleCount ticks);
+    };
 
     // Forward declarations
     class User;
     class Order;
     class Trade;
-    class OrderBook;
+    template <typename Policies> class BasicOrderBook;
     class TradeObserver;
     class TradingEngine;
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "TradingSystemCore.h"
+#include "RateLimiter.h"
 
 namespace TradingSystem {
 
@@ -11,6 +12,16 @@ namespace TradingSystem {
         std::string phoneNumber_;
         std::string emailId_;
         
+        // DESIGN DECISION: Throttle state lives in the user's own slot, so the
+        // getUser() lookup that every request already pays brings it into cache
+        struct alignas(64) Throttle {
+            TokenBucket messages;
+            TokenBucket orders;
+            std::atomic<std::uint64_t> rejected{0};
+        } throttle_;
+        
+        std::atomic<bool> killSwitch_{false};
+        
     public:
         User(const UserId& userId, const std::string& userName, 
              const std::string& phoneNumber, const std::string& emailId);
@@ -21,6 +32,19 @@ namespace TradingSystem {
         const std::string& getEmailId() const;
         
         bool isValid() const;
+        
+        // RATE LIMITING - CALLED ON THE HOT PATH BEFORE ANY BOOK IS TOUCHED
+        // ticksPerSecond: rate of the clock whose ticks are passed to admit*()
+        void setThrottle(const ThrottleConfig& config, double ticksPerSecond = cycleCounterFrequency());
+        bool admitMessage(CycleCount now);
+        bool admitOrder(CycleCount now);
+        std::uint64_t getThrottleRejectCount() const;
+        
+        // KILL SWITCH - LOCK-FREE, SAFE TO FLIP FROM ANY THREAD
+        void setKillSwitch(bool active);
+        bool isKillSwitchActive() const {
+            return killSwitch_.load(std::memory_order_relaxed);
+        }
     };
 
 } // namespace TradingSystem
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "TradingSystemCore.h"
+
+namespace TradingSystem {
+
+    // HOW AN IDLE ENGINE THREAD WAITS FOR WORK - CPU TRADED FOR WAKE-UP LATENCY
+    enum class WaitStrategy {
+        BLOCK,          // sleep in the kernel (futex) until notified: no CPU, microseconds to wake
+        SPIN_YIELD,     // pause-spin, then yield the core between checks: never sleeps
+        BUSY_SPIN       // pause-spin only: owns its core, wakes in tens of nanoseconds
+    };
+
+    const char* toString(WaitStrategy strategy);
+    // "block", "spin-yield" or "busy-spin"; throws std::invalid_argument otherwise
+    WaitStrategy parseWaitStrategy(const std::string& name);
+    
+    inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#endif
+    }
+    
+    // WAKE-UP SIGNAL FOR ONE WAITING THREAD
+    // notify() bumps an epoch. A waiter reads the epoch *before* checking its queue
+    // and waits only while the epoch is unchanged, so a notify that lands between
+    // the check and the wait is never lost.
+    // DESIGN DECISION: The epoch is itself the futex word, and notify() enters the
+    // kernel only when a waiter is actually blocked on it, so producers feeding a
+    // spinning consumer never make a system call.
+    class WorkSignal {
+    private:
+        std::atomic<std::uint32_t> epoch_{0};
+        std::atomic<std::uint32_t> blocked_{0};
+        
+        // Futex wait while the epoch still equals `seen`
+        void block(std::uint32_t seen, std::chrono::microseconds timeout);
+        
+    public:
+        std::uint32_t epoch() const { return epoch_.load(std::memory_order_acquire); }
+        
+        void notify();
+        void notifyAll();
+        bool hasBlockedWaiter() const { return blocked_.load(std::memory_order_seq_cst) != 0; }
+        
+        // For producers whose consumer waits with waitUntil(): call after publishing.
+        // No system call unless a consumer is actually blocked.
+        // DESIGN DECISION: A read-modify-write rather than a fence plus load: it reads
+        // the latest waiter count, and a waiter registering after it synchronizes with
+        // it and so sees what was published. Same ordering, and visible to TSan.
+        void notifyIfWaiting() {
+            if (blocked_.fetch_add(0, std::memory_order_seq_cst) != 0) notifyAll();
+        }
+        
+        // Waits for the epoch to move past `seen`. BLOCK sleeps until notified or
+        // `timeout` passes (zero = no timeout); the spinning strategies give up after
+        // `spinIterations` so the caller can look for other work (e.g. to steal).
+        // Returns true once the epoch has moved.
+        bool wait(std::uint32_t seen, WaitStrategy strategy,
+                  std::chrono::microseconds timeout = std::chrono::microseconds::zero(),
+                  std::uint32_t spinIterations = 4096);
+        
+        // Waits until `ready()` holds, re-checking it after registering as blocked so
+        // that a producer's notifyIfWaiting() cannot slip between check and sleep. Like
+        // wait(), the spinning strategies return after one spin round; returns ready().
+        template <typename Ready>
+        bool waitUntil(Ready ready, WaitStrategy strategy,
+                       std::chrono::microseconds timeout = std::chrono::microseconds::zero(),
+                       std::uint32_t spinIterations = 4096) {
+            if (strategy != WaitStrategy::BLOCK) {
+                for (std::uint32_t i = 0; i < spinIterations; ++i) {
+                    if (ready()) return true;
+                    cpuRelax();
+                }
+                if (strategy == WaitStrategy::SPIN_YIELD) std::this_thread::yield();
+                return ready();
+            }
+            std::uint32_t seen = epoch();
+            blocked_.fetch_add(1, std::memory_order_seq_cst);
+            if (!ready()) block(seen, timeout);
+            blocked_.fetch_sub(1, std::memory_order_seq_cst);
+            return ready();
+        }
+    };
+
+} // namespace TradingSystem
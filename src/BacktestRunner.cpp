@@ -0,0 +1,118 @@
+#include "../include/BacktestRunner.h"
+#include "../include/TradingEngine.h"
+#include <fstream>
+
+namespace TradingSystem {
+
+    namespace {
+    
+        // Aggregates fills and, when a path is given, writes the trade tape
+        class TapeRecorder : public TradeObserver {
+        private:
+            std::ofstream tape_;
+            
+        public:
+            std::uint64_t trades = 0;
+            std::uint64_t volume = 0;
+            double notional = 0.0;
+            
+            explicit TapeRecorder(const std::string& path) {
+                if (path.empty()) return;
+                tape_.open(path, std::ios::trunc);
+                if (!tape_) throw std::runtime_error("cannot write " + path);
+                tape_ << "trade_id,timestamp_ns,symbol,buy_order_id,sell_order_id,quantity,price\n";
+                tape_ << std::setprecision(10);
+            }
+            
+            void onTradeExecuted(const std::shared_ptr<Trade>& trade) override {
+                ++trades;
+                volume += trade->getQuantity();
+                notional += trade->getQuantity() * trade->getPrice();
+                if (!tape_.is_open()) return;
+                tape_ << trade->getTradeId() << ','
+                      << std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             trade->getTimestamp().time_since_epoch()).count() << ','
+                      << trade->getSymbol() << ',' << trade->getBuyerOrderId() << ','
+                      << trade->getSellerOrderId() << ',' << trade->getQuantity() << ','
+                      << trade->getPrice() << '\n';
+            }
+            
+            void onOrderStatusChanged(const std::shared_ptr<Order>&) override {}
+        };
+        
+    } // namespace
+    
+    BacktestRunner::BacktestRunner(unsigned workers, ThreadGroupConfig threads)
+        : workers_(workers ? workers : std::max(1u, std::thread::hardware_concurrency())),
+          threads_(std::move(threads)) {}
+        
+    std::vector<BacktestStats> BacktestRunner::run(const std::vector<BacktestScenario>& scenarios) const {
+        std::vector<BacktestStats> results(scenarios.size());
+        std::atomic<size_t> nextScenario{0};
+        
+        auto worker = [&] {
+            for (size_t i = nextScenario++; i < scenarios.size(); i = nextScenario++) {
+                results[i] = runScenario(scenarios[i]);
+            }
+        };
+        
+        size_t threads = std::min<size_t>(workers_, scenarios.size());
+        std::vector<std::thread> pool;
+        for (size_t t = 1; t < threads; ++t) {
+            pool.emplace_back([this, &worker, t] {
+                ThreadPlacement::apply(threads_, t - 1);
+                worker();
+            });
+        }
+        worker();   // the calling thread is one of the workers
+        for (auto& thread : pool) thread.join();
+        return results;
+    }
+    
+    BacktestStats BacktestRunner::runScenario(const BacktestScenario& scenario) {
+        BacktestStats stats;
+        stats.scenario = scenario.name;
+        
+        try {
+            MappedFile file(scenario.inputPath);
+            OrderFlowReader reader(file);
+            
+            auto clock = std::make_shared<SimulatedClock>();
+            TradingEngine engine(clock, std::make_shared<SequentialIdGenerator>("BT"));
+            TapeRecorder recorder(scenario.tapePath);
+            engine.registerObserver(&recorder);
+            
+            OrderFlowLoader loader(engine, clock.get());
+            loader.setSymbolSetup([&engine, &scenario](const Symbol& symbol) {
+                engine.setMatchingAlgorithm(symbol, scenario.matchingAlgorithm);
+                if (scenario.batchInterval.count() > 0) {
+                    engine.setBatchAuctionInterval(symbol, scenario.batchInterval);
+                }
+            });
+            
+            auto start = std::chrono::steady_clock::now();
+            stats.events = loader.load(reader);
+            stats.rejected = loader.getRejectedCount();
+            
+            // Whatever is still sitting in a batch is uncrossed before the books close
+            if (scenario.batchInterval.count() > 0) {
+                for (const auto& batched : loader.getSymbols()) {
+                    engine.setBatchAuctionInterval(batched, std::chrono::microseconds(0));
+                }
+            }
+            stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            engine.unregisterObserver(&recorder);
+            
+            stats.malformed = reader.getMalformedCount();
+            stats.trades = recorder.trades;
+            stats.volume = recorder.volume;
+            stats.notional = recorder.notional;
+            stats.vwap = recorder.volume ? recorder.notional / recorder.volume : 0.0;
+            stats.eventsPerSecond = stats.seconds > 0 ? stats.events / stats.seconds : 0.0;
+        } catch (const std::exception& e) {
+            stats.error = e.what();
+        }
+        return stats;
+    }
+
+} // namespace TradingSystem
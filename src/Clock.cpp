@@ -0,0 +1,46 @@
+#include "../include/Clock.h"
+
+namespace TradingSystem {
+
+    const RealTimeClock& RealTimeClock::instance() {
+        static const RealTimeClock clock;
+        return clock;
+    }
+    
+    double RealTimeClock::ticksPerSecond() const {
+        return cycleCounterFrequency();
+    }
+    
+    Timestamp RealTimeClock::toTimestamp(CycleCount ticks) const {
+        return TscClock::toTimestamp(ticks);
+    }
+    
+    SimulatedClock::SimulatedClock(Timestamp start)
+        : nowNs_(std::chrono::duration_cast<std::chrono::nanoseconds>(start.time_since_epoch()).count()) {}
+        
+    CycleCount SimulatedClock::now() const {
+        return static_cast<CycleCount>(nowNs_.load(std::memory_order_acquire));
+    }
+    
+    double SimulatedClock::ticksPerSecond() const {
+        return 1e9;
+    }
+    
+    Timestamp SimulatedClock::toTimestamp(CycleCount ticks) const {
+        return Timestamp(std::chrono::duration_cast<Timestamp::duration>(
+            std::chrono::nanoseconds(static_cast<std::int64_t>(ticks))));
+    }
+    
+    void SimulatedClock::advanceTo(Timestamp timestamp) {
+        std::int64_t target =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+        std::int64_t current = nowNs_.load(std::memory_order_relaxed);
+        while (current < target &&
+               !nowNs_.compare_exchange_weak(current, target, std::memory_order_release)) {}
+    }
+    
+    void SimulatedClock::advanceBy(std::chrono::nanoseconds elapsed) {
+        if (elapsed.count() > 0) nowNs_.fetch_add(elapsed.count(), std::memory_order_release);
+    }
+
+} // namespace TradingSystem
@@ -0,0 +1,20 @@
+#include "../include/IdGenerator.h"
+
+namespace TradingSystem {
+
+    UuidGenerator& UuidGenerator::instance() {
+        static UuidGenerator generator;
+        return generator;
+    }
+    
+    std::string UuidGenerator::next() {
+        return generateUUID();
+    }
+    
+    SequentialIdGenerator::SequentialIdGenerator(const std::string& prefix) : prefix_(prefix) {}
+    
+    std::string SequentialIdGenerator::next() {
+        return prefix_ + "-" + std::to_string(next_.fetch_add(1, std::memory_order_relaxed));
+    }
+
+} // namespace TradingSystem
@@ -0,0 +1,203 @@
+#include "../include/LatencyHistogram.h"
+#include <cmath>
+#include <condition_variable>
+
+namespace TradingSystem {
+
+    const char* toString(LatencyMetric metric) {
+        switch (metric) {
+            case LatencyMetric::PLACE_ORDER: return "place_order";
+            case LatencyMetric::CANCEL_ORDER: return "cancel_order";
+            case LatencyMetric::MODIFY_ORDER: return "modify_order";
+            case LatencyMetric::MATCH_ORDERS: return "match_orders";
+            case LatencyMetric::OBSERVER_DISPATCH: return "observer_dispatch";
+            case LatencyMetric::PLACE_ORDER_BATCH: return "place_order_batch";
+        }
+        return "unknown";
+    }
+    
+    CycleCount LatencyHistogram::bucketUpperBound(size_t bucket) {
+        if (bucket < 2 * SUB_BUCKETS) return bucket;
+        size_t exponent = bucket / SUB_BUCKETS - 1;
+        CycleCount subBucket = bucket % SUB_BUCKETS + SUB_BUCKETS;
+        return ((subBucket + 1) << exponent) - 1;
+    }
+    
+    void LatencyHistogram::mergeInto(LatencyHistogram& target) const {
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            std::uint64_t count = counts_[i].load(std::memory_order_relaxed);
+            if (count) bump(target.counts_[i], count);
+        }
+        bump(target.total_, total_.load(std::memory_order_relaxed));
+        CycleCount max = max_.load(std::memory_order_relaxed);
+        if (max > target.max_.load(std::memory_order_relaxed)) {
+            target.max_.store(max, std::memory_order_relaxed);
+        }
+    }
+    
+    void LatencyHistogram::clear() {
+        for (auto& count : counts_) count.store(0, std::memory_order_relaxed);
+        total_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+    
+    std::uint64_t LatencyHistogram::getCount() const {
+        return total_.load(std::memory_order_relaxed);
+    }
+    
+    CycleCount LatencyHistogram::getMax() const {
+        return max_.load(std::memory_order_relaxed);
+    }
+    
+    CycleCount LatencyHistogram::valueAtQuantile(double quantile) const {
+        std::uint64_t total = getCount();
+        if (total == 0) return 0;
+        
+        auto target = static_cast<std::uint64_t>(std::ceil(quantile * static_cast<double>(total)));
+        target = std::max<std::uint64_t>(target, 1);
+        
+        std::uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            seen += counts_[i].load(std::memory_order_relaxed);
+            if (seen >= target) return std::min(bucketUpperBound(i), getMax());
+        }
+        return getMax();
+    }
+    
+    namespace {
+    
+        using MetricHistograms = std::array<LatencyHistogram, LATENCY_METRIC_COUNT>;
+        
+        struct Registry {
+            std::mutex mutex;
+            std::vector<MetricHistograms*> live;
+            MetricHistograms retired;   // counts of threads that have exited
+            
+            std::mutex dumpMutex;
+            std::condition_variable dumpWake;
+            std::thread dumpThread;
+            bool dumpRunning = false;
+        };
+        
+        // Leaked on purpose: threads may still retire histograms during static
+        // destruction
+        Registry& registry() {
+            static Registry* instance = new Registry();
+            return *instance;
+        }
+        
+        // Hot-path pointer is trivially destructible, so reading it costs one TLS load;
+        // the owner below only runs at registration and thread exit
+        thread_local MetricHistograms* currentHistograms = nullptr;
+        
+        struct ThreadHistogramsOwner {
+            std::unique_ptr<MetricHistograms> histograms;
+            
+            ~ThreadHistogramsOwner() {
+                if (!histograms) return;
+                Registry& reg = registry();
+                std::lock_guard lock(reg.mutex);
+                for (size_t i = 0; i < LATENCY_METRIC_COUNT; ++i) {
+                    (*histograms)[i].mergeInto(reg.retired[i]);
+                }
+                reg.live.erase(std::remove(reg.live.begin(), reg.live.end(), histograms.get()),
+                               reg.live.end());
+                currentHistograms = nullptr;
+            }
+        };
+        
+        thread_local ThreadHistogramsOwner threadOwner;
+        
+        MetricHistograms* registerThread() {
+            threadOwner.histograms = std::make_unique<MetricHistograms>();
+            Registry& reg = registry();
+            std::lock_guard lock(reg.mutex);
+            reg.live.push_back(threadOwner.histograms.get());
+            currentHistograms = threadOwner.histograms.get();
+            return currentHistograms;
+        }
+        
+        void mergeAllThreads(LatencyMetric metric, LatencyHistogram& merged) {
+            Registry& reg = registry();
+            size_t index = static_cast<size_t>(metric);
+            std::lock_guard lock(reg.mutex);
+            reg.retired[index].mergeInto(merged);
+            for (auto* histograms : reg.live) (*histograms)[index].mergeInto(merged);
+        }
+        
+    } // namespace
+    
+    void LatencyMetrics::record(LatencyMetric metric, CycleCount cycles) {
+        MetricHistograms* histograms = currentHistograms;
+        if (!histograms) histograms = registerThread();
+        (*histograms)[static_cast<size_t>(metric)].record(cycles);
+    }
+    
+    LatencySnapshot LatencyMetrics::snapshot(LatencyMetric metric) {
+        LatencyHistogram merged;
+        mergeAllThreads(metric, merged);
+        double nsPerCycle = 1e9 / cycleCounterFrequency();
+        
+        LatencySnapshot snapshot;
+        snapshot.count = merged.getCount();
+        snapshot.p50Ns = static_cast<double>(merged.valueAtQuantile(0.50)) * nsPerCycle;
+        snapshot.p99Ns = static_cast<double>(merged.valueAtQuantile(0.99)) * nsPerCycle;
+        snapshot.p999Ns = static_cast<double>(merged.valueAtQuantile(0.999)) * nsPerCycle;
+        snapshot.maxNs = static_cast<double>(merged.getMax()) * nsPerCycle;
+        return snapshot;
+    }
+    
+    // Clears in place; a sample racing with the clear may survive it
+    void LatencyMetrics::reset() {
+        Registry& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        for (auto& histogram : reg.retired) histogram.clear();
+        for (auto* histograms : reg.live) {
+            for (auto& histogram : *histograms) histogram.clear();
+        }
+    }
+    
+    void LatencyMetrics::dump(std::ostream& out) {
+        for (size_t i = 0; i < LATENCY_METRIC_COUNT; ++i) {
+            auto metric = static_cast<LatencyMetric>(i);
+            LatencySnapshot s = snapshot(metric);
+            if (s.count == 0) continue;
+            out << "latency metric=" << toString(metric)
+                << " count=" << s.count
+                << std::fixed << std::setprecision(0)
+                << " p50_ns=" << s.p50Ns
+                << " p99_ns=" << s.p99Ns
+                << " p999_ns=" << s.p999Ns
+                << " max_ns=" << s.maxNs
+                << std::defaultfloat << "\n";
+        }
+        out.flush();
+    }
+    
+    void LatencyMetrics::startPeriodicDump(std::chrono::milliseconds interval, std::ostream& out) {
+        stopPeriodicDump();
+        
+        Registry& reg = registry();
+        std::lock_guard lock(reg.dumpMutex);
+        reg.dumpRunning = true;
+        reg.dumpThread = std::thread([&reg, interval, &out] {
+            std::unique_lock dumpLock(reg.dumpMutex);
+            while (!reg.dumpWake.wait_for(dumpLock, interval, [&reg] { return !reg.dumpRunning; })) {
+                dump(out);
+            }
+        });
+    }
+    
+    void LatencyMetrics::stopPeriodicDump() {
+        Registry& reg = registry();
+        std::thread dumpThread;
+        {
+            std::lock_guard lock(reg.dumpMutex);
+            reg.dumpRunning = false;
+            dumpThread.swap(reg.dumpThread);
+        }
+        reg.dumpWake.notify_all();
+        if (dumpThread.joinable()) dumpThread.join();
+    }
+
+} // namespace TradingSystem
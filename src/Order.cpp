@@ -8,8 +8,8 @@ namespace TradingSystem {
               OrderTimeInForce timeInForce)
         : orderId_(orderId), userId_(userId), orderType_(orderType),
           symbol_(symbol), quantity_(quantity), price_(price),
-          timestamp_(getCurrentTimestamp()), status_(OrderStatus::PENDING),
-          timeInForce_(timeInForce), filledQuantity_(0) {}
+          entryTicks_(0), clock_(&RealTimeClock::instance()), status_(OrderStatus::PENDING),
+          timeInForce_(timeInForce), filledQuantity_(0), expireTime_() {}
     
     // GETTER METHODS
     const OrderId& Order::getOrderId() const { return orderId_; }
@@ -18,11 +18,17 @@ namespace TradingSystem {
     const Symbol& Order::getSymbol() const { return symbol_; }
     Quantity Order::getQuantity() const { return quantity_; }
     Price Order::getPrice() const { return price_; }
-    const Timestamp& Order::getTimestamp() const { return timestamp_; }
+    Timestamp Order::getTimestamp() const { return clock_->toTimestamp(entryTicks_); }
+    CycleCount Order::getEntryTicks() const { return entryTicks_; }
+    const Clock& Order::getClock() const { return *clock_; }
     OrderStatus Order::getStatus() const { return status_; }
     OrderTimeInForce Order::getTimeInForce() const { return timeInForce_; }
+    const Timestamp& Order::getExpireTime() const { return expireTime_; }
     Quantity Order::getFilledQuantity() const { return filledQuantity_; }
     Quantity Order::getRemainingQuantity() const { return quantity_ - filledQuantity_; }
+    Quantity Order::getDisplayedQuantity() const { return getRemainingQuantity(); }
+    bool Order::needsReplenish() const { return false; }
+    Quantity Order::replenish() { return 0; }
     
     // SETTER METHODS WITH VALIDATION
     bool Order::setQuantity(Quantity newQuantity) {
@@ -44,6 +50,19 @@ namespace TradingSystem {
         return true;
     }
     
+    bool Order::setTimeInForce(OrderTimeInForce timeInForce, Timestamp expireTime) {
+        if (status_ != OrderStatus::PENDING) return false;
+        if (timeInForce == OrderTimeInForce::GTD && expireTime <= clock_->currentTimestamp()) return false;
+        timeInForce_ = timeInForce;
+        expireTime_ = expireTime;
+        return true;
+    }
+    
+    void Order::stampEntry(const Clock& clock) {
+        clock_ = &clock;
+        entryTicks_ = clock.now();
+    }
+    
     // ORDER OPERATIONS
     bool Order::canModify() const {
         return status_ == OrderStatus::PENDING || status_ == OrderStatus::ACCEPTED;
@@ -71,6 +90,10 @@ namespace TradingSystem {
                quantity_ > 0 && quantity_ <= MAX_ORDER_QUANTITY &&
                price_ >= MIN_ORDER_PRICE && price_ <= MAX_ORDER_PRICE;
     }
+    
+    bool Order::isMarketOrder() const { return false; }
+    bool Order::isStopOrder() const { return false; }
+    bool Order::isPeggedOrder() const { return false; }
 
     // LimitOrder implementation
     LimitOrder::LimitOrder(const OrderId& orderId, const UserId& userId, OrderType orderType,
@@ -80,6 +103,45 @@ namespace TradingSystem {
     std::unique_ptr<Order> LimitOrder::clone() const {
         return std::make_unique<LimitOrder>(*this);
     }
+    
+    // IcebergOrder implementation
+    IcebergOrder::IcebergOrder(const OrderId& orderId, const UserId& userId, OrderType orderType,
+                 const Symbol& symbol, Quantity quantity, Price price, Quantity peakQuantity)
+        : LimitOrder(orderId, userId, orderType, symbol, quantity, price),
+          peakQuantity_(peakQuantity), tipRemaining_(std::min(peakQuantity, quantity)) {}
+        
+    std::unique_ptr<Order> IcebergOrder::clone() const {
+        return std::make_unique<IcebergOrder>(*this);
+    }
+    
+    Quantity IcebergOrder::getPeakQuantity() const { return peakQuantity_; }
+    Quantity IcebergOrder::getDisplayedQuantity() const { return tipRemaining_; }
+    
+    bool IcebergOrder::needsReplenish() const {
+        return tipRemaining_ == 0 && getRemainingQuantity() > 0;
+    }
+    
+    Quantity IcebergOrder::replenish() {
+        tipRemaining_ = std::min(peakQuantity_, getRemainingQuantity());
+        entryTicks_ = clock_->now();
+        return tipRemaining_;
+    }
+    
+    bool IcebergOrder::setQuantity(Quantity newQuantity) {
+        if (!Order::setQuantity(newQuantity)) return false;
+        tipRemaining_ = std::min(peakQuantity_, getRemainingQuantity());
+        return true;
+    }
+    
+    void IcebergOrder::fill(Quantity fillQuantity) {
+        assert(fillQuantity <= tipRemaining_);   // only the displayed tip can trade
+        Order::fill(fillQuantity);
+        tipRemaining_ -= fillQuantity;
+    }
+    
+    bool IcebergOrder::isValid() const {
+        return LimitOrder::isValid() && peakQuantity_ > 0 && peakQuantity_ <= quantity_;
+    }
 
     // MarketOrder implementation
     MarketOrder::MarketOrder(const OrderId& orderId, const UserId& userId, OrderType orderType,
@@ -99,22 +161,130 @@ namespace TradingSystem {
     bool MarketOrder::setPrice(Price newPrice) {
         return false; // Market orders cannot change price
     }
+    
+    bool MarketOrder::isMarketOrder() const { return true; }
+
+    // StopOrder implementation
+    StopOrder::StopOrder(const OrderId& orderId, const UserId& userId, OrderType orderType,
+                const Symbol& symbol, Quantity quantity, Price stopPrice)
+        : StopOrder(orderId, userId, orderType, symbol, quantity, stopPrice, 0.0) {}
+    
+    StopOrder::StopOrder(const OrderId& orderId, const UserId& userId, OrderType orderType,
+                const Symbol& symbol, Quantity quantity, Price stopPrice, Price limitPrice)
+        : Order(orderId, userId, orderType, symbol, quantity, limitPrice),
+          stopPrice_(stopPrice), triggered_(false) {}
+    
+    std::unique_ptr<Order> StopOrder::clone() const {
+        return std::make_unique<StopOrder>(*this);
+    }
+    
+    Price StopOrder::getStopPrice() const { return stopPrice_; }
+    bool StopOrder::isTriggered() const { return triggered_; }
+    
+    bool StopOrder::isTriggeredBy(Price lastTradePrice) const {
+        if (lastTradePrice <= 0.0) return false;
+        return orderType_ == OrderType::BUY ? lastTradePrice >= stopPrice_
+                                            : lastTradePrice <= stopPrice_;
+    }
+    
+    void StopOrder::trigger() {
+        triggered_ = true;
+        entryTicks_ = clock_->now();
+    }
+    
+    bool StopOrder::isValid() const {
+        return !orderId_.empty() && !userId_.empty() && !symbol_.empty() &&
+               quantity_ > 0 && quantity_ <= MAX_ORDER_QUANTITY &&
+               stopPrice_ >= MIN_ORDER_PRICE && stopPrice_ <= MAX_ORDER_PRICE &&
+               price_ >= 0;
+    }
+    
+    bool StopOrder::setPrice(Price newPrice) {
+        (void)newPrice;
+        return false; // Triggers into a market order, there is no limit to change
+    }
+    
+    bool StopOrder::canModify() const {
+        // Untriggered stops live in the trigger index, not the price ladder
+        return triggered_ && Order::canModify();
+    }
+    
+    bool StopOrder::isMarketOrder() const { return true; }
+    bool StopOrder::isStopOrder() const { return true; }
 
+    // StopLimitOrder implementation
+    StopLimitOrder::StopLimitOrder(const OrderId& orderId, const UserId& userId, OrderType orderType,
+                const Symbol& symbol, Quantity quantity, Price stopPrice, Price limitPrice)
+        : StopOrder(orderId, userId, orderType, symbol, quantity, stopPrice, limitPrice) {}
+    
+    std::unique_ptr<Order> StopLimitOrder::clone() const {
+        return std::make_unique<StopLimitOrder>(*this);
+    }
+    
+    bool StopLimitOrder::isValid() const {
+        return StopOrder::isValid() &&
+               price_ >= MIN_ORDER_PRICE && price_ <= MAX_ORDER_PRICE;
+    }
+    
+    bool StopLimitOrder::setPrice(Price newPrice) {
+        return Order::setPrice(newPrice);
+    }
+    
+    bool StopLimitOrder::isMarketOrder() const { return false; }
+
+    // PeggedOrder implementation
+    PeggedOrder::PeggedOrder(const OrderId& orderId, const UserId& userId, OrderType orderType,
+                const Symbol& symbol, Quantity quantity, PegType pegType, Price offset)
+        : Order(orderId, userId, orderType, symbol, quantity, 0.0),
+          pegType_(pegType), offset_(offset) {}
+        
+    std::unique_ptr<Order> PeggedOrder::clone() const {
+        return std::make_unique<PeggedOrder>(*this);
+    }
+    
+    PegType PeggedOrder::getPegType() const { return pegType_; }
+    Price PeggedOrder::getOffset() const { return offset_; }
+    
+    void PeggedOrder::reprice(Price effectivePrice) {
+        price_ = effectivePrice;
+    }
+    
+    bool PeggedOrder::isValid() const {
+        return !orderId_.empty() && !userId_.empty() && !symbol_.empty() &&
+               quantity_ > 0 && quantity_ <= MAX_ORDER_QUANTITY &&
+               std::abs(offset_) <= MAX_ORDER_PRICE && price_ >= 0;
+    }
+    
+    // The price follows the reference and only the offset defines it, so the one
+    // price a modify may carry is 0, which keeps the peg
+    bool PeggedOrder::setPrice(Price newPrice) {
+        return newPrice == 0.0 && canModify();
+    }
+    
+    bool PeggedOrder::isPeggedOrder() const { return true; }
+    
     // Order comparators implementation
     bool BuyOrderComparator::operator()(const std::shared_ptr<Order>& lhs, 
                        const std::shared_ptr<Order>& rhs) const {
+        // Market orders have no limit and always rank ahead of limit orders
+        if (lhs->isMarketOrder() != rhs->isMarketOrder()) {
+            return lhs->isMarketOrder();
+        }
         if (std::abs(lhs->getPrice() - rhs->getPrice()) > 1e-9) {
             return lhs->getPrice() > rhs->getPrice();
         }
-        return lhs->getTimestamp() < rhs->getTimestamp();
+        return lhs->getEntryTicks() < rhs->getEntryTicks();
     }
 
     bool SellOrderComparator::operator()(const std::shared_ptr<Order>& lhs, 
                        const std::shared_ptr<Order>& rhs) const {
+        if (lhs->isMarketOrder() != rhs->isMarketOrder()) {
+            return lhs->isMarketOrder();
+        }
         if (std::abs(lhs->getPrice() - rhs->getPrice()) > 1e-9) {
             return lhs->getPrice() < rhs->getPrice();
         }
-        return lhs->getTimestamp() < rhs->getTimestamp();
+        return lhs->getEntryTicks() < rhs->getEntryTicks();
     }
 
 } // namespace TradingSystem
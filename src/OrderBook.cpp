@@ -1,33 +1,231 @@
 #include "../include/OrderBook.h"
+#include "../include/LatencyHistogram.h"
+#include <algorithm>
+#include <limits>
 
 namespace TradingSystem {
 
-    OrderBook::OrderBook(const Symbol& symbol) : symbol_(symbol) {}
+    namespace {
+        // The algorithm a book reports; fixed allocation policies cannot change it
+        template <typename Allocation>
+        constexpr MatchingAlgorithm initialAlgorithm() {
+            if constexpr (std::is_same_v<Allocation, ProRataAllocation>) {
+                return MatchingAlgorithm::PRO_RATA;
+            } else if constexpr (std::is_same_v<Allocation, FifoProRataAllocation>) {
+                return MatchingAlgorithm::FIFO_PRO_RATA;
+            } else {
+                return MatchingAlgorithm::FIFO;
+            }
+        }
+    }
+    
+    template <typename Policies>
+    BasicOrderBook<Policies>::BasicOrderBook(const Symbol& symbol, const Clock& clock,
+                                             IdGenerator& idGenerator)
+        : symbol_(symbol), clock_(clock), idGenerator_(idGenerator), lastTradePrice_(0.0),
+          expiryWheel_(TimerWheel::toTick(clock.currentTimestamp())),
+          phase_(TradingPhase::CONTINUOUS), indicativeDirty_(false),
+          batchInterval_(0), lastBatchCycles_(0), batchSequence_(0),
+          matchingAlgorithm_(initialAlgorithm<Allocation>()) {}
+    
+    // Market buys sort above every bid and market sells below every ask;
+    // pegged orders are keyed by their offset inside their own ladder
+    template <typename Policies>
+    auto BasicOrderBook<Policies>::levelKey(const Order& order) -> Key {
+        if constexpr (Features::pegs) {
+            if (order.isPeggedOrder()) {
+                return PriceRep::toKey(static_cast<const PeggedOrder&>(order).getOffset());
+            }
+        }
+        if (!order.isMarketOrder()) return PriceRep::toKey(order.getPrice());
+        return order.getOrderType() == OrderType::BUY ? PriceRep::marketBuyKey()
+                                                      : PriceRep::marketSellKey();
+    }
+    
+    template <typename Policies>
+    auto BasicOrderBook<Policies>::bidLadderFor(const Order& order) -> BidLevels& {
+        if constexpr (Features::pegs) {
+            if (order.isPeggedOrder()) {
+                return static_cast<const PeggedOrder&>(order).getPegType() == PegType::PRIMARY
+                    ? bidPrimaryPegs_ : bidMidpointPegs_;
+            }
+        }
+        return bidLevels_;
+    }
+    
+    template <typename Policies>
+    auto BasicOrderBook<Policies>::askLadderFor(const Order& order) -> AskLevels& {
+        if constexpr (Features::pegs) {
+            if (order.isPeggedOrder()) {
+                return static_cast<const PeggedOrder&>(order).getPegType() == PegType::PRIMARY
+                    ? askPrimaryPegs_ : askMidpointPegs_;
+            }
+        }
+        return askLevels_;
+    }
     
-    bool OrderBook::addOrder(std::shared_ptr<Order> order) {
-        if (!order || order->getSymbol() != symbol_ || !order->isValid()) {
+    template <typename Policies>
+    bool BasicOrderBook<Policies>::isParkedStop(const Order& order) {
+        if constexpr (!Features::stops) return false;
+        return order.isStopOrder() && !static_cast<const StopOrder&>(order).isTriggered();
+    }
+    
+    // Orders needing a feature this book was built without never reach the book
+    template <typename Policies>
+    bool BasicOrderBook<Policies>::isSupported(const Order& order) {
+        if (!Features::pegs && order.isPeggedOrder()) return false;
+        if (!Features::stops && order.isStopOrder()) return false;
+        if (!Features::expiry && (order.getTimeInForce() == OrderTimeInForce::GTD ||
+                                  order.getTimeInForce() == OrderTimeInForce::DAY)) {
             return false;
         }
+        return true;
+    }
+    
+    // Best price among limit levels; resting market orders carry no price
+    template <typename Policies>
+    template <typename Levels>
+    Price BasicOrderBook<Policies>::bestLimitPrice(const Levels& levels) {
+        for (const auto& [key, level] : levels) {
+            if (!level.orders.front()->isMarketOrder()) return PriceRep::toPrice(key);
+        }
+        return 0.0;
+    }
+    
+    template <typename Policies>
+    void BasicOrderBook<Policies>::insertResting(OrderEntry& entry) {
+        const auto& order = entry.order;
+        PriceLevel& level = order->getOrderType() == OrderType::BUY
+            ? bidLadderFor(*order)[levelKey(*order)] : askLadderFor(*order)[levelKey(*order)];
+            
+        entry.position = level.orders.insert(level.orders.end(), order);
+        entry.resting = true;
+        level.displayedQuantity += order->getDisplayedQuantity();
+    }
+    
+    template <typename Policies>
+    void BasicOrderBook<Policies>::removeResting(OrderEntry& entry) {
+        const auto& order = entry.order;
+        Key key = levelKey(*order);
+        
+        if (order->getOrderType() == OrderType::BUY) {
+            BidLevels& ladder = bidLadderFor(*order);
+            auto levelIt = ladder.find(key);
+            levelIt->second.displayedQuantity -= order->getDisplayedQuantity();
+            levelIt->second.orders.erase(entry.position);
+            if (levelIt->second.orders.empty()) ladder.erase(levelIt);
+        } else {
+            AskLevels& ladder = askLadderFor(*order);
+            auto levelIt = ladder.find(key);
+            levelIt->second.displayedQuantity -= order->getDisplayedQuantity();
+            levelIt->second.orders.erase(entry.position);
+            if (levelIt->second.orders.empty()) ladder.erase(levelIt);
+        }
+        entry.resting = false;
+    }
+    
+    template <typename Policies>
+    bool BasicOrderBook<Policies>::addOrder(std::shared_ptr<Order> order) {
+        if (!order || order->getSymbol() != symbol_ || !order->isValid() || !isSupported(*order)) {
+            return false;
+        }
+        
+        // Batch mode: only the batch buffer's own mutex is taken on entry
+        if constexpr (Features::batchAuctions) {
+            if (batchInterval_.load(std::memory_order_relaxed) != 0) {
+                return bufferOrder(std::move(order));
+            }
+        }
         
         std::unique_lock lock(mutex_);
+        return insertOrder(order);
+    }
+    
+    template <typename Policies>
+    size_t BasicOrderBook<Policies>::addOrders(std::shared_ptr<Order>* orders, size_t count,
+                                               std::vector<std::shared_ptr<Trade>>& trades,
+                                               size_t* tradeEnds) {
+        size_t accepted = 0;
+        auto admit = [this](const std::shared_ptr<Order>& order) {
+            return order && order->getSymbol() == symbol_ && order->isValid() && isSupported(*order);
+        };
+        
+        // Batch mode: buffer them all, then one uncross check for the run
+        if constexpr (Features::batchAuctions) {
+            if (batchInterval_.load(std::memory_order_relaxed) != 0) {
+                for (size_t i = 0; i < count; ++i) {
+                    if (admit(orders[i]) && bufferOrder(orders[i])) ++accepted;
+                    else orders[i].reset();
+                    tradeEnds[i] = trades.size();
+                }
+                uncrossBatch(false, trades);
+                if (count > 0) tradeEnds[count - 1] = trades.size();
+                return accepted;
+            }
+        }
         
+        std::unique_lock lock(mutex_);
+        for (size_t i = 0; i < count; ++i) {
+            if (admit(orders[i]) && insertOrder(orders[i])) {
+                ++accepted;
+                if (phase_ != TradingPhase::CALL_AUCTION) matchContinuous(trades);
+            } else {
+                orders[i].reset();
+            }
+            tradeEnds[i] = trades.size();
+        }
+        return accepted;
+    }
+    
+    // Registers and places an order; caller holds the book lock
+    template <typename Policies>
+    bool BasicOrderBook<Policies>::insertOrder(const std::shared_ptr<Order>& order) {
         if (orderLookup_.find(order->getOrderId()) != orderLookup_.end()) {
             return false;
         }
         
         order->setStatus(OrderStatus::ACCEPTED);
+        order->stampEntry(clock_);
         
-        if (order->getOrderType() == OrderType::BUY) {
-            buyOrders_.insert(order);
-        } else {
-            sellOrders_.insert(order);
+        OrderEntry& entry = orderLookup_[order->getOrderId()];
+        entry.order = order;
+        
+        bool parked = false;
+        if constexpr (Features::stops) {
+            if (isParkedStop(*order)) {
+                Price stopPrice = static_cast<StopOrder&>(*order).getStopPrice();
+                if (order->getOrderType() == OrderType::BUY) {
+                    buyStops_.emplace(stopPrice, order);
+                } else {
+                    sellStops_.emplace(stopPrice, order);
+                }
+                parked = true;
+            }
+        }
+        if (!parked) {
+            insertResting(entry);
+            refreshPegReferences();
+            noteAuctionChange(*order);
+        }
+        
+        if constexpr (Features::expiry) {
+            if (order->getTimeInForce() == OrderTimeInForce::GTD) {
+                expiryWheel_.schedule(TimerWheel::toTick(order->getExpireTime()),
+                                      TimerWheel::toTick(clock_.currentTimestamp()), order);
+            } else if (order->getTimeInForce() == OrderTimeInForce::DAY) {
+                dayOrders_.push_back(order);
+            }
         }
         
-        orderLookup_[order->getOrderId()] = order;
         return true;
     }
     
-    bool OrderBook::cancelOrder(const OrderId& orderId) {
+    template <typename Policies>
+    bool BasicOrderBook<Policies>::cancelOrder(const OrderId& orderId) {
+        if (cancelBufferedOrder(orderId)) {
+            return true;
+        }
+        
         std::unique_lock lock(mutex_);
         
         auto it = orderLookup_.find(orderId);
@@ -35,39 +233,31 @@ namespace TradingSystem {
             return false;
         }
         
-        auto order = it->second;
-        if (!order->canCancel()) {
+        OrderEntry& entry = it->second;
+        if (!entry.order->canCancel()) {
             return false;
         }
         
         bool removed = false;
-        if (order->getOrderType() == OrderType::BUY) {
-            for (auto iter = buyOrders_.begin(); iter != buyOrders_.end(); ++iter) {
-                if ((*iter)->getOrderId() == orderId) {
-                    buyOrders_.erase(iter);
-                    removed = true;
-                    break;
-                }
-            }
-        } else {
-            for (auto iter = sellOrders_.begin(); iter != sellOrders_.end(); ++iter) {
-                if ((*iter)->getOrderId() == orderId) {
-                    sellOrders_.erase(iter);
-                    removed = true;
-                    break;
-                }
-            }
+        if (isParkedStop(*entry.order)) {
+            removed = removeStopOrder(entry.order);
+        } else if (entry.resting) {
+            noteAuctionChange(*entry.order);
+            removeResting(entry);
+            refreshPegReferences();
+            removed = true;
         }
         
         if (removed) {
-            order->setStatus(OrderStatus::CANCELLED);
+            entry.order->setStatus(OrderStatus::CANCELLED);
             return true;
         }
         
         return false;
     }
     
-    bool OrderBook::modifyOrder(const OrderId& orderId, Quantity newQuantity, Price newPrice) {
+    template <typename Policies>
+    bool BasicOrderBook<Policies>::modifyOrder(const OrderId& orderId, Quantity newQuantity, Price newPrice) {
         // First, find the order and validate without holding the lock for too long
         std::shared_ptr<Order> existingOrder;
         {
@@ -76,7 +266,18 @@ namespace TradingSystem {
             if (it == orderLookup_.end()) {
                 return false;
             }
-            existingOrder = it->second;
+            existingOrder = it->second.order;
+            
+            // A peg modified at the price it currently shows keeps its peg
+            if constexpr (Features::pegs) {
+                if (existingOrder->isPeggedOrder() && newPrice > 0.0) {
+                    Price reference = pegReference(*existingOrder);
+                    Price offset = static_cast<const PeggedOrder&>(*existingOrder).getOffset();
+                    if (reference > 0.0 && PriceRep::toKey(reference + offset) == PriceRep::toKey(newPrice)) {
+                        newPrice = 0.0;
+                    }
+                }
+            }
         }
         
         // Validate outside the lock
@@ -95,121 +296,1019 @@ namespace TradingSystem {
         
         // Re-verify existence under lock
         auto it = orderLookup_.find(orderId);
-        if (it == orderLookup_.end() || !it->second->canModify()) {
+        if (it == orderLookup_.end() || it->second.order != existingOrder ||
+            !existingOrder->canModify() || !it->second.resting) {
             return false;
         }
         
-        // Remove old order
-        auto order = it->second;
-        bool removed = false;
-        if (order->getOrderType() == OrderType::BUY) {
-            for (auto iter = buyOrders_.begin(); iter != buyOrders_.end(); ++iter) {
-                if ((*iter)->getOrderId() == orderId) {
-                    buyOrders_.erase(iter);
-                    removed = true;
-                    break;
+        // Replace the old order; the modified one joins the back of its level
+        OrderEntry& entry = it->second;
+        noteAuctionChange(*entry.order);
+        removeResting(entry);
+        
+        entry.order = std::shared_ptr<Order>(modifiedOrder.release());
+        entry.order->setStatus(OrderStatus::ACCEPTED);
+        entry.order->stampEntry(clock_);
+        insertResting(entry);
+        refreshPegReferences();
+        noteAuctionChange(*entry.order);
+        
+        return true;
+    }
+    
+    // Removes a live order without taking the lock; stale timers simply find nothing
+    template <typename Policies>
+    bool BasicOrderBook<Policies>::expireOrder(const OrderId& orderId) {
+        auto it = orderLookup_.find(orderId);
+        if (it == orderLookup_.end() || !it->second.order->canCancel()) {
+            return false;
+        }
+        
+        OrderEntry& entry = it->second;
+        if (isParkedStop(*entry.order)) {
+            removeStopOrder(entry.order);
+        } else if (entry.resting) {
+            removeResting(entry);
+        } else {
+            return false;
+        }
+        
+        entry.order->setStatus(OrderStatus::EXPIRED);
+        return true;
+    }
+    
+    template <typename Policies>
+    std::vector<std::shared_ptr<Order>> BasicOrderBook<Policies>::expireOrders(const Timestamp& now) {
+        std::vector<std::shared_ptr<Order>> due;
+        std::vector<std::shared_ptr<Order>> expired;
+        if constexpr (!Features::expiry) {
+            return expired;
+        } else {
+            std::unique_lock lock(mutex_);
+            expiryWheel_.advance(TimerWheel::toTick(now), due);
+            
+            for (const auto& order : due) {
+                // Modify replaces the object, so fire on the id and report the live order
+                if (expireOrder(order->getOrderId())) {
+                    expired.push_back(orderLookup_[order->getOrderId()].order);
                 }
             }
+            
+            if (!expired.empty()) refreshPegReferences();
+            return expired;
+        }
+    }
+    
+    template <typename Policies>
+    std::vector<std::shared_ptr<Order>> BasicOrderBook<Policies>::endSession() {
+        std::vector<std::shared_ptr<Order>> expired;
+        if constexpr (!Features::expiry) {
+            return expired;
         } else {
-            for (auto iter = sellOrders_.begin(); iter != sellOrders_.end(); ++iter) {
-                if ((*iter)->getOrderId() == orderId) {
-                    sellOrders_.erase(iter);
-                    removed = true;
-                    break;
+            std::unique_lock lock(mutex_);
+            std::vector<std::shared_ptr<Order>> session;
+            session.swap(dayOrders_);
+            
+            for (const auto& order : session) {
+                if (expireOrder(order->getOrderId())) {
+                    expired.push_back(orderLookup_[order->getOrderId()].order);
                 }
             }
+            
+            if (!expired.empty()) refreshPegReferences();
+            return expired;
+        }
+    }
+    
+    template <typename Policies>
+    size_t BasicOrderBook<Policies>::getScheduledExpiryCount() const {
+        if constexpr (!Features::expiry) {
+            return 0;
+        } else {
+            std::shared_lock lock(mutex_);
+            return expiryWheel_.size() + dayOrders_.size();
+        }
+    }
+    
+    // CALL AUCTION
+    template <typename Policies>
+    void BasicOrderBook<Policies>::beginCallAuction() {
+        std::unique_lock lock(mutex_);
+        phase_ = TradingPhase::CALL_AUCTION;
+        indicativeDirty_ = true;
+    }
+    
+    template <typename Policies>
+    TradingPhase BasicOrderBook<Policies>::getTradingPhase() const {
+        std::shared_lock lock(mutex_);
+        return phase_;
+    }
+    
+    // An order only moves the equilibrium if it can trade: a market order, a bid at
+    // or above the lowest offer, or an offer at or below the highest bid
+    template <typename Policies>
+    void BasicOrderBook<Policies>::noteAuctionChange(const Order& order) {
+        if (phase_ != TradingPhase::CALL_AUCTION || indicativeDirty_) return;
+        if (order.isMarketOrder() || order.isPeggedOrder()) {
+            indicativeDirty_ = true;
+            return;
         }
         
-        if (!removed) {
-            return false;
+        if (order.getOrderType() == OrderType::BUY) {
+            if (!askLevels_.empty() && levelKey(order) >= askLevels_.begin()->first) {
+                indicativeDirty_ = true;
+            }
+        } else if (!bidLevels_.empty() && levelKey(order) <= bidLevels_.begin()->first) {
+            indicativeDirty_ = true;
         }
+    }
+    
+    template <typename Policies>
+    AuctionIndicative BasicOrderBook<Policies>::getIndicativeAuction() {
+        std::unique_lock lock(mutex_);
+        if (indicativeDirty_) {
+            indicative_ = computeEquilibrium();
+            indicativeDirty_ = false;
+        }
+        return indicative_;
+    }
+    
+    // EQUILIBRIUM PRICE - ONE ASCENDING MERGE OVER BOTH CURVES.
+    // At each candidate price p: bid volume = bids at >= p, ask volume = asks at <= p.
+    // Maximise executable volume, then minimise imbalance, then follow the surplus
+    // side or stay closest to the last trade price. Pegs join the curves at the
+    // price they would be materialized at now
+    template <typename Policies>
+    AuctionIndicative BasicOrderBook<Policies>::computeEquilibrium() const {
+        AuctionIndicative best;
         
-        // Add modified order
-        auto sharedModifiedOrder = std::shared_ptr<Order>(modifiedOrder.release());
-        sharedModifiedOrder->setStatus(OrderStatus::ACCEPTED);
-        if (sharedModifiedOrder->getOrderType() == OrderType::BUY) {
-            buyOrders_.insert(sharedModifiedOrder);
-        } else {
-            sellOrders_.insert(sharedModifiedOrder);
+        // Each ladder is already sorted, so a peg ladder is one more ascending run
+        // merged into the regular curve; market orders count at every price and are
+        // never a candidate
+        auto byKey = [](const CurvePoint& a, const CurvePoint& b) { return a.key < b.key; };
+        auto mergePegs = [&byKey](const auto& pegs, Price reference, std::vector<CurvePoint>& curve) {
+            if (pegs.empty() || reference <= 0.0) return;
+            size_t runStart = curve.size();
+            for (const auto& [offset, level] : pegs) {
+                curve.push_back({PriceRep::toKey(reference + PriceRep::toPrice(offset)),
+                                 level.displayedQuantity});
+            }
+            if (curve[runStart].key > curve.back().key) {
+                std::reverse(curve.begin() + runStart, curve.end());
+            }
+            std::inplace_merge(curve.begin(), curve.begin() + runStart, curve.end(), byKey);
+        };
+        
+        Quantity marketBids = 0;
+        Quantity marketAsks = 0;
+        std::vector<CurvePoint> bids;   // ascending
+        std::vector<CurvePoint> asks;   // ascending
+        for (auto it = bidLevels_.rbegin(); it != bidLevels_.rend(); ++it) {
+            if (it->second.orders.front()->isMarketOrder()) marketBids += it->second.displayedQuantity;
+            else bids.push_back({it->first, it->second.displayedQuantity});
+        }
+        for (const auto& [key, level] : askLevels_) {
+            if (level.orders.front()->isMarketOrder()) marketAsks += level.displayedQuantity;
+            else asks.push_back({key, level.displayedQuantity});
+        }
+        if constexpr (Features::pegs) {
+            mergePegs(bidPrimaryPegs_, pegRefs_.bestBid, bids);
+            mergePegs(bidMidpointPegs_, pegRefs_.midpoint, bids);
+            mergePegs(askPrimaryPegs_, pegRefs_.bestAsk, asks);
+            mergePegs(askMidpointPegs_, pegRefs_.midpoint, asks);
         }
         
-        // Update lookup with new order
-        orderLookup_[orderId] = sharedModifiedOrder;
+        Quantity totalBid = marketBids;
+        for (const auto& point : bids) totalBid += point.quantity;
         
-        return true;
+        Quantity cumAsk = marketAsks;
+        Quantity bidsBelow = 0;
+        auto askIt = asks.begin();
+        auto bidIt = bids.begin();
+        
+        bool found = false;
+        while (askIt != asks.end() || bidIt != bids.end()) {
+            Key key;
+            if (askIt == asks.end()) {
+                key = bidIt->key;
+            } else if (bidIt == bids.end()) {
+                key = askIt->key;
+            } else {
+                key = std::min(askIt->key, bidIt->key);
+            }
+            Price price = PriceRep::toPrice(key);
+            
+            while (askIt != asks.end() && askIt->key == key) {
+                cumAsk += askIt->quantity;
+                ++askIt;
+            }
+            
+            Quantity bidVolume = totalBid - bidsBelow;
+            Quantity volume = std::min(bidVolume, cumAsk);
+            Quantity imbalance = bidVolume - cumAsk;
+            
+            if (volume > 0) {
+                bool better = !found || volume > best.volume ||
+                    (volume == best.volume && std::abs(imbalance) < std::abs(best.imbalance));
+                    
+                // Equal volume and imbalance: a bid surplus pushes the price up (the
+                // walk is ascending), otherwise stay closest to the last trade
+                if (found && volume == best.volume &&
+                    std::abs(imbalance) == std::abs(best.imbalance)) {
+                    if (imbalance > 0) {
+                        better = true;
+                    } else if (imbalance == 0 && lastTradePrice_ > 0.0) {
+                        better = std::abs(price - lastTradePrice_) <
+                                 std::abs(best.price - lastTradePrice_);
+                    }
+                }
+                
+                if (better) {
+                    best = {price, volume, imbalance};
+                    found = true;
+                }
+            }
+            
+            while (bidIt != bids.end() && bidIt->key == key) {
+                bidsBelow += bidIt->quantity;
+                ++bidIt;
+            }
+        }
+        
+        // Only market orders on both sides: they cross at the last trade price
+        if (!found && lastTradePrice_ > 0.0 && totalBid > 0 && cumAsk > 0) {
+            best = {lastTradePrice_, std::min(totalBid, cumAsk), totalBid - cumAsk};
+        }
+        
+        return best;
+    }
+    
+    // Fills `volume` on each side of the merged (regular + pegged) view, best level
+    // first, sharing each level out with the book's allocation rule - the level
+    // that rations the surplus side is split exactly as continuous matching would.
+    // The two fill lists are then paired into trades at the single uncross price.
+    // Peg references stay frozen until every fill is settled, so each peg executes
+    // at the price the equilibrium saw it at
+    template <typename Policies>
+    template <typename LevelAllocator>
+    void BasicOrderBook<Policies>::allocateUncross(const AuctionIndicative& result,
+                                                   std::vector<std::shared_ptr<Trade>>& trades) {
+        Key priceKey = PriceRep::toKey(result.price);
+        
+        struct AuctionFill {
+            std::shared_ptr<Order> order;
+            Quantity quantity;
+        };
+        auto fillSide = [&](auto bestTop, auto executable, std::vector<AuctionFill>& fills) {
+            Quantity remaining = result.volume;
+            while (remaining > 0) {
+                auto top = bestTop();
+                if (!top.levels || !executable(top.key)) break;
+                
+                PriceLevel& level = top.level->second;
+                Quantity incoming = std::min(remaining, level.displayedQuantity);
+                allocations_.clear();
+                LevelAllocator::allocate(level.orders, level.displayedQuantity, incoming, allocations_);
+                
+                for (const auto& allocation : allocations_) {
+                    if (allocation.quantity == 0) continue;
+                    const auto& order = *allocation.position;
+                    if constexpr (Features::pegs) {
+                        if (order->isPeggedOrder()) static_cast<PeggedOrder&>(*order).reprice(top.price);
+                    }
+                    fills.push_back({order, allocation.quantity});
+                    remaining -= allocation.quantity;
+                }
+                // The level can only empty on its last allocation (see matchActiveOrders)
+                for (const auto& allocation : allocations_) {
+                    if (allocation.quantity == 0) continue;
+                    settleFill(*top.levels, top.level, allocation.position, allocation.quantity);
+                }
+            }
+        };
+        
+        std::vector<AuctionFill> buys;
+        std::vector<AuctionFill> sells;
+        fillSide([this] { return bestBidTop(); }, [priceKey](Key key) { return key >= priceKey; }, buys);
+        fillSide([this] { return bestAskTop(); }, [priceKey](Key key) { return key <= priceKey; }, sells);
+        
+        size_t b = 0;
+        size_t s = 0;
+        while (b < buys.size() && s < sells.size()) {
+            Quantity tradeQuantity = std::min(buys[b].quantity, sells[s].quantity);
+            trades.push_back(std::make_shared<Trade>(
+                idGenerator_.next(), OrderType::BUY,
+                buys[b].order->getOrderId(), sells[s].order->getOrderId(),
+                symbol_, tradeQuantity, result.price, clock_
+            ));
+            buys[b].quantity -= tradeQuantity;
+            sells[s].quantity -= tradeQuantity;
+            if (buys[b].quantity == 0) ++b;
+            if (sells[s].quantity == 0) ++s;
+        }
+        
+        lastTradePrice_ = result.price;
+        refreshPegReferences();
+    }
+    
+    // The allocation rule is dispatched once per uncross, as in matchContinuous
+    template <typename Policies>
+    void BasicOrderBook<Policies>::executeUncross(const AuctionIndicative& result,
+                                                  std::vector<std::shared_ptr<Trade>>& trades) {
+        if constexpr (!std::is_same_v<Allocation, SelectableAllocation>) {
+            allocateUncross<Allocation>(result, trades);
+            return;
+        }
+        switch (matchingAlgorithm_) {
+            case MatchingAlgorithm::FIFO:
+                allocateUncross<FifoAllocation>(result, trades);
+                break;
+            case MatchingAlgorithm::PRO_RATA:
+                allocateUncross<ProRataAllocation>(result, trades);
+                break;
+            case MatchingAlgorithm::FIFO_PRO_RATA:
+                allocateUncross<FifoProRataAllocation>(result, trades);
+                break;
+        }
+    }
+    
+    // UNCROSS - ALL AUCTION FILLS IN ONE BATCH AT A SINGLE PRICE, THEN CONTINUOUS
+    // MATCHING RESUMES (PEGS AND TRIGGERED STOPS JOIN FROM HERE)
+    template <typename Policies>
+    std::vector<std::shared_ptr<Trade>> BasicOrderBook<Policies>::uncrossAuction() {
+        std::vector<std::shared_ptr<Trade>> trades;
+        
+        std::unique_lock lock(mutex_);
+        if (phase_ != TradingPhase::CALL_AUCTION) {
+            return trades;
+        }
+        
+        AuctionIndicative result = computeEquilibrium();
+        if (result.volume > 0) {
+            executeUncross(result, trades);
+        }
+        
+        phase_ = TradingPhase::CONTINUOUS;
+        indicative_ = AuctionIndicative();
+        indicativeDirty_ = false;
+        
+        matchContinuous(trades);
+        
+        return trades;
+    }
+    
+    // FREQUENT BATCH AUCTION
+    template <typename Policies>
+    bool BasicOrderBook<Policies>::setBatchInterval(std::chrono::microseconds interval) {
+        if constexpr (!Features::batchAuctions) {
+            return interval.count() == 0;
+        } else {
+            CycleCount cycles = static_cast<CycleCount>(
+                clock_.ticksPerSecond() * std::chrono::duration<double>(interval).count());
+            if (interval.count() > 0) cycles = std::max<CycleCount>(cycles, 1);
+            
+            // The first batch window opens now, not at the clock's origin
+            {
+                std::lock_guard batchLock(batchMutex_);
+                if (batchInterval_.load(std::memory_order_relaxed) == 0) lastBatchCycles_ = clock_.now();
+            }
+            batchInterval_.store(cycles, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    
+    template <typename Policies>
+    bool BasicOrderBook<Policies>::isBatchMode() const {
+        if constexpr (!Features::batchAuctions) {
+            return false;
+        } else {
+            return batchInterval_.load(std::memory_order_relaxed) != 0;
+        }
+    }
+    
+    template <typename Policies>
+    bool BasicOrderBook<Policies>::bufferOrder(std::shared_ptr<Order> order) {
+        if constexpr (!Features::batchAuctions) {
+            return false;
+        } else {
+            std::lock_guard batchLock(batchMutex_);
+            if (!batchLookup_.emplace(order->getOrderId(), order).second) {
+                return false;
+            }
+            pendingBatch_.push_back({std::move(order), clock_.now(), batchSequence_++});
+            return true;
+        }
+    }
+    
+    template <typename Policies>
+    bool BasicOrderBook<Policies>::cancelBufferedOrder(const OrderId& orderId) {
+        if constexpr (!Features::batchAuctions) {
+            return false;
+        } else {
+            std::lock_guard batchLock(batchMutex_);
+            auto it = batchLookup_.find(orderId);
+            if (it == batchLookup_.end()) {
+                return false;
+            }
+            
+            // The buffer slot stays; the uncross skips cancelled orders
+            it->second->setStatus(OrderStatus::CANCELLED);
+            batchLookup_.erase(it);
+            return true;
+        }
+    }
+    
+    // ONE SORT AND ONE UNCROSS FOR THE WHOLE BATCH: the buffer is swapped out, sorted
+    // into ladder order so level inserts stay local, inserted under a single book
+    // lock acquisition, and uncrossed at the equilibrium price. Orders stay in the
+    // batch lookup until each is inserted, so they can still be cancelled meanwhile
+    template <typename Policies>
+    bool BasicOrderBook<Policies>::uncrossBatch(bool force, std::vector<std::shared_ptr<Trade>>& trades) {
+        if constexpr (!Features::batchAuctions) {
+            return false;
+        } else {
+            // Batches must reach the book in the order they were cut
+            std::unique_lock runLock(batchRunMutex_, std::try_to_lock);
+            if (!runLock.owns_lock()) return false;
+            
+            std::vector<PendingOrder> batch;
+            CycleCount now;
+            {
+                std::lock_guard batchLock(batchMutex_);
+                now = clock_.now();
+                CycleCount interval = batchInterval_.load(std::memory_order_relaxed);
+                if (!force && now - lastBatchCycles_ < interval) return false;
+                lastBatchCycles_ = now;
+                batch.swap(pendingBatch_);
+            }
+            
+            std::sort(batch.begin(), batch.end(), [](const PendingOrder& a, const PendingOrder& b) {
+                OrderType sideA = a.order->getOrderType();
+                OrderType sideB = b.order->getOrderType();
+                if (sideA != sideB) return sideA == OrderType::BUY;
+                Key keyA = levelKey(*a.order);
+                Key keyB = levelKey(*b.order);
+                if (keyA != keyB) return sideA == OrderType::BUY ? keyA > keyB : keyA < keyB;
+                return a.sequence < b.sequence;
+            });
+            
+            std::unique_lock lock(mutex_);
+            
+            size_t inserted = 0;
+            double maxLatency = 0.0;
+            double totalLatency = 0.0;
+            double nsPerCycle = 1e9 / clock_.ticksPerSecond();
+            for (const auto& pending : batch) {
+                // An order leaves the batch lookup only once it is in the book's, so a
+                // cancel or getOrder in between always finds it in one of the two
+                std::lock_guard batchLock(batchMutex_);
+                if (pending.order->getStatus() == OrderStatus::CANCELLED) continue;
+                bool placed = insertOrder(pending.order);
+                batchLookup_.erase(pending.order->getOrderId());
+                if (placed) {
+                    double latency = static_cast<double>(now - pending.enqueuedAt) * nsPerCycle;
+                    totalLatency += latency;
+                    maxLatency = std::max(maxLatency, latency);
+                    ++inserted;
+                }
+            }
+            
+            AuctionIndicative result = computeEquilibrium();
+            if (result.volume > 0) {
+                executeUncross(result, trades);
+                releaseTriggeredStops(); // released stops take part in the next batch
+            }
+            
+            batchStats_.batches++;
+            batchStats_.ordersBatched += inserted;
+            batchStats_.totalQueueLatencyNs += totalLatency;
+            batchStats_.maxQueueLatencyNs = std::max(batchStats_.maxQueueLatencyNs, maxLatency);
+            return true;
+        }
+    }
+    
+    template <typename Policies>
+    std::vector<std::shared_ptr<Trade>> BasicOrderBook<Policies>::runBatchAuction(bool force) {
+        std::vector<std::shared_ptr<Trade>> trades;
+        uncrossBatch(force, trades);
+        return trades;
+    }
+    
+    template <typename Policies>
+    BatchAuctionStats BasicOrderBook<Policies>::getBatchAuctionStats() const {
+        if constexpr (!Features::batchAuctions) {
+            return BatchAuctionStats();
+        } else {
+            std::shared_lock lock(mutex_);
+            return batchStats_;
+        }
     }
     
-    std::shared_ptr<Order> OrderBook::getOrder(const OrderId& orderId) const {
+    template <typename Policies>
+    std::shared_ptr<Order> BasicOrderBook<Policies>::getOrder(const OrderId& orderId) const {
+        // The batch buffer first: an uncross adds an order to the book before it takes
+        // it out of the buffer, so this order of lookups cannot miss it in between
+        if constexpr (Features::batchAuctions) {
+            std::lock_guard batchLock(batchMutex_);
+            auto it = batchLookup_.find(orderId);
+            if (it != batchLookup_.end()) return it->second;
+        }
+        
         std::shared_lock lock(mutex_);
         auto it = orderLookup_.find(orderId);
-        return it != orderLookup_.end() ? it->second : nullptr;
+        return it != orderLookup_.end() ? it->second.order : nullptr;
     }
     
-    std::vector<std::shared_ptr<Order>> OrderBook::getBuyOrders() const {
+    template <typename Policies>
+    std::vector<std::shared_ptr<Order>> BasicOrderBook<Policies>::getBuyOrders() const {
         std::shared_lock lock(mutex_);
-        return std::vector<std::shared_ptr<Order>>(buyOrders_.begin(), buyOrders_.end());
+        std::vector<std::shared_ptr<Order>> orders;
+        auto collect = [&orders](const BidLevels& ladder) {
+            for (const auto& [price, level] : ladder) {
+                orders.insert(orders.end(), level.orders.begin(), level.orders.end());
+            }
+        };
+        collect(bidLevels_);
+        if constexpr (Features::pegs) {
+            collect(bidPrimaryPegs_);
+            collect(bidMidpointPegs_);
+        }
+        return orders;
     }
     
-    std::vector<std::shared_ptr<Order>> OrderBook::getSellOrders() const {
+    template <typename Policies>
+    std::vector<std::shared_ptr<Order>> BasicOrderBook<Policies>::getSellOrders() const {
         std::shared_lock lock(mutex_);
-        return std::vector<std::shared_ptr<Order>>(sellOrders_.begin(), sellOrders_.end());
+        std::vector<std::shared_ptr<Order>> orders;
+        auto collect = [&orders](const AskLevels& ladder) {
+            for (const auto& [price, level] : ladder) {
+                orders.insert(orders.end(), level.orders.begin(), level.orders.end());
+            }
+        };
+        collect(askLevels_);
+        if constexpr (Features::pegs) {
+            collect(askPrimaryPegs_);
+            collect(askMidpointPegs_);
+        }
+        return orders;
     }
     
-    // CORE MATCHING ENGINE - PRICE-TIME PRIORITY MATCHING ALGORITHM
-    std::vector<std::shared_ptr<Trade>> OrderBook::matchOrders() {
+    template <typename Policies>
+    size_t BasicOrderBook<Policies>::getPendingStopCount() const {
+        if constexpr (!Features::stops) {
+            return 0;
+        } else {
+            std::shared_lock lock(mutex_);
+            return buyStops_.size() + sellStops_.size();
+        }
+    }
+    
+    template <typename Policies>
+    template <typename Levels>
+    std::vector<DepthLevel> BasicOrderBook<Policies>::collectDepth(const Levels& levels, size_t maxLevels) {
+        std::vector<DepthLevel> depth;
+        for (const auto& [key, level] : levels) {
+            if (depth.size() >= maxLevels) break;
+            if (level.orders.front()->isMarketOrder()) continue;
+            depth.push_back({PriceRep::toPrice(key), level.displayedQuantity, level.orders.size()});
+        }
+        return depth;
+    }
+    
+    // Adds peg levels at their effective price; merged into the regular levels below
+    template <typename Policies>
+    template <typename Levels>
+    void BasicOrderBook<Policies>::collectPegDepth(const Levels& pegs, Price reference,
+                                    std::vector<DepthLevel>& depth) const {
+        if (reference <= 0.0) return;
+        for (const auto& [offset, level] : pegs) {
+            Price price = reference + PriceRep::toPrice(offset);
+            auto it = std::find_if(depth.begin(), depth.end(), [price](const DepthLevel& d) {
+                return std::abs(d.price - price) < 1e-9;
+            });
+            if (it != depth.end()) {
+                it->quantity += level.displayedQuantity;
+                it->orderCount += level.orders.size();
+            } else {
+                depth.push_back({price, level.displayedQuantity, level.orders.size()});
+            }
+        }
+    }
+    
+    template <typename Policies>
+    std::vector<DepthLevel> BasicOrderBook<Policies>::getBidDepth(size_t maxLevels) const {
+        std::shared_lock lock(mutex_);
+        auto depth = collectDepth(bidLevels_, maxLevels);
+        if constexpr (Features::pegs) {
+            collectPegDepth(bidPrimaryPegs_, pegRefs_.bestBid, depth);
+            collectPegDepth(bidMidpointPegs_, pegRefs_.midpoint, depth);
+            std::sort(depth.begin(), depth.end(), [](const DepthLevel& a, const DepthLevel& b) {
+                return a.price > b.price;
+            });
+            if (depth.size() > maxLevels) depth.resize(maxLevels);
+        }
+        return depth;
+    }
+    
+    template <typename Policies>
+    std::vector<DepthLevel> BasicOrderBook<Policies>::getAskDepth(size_t maxLevels) const {
+        std::shared_lock lock(mutex_);
+        auto depth = collectDepth(askLevels_, maxLevels);
+        if constexpr (Features::pegs) {
+            collectPegDepth(askPrimaryPegs_, pegRefs_.bestAsk, depth);
+            collectPegDepth(askMidpointPegs_, pegRefs_.midpoint, depth);
+            std::sort(depth.begin(), depth.end(), [](const DepthLevel& a, const DepthLevel& b) {
+                return a.price < b.price;
+            });
+            if (depth.size() > maxLevels) depth.resize(maxLevels);
+        }
+        return depth;
+    }
+    
+    // CORE MATCHING ENGINE - PRICE PRIORITY, THEN THE BOOK'S LEVEL ALLOCATION RULE
+    template <typename Policies>
+    std::vector<std::shared_ptr<Trade>> BasicOrderBook<Policies>::matchOrders() {
+        LatencyTimer timer(LatencyMetric::MATCH_ORDERS);
         std::vector<std::shared_ptr<Trade>> trades;
         
+        // Frequent batch auction: matching only happens in the periodic uncross
+        if constexpr (Features::batchAuctions) {
+            if (batchInterval_.load(std::memory_order_relaxed) != 0) {
+                uncrossBatch(false, trades);
+                return trades;
+            }
+        }
+        
+        std::unique_lock lock(mutex_);
+        
+        // Orders accumulate untouched during a call auction
+        if (phase_ == TradingPhase::CALL_AUCTION) {
+            return trades;
+        }
+        
+        matchContinuous(trades);
+        
+        return trades;
+    }
+    
+    // Each cycle matches the active ladders, then releases every stop crossed by the
+    // last trade price in one batch; released stops can trade and cross further
+    // stops, so the cycle repeats until no stop fires. The allocation rule is
+    // dispatched once here, not per fill. Caller holds the book lock
+    template <typename Policies>
+    void BasicOrderBook<Policies>::matchContinuous(std::vector<std::shared_ptr<Trade>>& trades) {
+        do {
+            if constexpr (!std::is_same_v<Allocation, SelectableAllocation>) {
+                matchActiveOrders<Allocation>(trades);
+                continue;
+            }
+            switch (matchingAlgorithm_) {
+                case MatchingAlgorithm::FIFO:
+                    matchActiveOrders<FifoAllocation>(trades);
+                    break;
+                case MatchingAlgorithm::PRO_RATA:
+                    matchActiveOrders<ProRataAllocation>(trades);
+                    break;
+                case MatchingAlgorithm::FIFO_PRO_RATA:
+                    matchActiveOrders<FifoProRataAllocation>(trades);
+                    break;
+            }
+        } while (releaseTriggeredStops() > 0);
+    }
+    
+    template <typename Policies>
+    bool BasicOrderBook<Policies>::setMatchingAlgorithm(MatchingAlgorithm algorithm) {
+        if constexpr (!std::is_same_v<Allocation, SelectableAllocation>) {
+            return algorithm == matchingAlgorithm_;
+        }
         std::unique_lock lock(mutex_);
+        matchingAlgorithm_ = algorithm;
+        return true;
+    }
+    
+    template <typename Policies>
+    MatchingAlgorithm BasicOrderBook<Policies>::getMatchingAlgorithm() const {
+        std::shared_lock lock(mutex_);
+        return matchingAlgorithm_;
+    }
+    
+    // PEG REFERENCES - O(1) CHECK, RECOMPUTED ONLY WHEN THE REGULAR BBO MOVES
+    template <typename Policies>
+    void BasicOrderBook<Policies>::refreshPegReferences() {
+        if constexpr (Features::pegs) {
+            Price bestBid = bestLimitPrice(bidLevels_);
+            Price bestAsk = bestLimitPrice(askLevels_);
+            if (bestBid == pegRefs_.bestBid && bestAsk == pegRefs_.bestAsk) return;
+            
+            pegRefs_.bestBid = bestBid;
+            pegRefs_.bestAsk = bestAsk;
+            pegRefs_.midpoint = (bestBid > 0.0 && bestAsk > 0.0) ? (bestBid + bestAsk) / 2.0 : 0.0;
+        }
+    }
+    
+    template <typename Policies>
+    Price BasicOrderBook<Policies>::pegReference(const Order& order) const {
+        if constexpr (!Features::pegs) {
+            return 0.0;
+        } else {
+            const auto& peg = static_cast<const PeggedOrder&>(order);
+            if (peg.getPegType() == PegType::MIDPOINT) return pegRefs_.midpoint;
+            return peg.getOrderType() == OrderType::BUY ? pegRefs_.bestBid : pegRefs_.bestAsk;
+        }
+    }
+    
+    // MERGED VIEW - BEST OF THE REGULAR LADDER AND EACH PEG LADDER; ON EQUAL PRICES
+    // THE REGULAR LADDER KEEPS PRIORITY. Pegs without a reference are inactive;
+    // limitsOnly passes over the market level, which always sorts first
+    template <typename Policies>
+    auto BasicOrderBook<Policies>::bestBidTop(bool limitsOnly) -> LadderTop<BidLevels> {
+        LadderTop<BidLevels> top;
+        auto level = bidLevels_.begin();
+        if (limitsOnly && level != bidLevels_.end() && level->second.orders.front()->isMarketOrder()) ++level;
+        if (level != bidLevels_.end()) {
+            top = {&bidLevels_, level, PriceRep::toPrice(level->first), level->first};
+        }
         
-        while (!buyOrders_.empty() && !sellOrders_.empty()) {
-            auto bestBuy = *buyOrders_.begin();
-            auto bestSell = *sellOrders_.begin();
+        if constexpr (Features::pegs) {
+            auto consider = [&top](BidLevels& pegs, Price reference) {
+                if (pegs.empty() || reference <= 0.0) return;
+                Price price = reference + PriceRep::toPrice(pegs.begin()->first);
+                if (!top.levels || price > top.price) {
+                    top = {&pegs, pegs.begin(), price, PriceRep::toKey(price)};
+                }
+            };
+            consider(bidPrimaryPegs_, pegRefs_.bestBid);
+            consider(bidMidpointPegs_, pegRefs_.midpoint);
+        }
+        return top;
+    }
+    
+    template <typename Policies>
+    auto BasicOrderBook<Policies>::bestAskTop(bool limitsOnly) -> LadderTop<AskLevels> {
+        LadderTop<AskLevels> top;
+        auto level = askLevels_.begin();
+        if (limitsOnly && level != askLevels_.end() && level->second.orders.front()->isMarketOrder()) ++level;
+        if (level != askLevels_.end()) {
+            top = {&askLevels_, level, PriceRep::toPrice(level->first), level->first};
+        }
+        
+        if constexpr (Features::pegs) {
+            auto consider = [&top](AskLevels& pegs, Price reference) {
+                if (pegs.empty() || reference <= 0.0) return;
+                Price price = reference + PriceRep::toPrice(pegs.begin()->first);
+                if (!top.levels || price < top.price) {
+                    top = {&pegs, pegs.begin(), price, PriceRep::toKey(price)};
+                }
+            };
+            consider(askPrimaryPegs_, pegRefs_.bestAsk);
+            consider(askMidpointPegs_, pegRefs_.midpoint);
+        }
+        return top;
+    }
+    
+    // One step per crossing: the newer of the two front orders is the aggressor and
+    // its displayed quantity is allocated over the opposite top level by the policy
+    template <typename Policies>
+    template <typename LevelAllocator>
+    void BasicOrderBook<Policies>::matchActiveOrders(std::vector<std::shared_ptr<Trade>>& trades) {
+        for (;;) {
+            refreshPegReferences();
+            auto bid = bestBidTop();
+            auto ask = bestAskTop();
+            if (!bid.levels || !ask.levels) break;
+            
+            auto bestBuy = bid.level->second.orders.front();
+            auto bestSell = ask.level->second.orders.front();
+            
+            bool buyIsMarket = bestBuy->isMarketOrder();
+            bool sellIsMarket = bestSell->isMarketOrder();
             
-            if (bestBuy->getPrice() < bestSell->getPrice()) {
+            if (!buyIsMarket && !sellIsMarket && bid.price < ask.price) {
                 break;
             }
             
-            Quantity tradeQuantity = std::min(bestBuy->getRemainingQuantity(), 
-                                            bestSell->getRemainingQuantity());
-            Price tradePrice = bestSell->getPrice();
+            // Two market orders with no last traded price to meet at: the newer one
+            // trades against the best limit behind the other side's market orders,
+            // or the older one against its own side's limits when the other has none
+            if (buyIsMarket && sellIsMarket && lastTradePrice_ <= 0.0) {
+                bool buyIsNewer = bestBuy->getEntryTicks() > bestSell->getEntryTicks();
+                auto askLimit = bestAskTop(true);
+                auto bidLimit = bestBidTop(true);
+                if (askLimit.levels && (buyIsNewer || !bidLimit.levels)) {
+                    ask = askLimit;
+                    bestSell = ask.level->second.orders.front();
+                    sellIsMarket = false;
+                } else if (bidLimit.levels) {
+                    bid = bidLimit;
+                    bestBuy = bid.level->second.orders.front();
+                    buyIsMarket = false;
+                } else {
+                    break;   // market orders only: nothing to price a trade
+                }
+            }
+            
+            // Market orders take the price of the limit order they meet; two market
+            // orders can only trade at the last traded price
+            Price tradePrice;
+            if (!sellIsMarket) {
+                tradePrice = ask.price;
+            } else if (!buyIsMarket) {
+                tradePrice = bid.price;
+            } else {
+                tradePrice = lastTradePrice_;
+            }
             
-            auto trade = std::make_shared<Trade>(
-                generateUUID(), OrderType::BUY,
-                bestBuy->getOrderId(), bestSell->getOrderId(),
-                symbol_, tradeQuantity, tradePrice
-            );
-            trades.push_back(trade);
+            bool buyAggresses = bestBuy->getEntryTicks() > bestSell->getEntryTicks();
+            PriceLevel& passive = buyAggresses ? ask.level->second : bid.level->second;
+            const auto& aggressor = buyAggresses ? bestBuy : bestSell;
+            Price passivePrice = buyAggresses ? ask.price : bid.price;
             
-            bestBuy->fill(tradeQuantity);
-            bestSell->fill(tradeQuantity);
+            // Only displayed quantity trades; hidden reserve waits for its refresh
+            Quantity incoming = std::min(aggressor->getDisplayedQuantity(),
+                                         passive.displayedQuantity);
+            allocations_.clear();
+            LevelAllocator::allocate(passive.orders, passive.displayedQuantity, incoming, allocations_);
             
-            if (bestBuy->getRemainingQuantity() == 0) {
-                buyOrders_.erase(buyOrders_.begin());
+            // Pegs are materialized at the moment they execute
+            if constexpr (Features::pegs) {
+                if (aggressor->isPeggedOrder()) {
+                    static_cast<PeggedOrder&>(*aggressor).reprice(buyAggresses ? bid.price : ask.price);
+                }
             }
             
-            if (bestSell->getRemainingQuantity() == 0) {
-                sellOrders_.erase(sellOrders_.begin());
+            Quantity filled = 0;
+            for (const auto& allocation : allocations_) {
+                if (allocation.quantity == 0) continue;
+                const auto& resting = *allocation.position;
+                if constexpr (Features::pegs) {
+                    if (resting->isPeggedOrder()) static_cast<PeggedOrder&>(*resting).reprice(passivePrice);
+                }
+                
+                const auto& buyId = buyAggresses ? aggressor->getOrderId() : resting->getOrderId();
+                const auto& sellId = buyAggresses ? resting->getOrderId() : aggressor->getOrderId();
+                trades.push_back(std::make_shared<Trade>(
+                    idGenerator_.next(), OrderType::BUY, buyId, sellId,
+                    symbol_, allocation.quantity, tradePrice, clock_
+                ));
+                filled += allocation.quantity;
+            }
+            lastTradePrice_ = tradePrice;
+            
+            // The passive level can only empty on its last allocation, so erasing it
+            // there never invalidates a position still to be settled
+            for (const auto& allocation : allocations_) {
+                if (allocation.quantity == 0) continue;
+                if (buyAggresses) {
+                    settleFill(*ask.levels, ask.level, allocation.position, allocation.quantity);
+                } else {
+                    settleFill(*bid.levels, bid.level, allocation.position, allocation.quantity);
+                }
+            }
+            if (buyAggresses) {
+                settleFill(*bid.levels, bid.level, bid.level->second.orders.begin(), filled);
+            } else {
+                settleFill(*ask.levels, ask.level, ask.level->second.orders.begin(), filled);
             }
         }
+    }
+    
+    // Applies a fill to one order of a level: filled orders leave the queue,
+    // icebergs with an exhausted tip refresh in place and move to the back.
+    // Allocations never exceed an order's displayed quantity
+    template <typename Policies>
+    template <typename Levels>
+    void BasicOrderBook<Policies>::settleFill(Levels& levels, typename Levels::iterator levelIt,
+                               OrderQueue::iterator position, Quantity fillQuantity) {
+        PriceLevel& level = levelIt->second;
+        std::shared_ptr<Order> order = *position;
         
-        return trades;
+        assert(fillQuantity <= order->getDisplayedQuantity());
+        order->fill(fillQuantity);
+        level.displayedQuantity -= fillQuantity;
+        
+        if (order->getRemainingQuantity() == 0) {
+            orderLookup_[order->getOrderId()].resting = false;
+            level.orders.erase(position);
+            if (level.orders.empty()) levels.erase(levelIt);
+            return;
+        }
+        
+        if (order->needsReplenish()) {
+            level.displayedQuantity += order->replenish();
+            level.orders.splice(level.orders.end(), level.orders, position);
+        }
     }
     
-    Price OrderBook::getBestBid() const {
+    template <typename Policies>
+    size_t BasicOrderBook<Policies>::releaseTriggeredStops() {
+        if constexpr (!Features::stops) {
+            return 0;
+        } else {
+            if (lastTradePrice_ <= 0.0) return 0;
+            
+            // Crossed stops form a prefix of each index: one range erase per side
+            auto buyEnd = buyStops_.upper_bound(lastTradePrice_);
+            auto sellEnd = sellStops_.upper_bound(lastTradePrice_);
+            
+            size_t released = 0;
+            for (auto it = buyStops_.begin(); it != buyEnd; ++it, ++released) {
+                static_cast<StopOrder&>(*it->second).trigger();
+                insertResting(orderLookup_[it->second->getOrderId()]);
+            }
+            for (auto it = sellStops_.begin(); it != sellEnd; ++it, ++released) {
+                static_cast<StopOrder&>(*it->second).trigger();
+                insertResting(orderLookup_[it->second->getOrderId()]);
+            }
+            
+            buyStops_.erase(buyStops_.begin(), buyEnd);
+            sellStops_.erase(sellStops_.begin(), sellEnd);
+            return released;
+        }
+    }
+    
+    template <typename Policies>
+    bool BasicOrderBook<Policies>::removeStopOrder(const std::shared_ptr<Order>& order) {
+        if constexpr (!Features::stops) {
+            return false;
+        } else {
+            Price stopPrice = static_cast<const StopOrder&>(*order).getStopPrice();
+            if (order->getOrderType() == OrderType::BUY) {
+                auto range = buyStops_.equal_range(stopPrice);
+                for (auto it = range.first; it != range.second; ++it) {
+                    if (it->second == order) {
+                        buyStops_.erase(it);
+                        return true;
+                    }
+                }
+            } else {
+                auto range = sellStops_.equal_range(stopPrice);
+                for (auto it = range.first; it != range.second; ++it) {
+                    if (it->second == order) {
+                        sellStops_.erase(it);
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+    }
+    
+    template <typename Policies>
+    Price BasicOrderBook<Policies>::getBestBid() const {
         std::shared_lock lock(mutex_);
-        return buyOrders_.empty() ? 0.0 : (*buyOrders_.begin())->getPrice();
+        Price best = bestLimitPrice(bidLevels_);
+        if constexpr (Features::pegs) {
+            if (!bidPrimaryPegs_.empty() && pegRefs_.bestBid > 0.0) {
+                best = std::max(best, pegRefs_.bestBid + PriceRep::toPrice(bidPrimaryPegs_.begin()->first));
+            }
+            if (!bidMidpointPegs_.empty() && pegRefs_.midpoint > 0.0) {
+                best = std::max(best, pegRefs_.midpoint + PriceRep::toPrice(bidMidpointPegs_.begin()->first));
+            }
+        }
+        return best;
     }
     
-    Price OrderBook::getBestAsk() const {
+    template <typename Policies>
+    Price BasicOrderBook<Policies>::getBestAsk() const {
         std::shared_lock lock(mutex_);
-        return sellOrders_.empty() ? 0.0 : (*sellOrders_.begin())->getPrice();
+        Price best = bestLimitPrice(askLevels_);
+        if constexpr (Features::pegs) {
+            auto improve = [&best](Price price) {
+                if (best <= 0.0 || price < best) best = price;
+            };
+            if (!askPrimaryPegs_.empty() && pegRefs_.bestAsk > 0.0) {
+                improve(pegRefs_.bestAsk + PriceRep::toPrice(askPrimaryPegs_.begin()->first));
+            }
+            if (!askMidpointPegs_.empty() && pegRefs_.midpoint > 0.0) {
+                improve(pegRefs_.midpoint + PriceRep::toPrice(askMidpointPegs_.begin()->first));
+            }
+        }
+        return best;
     }
     
-    Price OrderBook::getSpread() const {
+    template <typename Policies>
+    Price BasicOrderBook<Policies>::getSpread() const {
         return getBestAsk() - getBestBid();
     }
     
-    bool OrderBook::isValid() const { return !symbol_.empty(); }
-    const Symbol& OrderBook::getSymbol() const { return symbol_; }
+    template <typename Policies>
+    Price BasicOrderBook<Policies>::getLastTradePrice() const {
+        std::shared_lock lock(mutex_);
+        return lastTradePrice_;
+    }
+    
+    template <typename Policies>
+    bool BasicOrderBook<Policies>::isValid() const { return !symbol_.empty(); }
+    template <typename Policies>
+    const Symbol& BasicOrderBook<Policies>::getSymbol() const { return symbol_; }
+    
+    // SUPPORTED COMBINATIONS - see the aliases in OrderBook.h
+    template class BasicOrderBook<DefaultBookPolicies>;
+    template class BasicOrderBook<
+        BookPolicies<FixedPointPrice<100>, ArrayLadderLevels, FifoAllocation, NoLocking, CoreFeatures>>;
+    template class BasicOrderBook<
+        BookPolicies<FixedPointPrice<100>, SkipListLevels, SelectableAllocation, SpinLocking>>;
+    template class BasicOrderBook<
+        BookPolicies<FloatingPrice, TreeLevels, ProRataAllocation>>;
 
 } // namespace TradingSystem
@@ -0,0 +1,485 @@
+#include "../include/OrderFlow.h"
+#include "../include/TradingEngine.h"
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace TradingSystem {
+
+    MappedFile::MappedFile(const std::string& path) : data_(nullptr), size_(0) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("cannot open " + path);
+        
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("cannot stat " + path);
+        }
+        size_ = static_cast<size_t>(info.st_size);
+        
+        if (size_ > 0) {
+            void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("cannot map " + path);
+            }
+            ::madvise(mapping, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(mapping);
+        }
+        ::close(fd);   // the mapping keeps the file referenced
+    }
+    
+    MappedFile::~MappedFile() {
+        if (data_) ::munmap(const_cast<char*>(data_), size_);
+    }
+    
+    OrderFlowReader::OrderFlowReader(const MappedFile& file)
+        : OrderFlowReader(file.data(), file.size()) {}
+        
+    OrderFlowReader::OrderFlowReader(const char* data, size_t size)
+        : cursor_(data), end_(data + size), binary_(false), malformed_(0) {
+        if (size >= BINARY_FLOW_MAGIC.size() &&
+            std::memcmp(data, BINARY_FLOW_MAGIC.data(), BINARY_FLOW_MAGIC.size()) == 0) {
+            binary_ = true;
+            cursor_ += BINARY_FLOW_MAGIC.size();
+        }
+    }
+    
+    bool OrderFlowReader::next(FlowEvent& event) {
+        return binary_ ? nextBinary(event) : nextCsv(event);
+    }
+    
+    bool OrderFlowReader::isBinary() const {
+        return binary_;
+    }
+    
+    size_t OrderFlowReader::getMalformedCount() const {
+        return malformed_;
+    }
+    
+    bool OrderFlowReader::nextBinary(FlowEvent& event) {
+        BinaryFlowRecord record;
+        do {
+            if (end_ - cursor_ < static_cast<std::ptrdiff_t>(sizeof(BinaryFlowRecord))) return false;
+            std::memcpy(&record, cursor_, sizeof(record));
+            cursor_ += sizeof(record);
+        } while ((record.action > static_cast<std::uint8_t>(FlowAction::MODIFY) ||
+                  record.userLength > sizeof(record.user) ||
+                  record.symbolLength > sizeof(record.symbol)) && ++malformed_);
+        
+        event.timestampNs = record.timestampNs;
+        event.action = static_cast<FlowAction>(record.action);
+        event.side = record.side == 0 ? OrderType::BUY : OrderType::SELL;
+        event.quantity = record.quantity;
+        event.price = record.price;
+        event.reference = record.reference;
+        
+        // Ids are viewed in place inside the mapping
+        const char* base = cursor_ - sizeof(record);
+        event.user = std::string_view(base + offsetof(BinaryFlowRecord, user), record.userLength);
+        event.symbol = std::string_view(base + offsetof(BinaryFlowRecord, symbol), record.symbolLength);
+        return true;
+    }
+    
+    namespace {
+    
+        constexpr size_t CSV_FIELDS = 8;
+        
+        // Plain runs of up to 19 digits, converted 8 at a time within a 64-bit word
+        // (little-endian). Returns false for anything else.
+        bool parseDigits(std::string_view field, std::uint64_t& value) {
+            if (field.empty() || field.size() > 19) return false;
+            const char* p = field.data();
+            size_t left = field.size();
+            std::uint64_t result = 0;
+            for (; left >= 8; p += 8, left -= 8) {
+                std::uint64_t chunk;
+                std::memcpy(&chunk, p, sizeof(chunk));
+                if (((chunk & 0xF0F0F0F0F0F0F0F0ULL) |
+                     (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) != 0x3333333333333333ULL) {
+                    return false;
+                }
+                chunk -= 0x3030303030303030ULL;
+                chunk = chunk * 10 + (chunk >> 8);
+                chunk = (((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+                         (((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+                result = result * 100000000 + chunk;
+            }
+            for (; left > 0; ++p, --left) {
+                unsigned digit = static_cast<unsigned>(*p - '0');
+                if (digit > 9) return false;
+                result = result * 10 + digit;
+            }
+            value = result;
+            return true;
+        }
+        
+        template <typename T>
+        bool parseNumber(std::string_view field, T& value) {
+            if constexpr (std::is_integral_v<T>) {
+                std::uint64_t digits;
+                if (parseDigits(field, digits) &&
+                    digits <= static_cast<std::uint64_t>(std::numeric_limits<T>::max())) {
+                    value = static_cast<T>(digits);
+                    return true;
+                }
+            }
+            // Signs, overflow and floating point take the general, locale-free path
+            auto result = std::from_chars(field.data(), field.data() + field.size(), value);
+            return result.ec == std::errc() && result.ptr == field.data() + field.size();
+        }
+        
+        // Prices are short decimals like "1800.05". Up to 15 digits the digit string and
+        // the power of ten are both exact doubles, so one division gives the correctly
+        // rounded value from_chars would; anything else goes to from_chars.
+        bool parsePrice(std::string_view field, double& value) {
+            static constexpr double POWERS_OF_TEN[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+                                                       1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+            std::uint64_t digits = 0;
+            size_t digitCount = 0;
+            size_t fractionDigits = 0;
+            bool point = false;
+            for (char c : field) {
+                if (c >= '0' && c <= '9') {
+                    digits = digits * 10 + static_cast<unsigned>(c - '0');
+                    ++digitCount;
+                    fractionDigits += point;
+                } else if (c == '.' && !point) {
+                    point = true;
+                } else {
+                    return parseNumber(field, value);
+                }
+            }
+            if (digitCount == 0 || digitCount > 15) return parseNumber(field, value);
+            value = static_cast<double>(digits) / POWERS_OF_TEN[fractionDigits];
+            return true;
+        }
+        
+        // Splits the line at `cursor` on commas and moves `cursor` past its newline.
+        // Returns the number of fields seen, which may exceed CSV_FIELDS; only the
+        // first CSV_FIELDS are stored.
+        // DESIGN DECISION: Commas and newlines are found together, 16 bytes per step
+        // with SSE2 compares, so a typical line costs three block compares and one
+        // iteration per separator rather than a loop over every byte; the scalar loop
+        // only handles the last partial block of the file.
+        size_t splitLine(const char*& cursor, const char* end, std::string_view& line,
+                         std::string_view (&fields)[CSV_FIELDS]) {
+            const char* begin = cursor;
+            const char* fieldStart = begin;
+            size_t count = 0;
+            
+            auto separator = [&](const char* at) {
+                if (count < CSV_FIELDS) fields[count] = std::string_view(fieldStart, at - fieldStart);
+                ++count;
+                fieldStart = at + 1;
+            };
+            auto finish = [&](const char* at, const char* next) {
+                if (at > fieldStart && at[-1] == '\r') --at;
+                separator(at);
+                line = std::string_view(begin, at - begin);
+                cursor = next;
+                return count;
+            };
+            
+            const char* p = begin;
+#ifdef __SSE2__
+            const __m128i comma = _mm_set1_epi8(',');
+            const __m128i newline = _mm_set1_epi8('\n');
+            for (; end - p >= 16; p += 16) {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+                    _mm_or_si128(_mm_cmpeq_epi8(block, comma), _mm_cmpeq_epi8(block, newline))));
+                while (mask) {
+                    const char* at = p + __builtin_ctz(mask);
+                    mask &= mask - 1;
+                    if (*at == '\n') return finish(at, at + 1);
+                    separator(at);
+                }
+            }
+#endif
+            for (; p < end; ++p) {
+                if (*p == '\n') return finish(p, p + 1);
+                if (*p == ',') separator(p);
+            }
+            return finish(end, end);
+        }
+        
+        bool parseCsvFields(const std::string_view (&fields)[CSV_FIELDS], FlowEvent& event) {
+            if (!parseNumber(fields[0], event.timestampNs)) return false;
+            if (fields[1].size() != 1) return false;
+            switch (fields[1][0]) {
+                case 'N': event.action = FlowAction::NEW; break;
+                case 'C': event.action = FlowAction::CANCEL; break;
+                case 'M': event.action = FlowAction::MODIFY; break;
+                default: return false;
+            }
+            event.user = fields[2];
+            event.symbol = fields[3];
+            if (!parseNumber(fields[7], event.reference)) return false;
+            
+            event.quantity = 0;
+            event.price = 0.0;
+            if (event.action == FlowAction::CANCEL) return true;
+            
+            if (!parseNumber(fields[5], event.quantity)) return false;
+            if (!fields[6].empty() && !parsePrice(fields[6], event.price)) return false;
+            if (event.action == FlowAction::MODIFY) return true;
+            
+            // Buy and sell arrive at random, so the side is decoded without a branch
+            if (fields[4].size() != 1) return false;
+            char side = fields[4][0];
+            event.side = side == 'B' ? OrderType::BUY : OrderType::SELL;
+            return side == 'B' || side == 'S';
+        }
+        
+        // Returns false when an id does not fit its 16-byte field; such an event has
+        // no faithful binary form and is never written cut short
+        bool toBinaryRecord(const FlowEvent& event, BinaryFlowRecord& record) {
+            if (event.user.size() > sizeof(record.user) || event.symbol.size() > sizeof(record.symbol)) {
+                return false;
+            }
+            record = BinaryFlowRecord{};
+            record.timestampNs = event.timestampNs;
+            record.reference = event.reference;
+            record.price = event.price;
+            record.quantity = event.quantity;
+            record.action = static_cast<std::uint8_t>(event.action);
+            record.side = event.side == OrderType::BUY ? 0 : 1;
+            record.userLength = static_cast<std::uint8_t>(event.user.size());
+            record.symbolLength = static_cast<std::uint8_t>(event.symbol.size());
+            std::memcpy(record.user, event.user.data(), record.userLength);
+            std::memcpy(record.symbol, event.symbol.data(), record.symbolLength);
+            return true;
+        }
+        
+    } // namespace
+    
+    bool OrderFlowReader::nextCsv(FlowEvent& event) {
+        std::string_view fields[CSV_FIELDS];
+        std::string_view line;
+        while (cursor_ < end_) {
+            size_t count = splitLine(cursor_, end_, line, fields);
+            if (line.empty()) continue;
+            if (count == CSV_FIELDS && parseCsvFields(fields, event)) return true;
+            
+            // A header row is not an error
+            if (line.rfind("timestamp", 0) != 0) ++malformed_;
+        }
+        return false;
+    }
+    
+    void writeCsvFlow(std::ostream& out, const std::vector<FlowEvent>& events) {
+        out << "timestamp_ns,action,user,symbol,side,quantity,price,reference\n";
+        for (const auto& event : events) {
+            out << event.timestampNs << ','
+                << (event.action == FlowAction::NEW ? 'N' : event.action == FlowAction::CANCEL ? 'C' : 'M')
+                << ',' << event.user << ',' << event.symbol << ',';
+            if (event.action == FlowAction::NEW) out << (event.side == OrderType::BUY ? 'B' : 'S');
+            out << ',';
+            if (event.action != FlowAction::CANCEL) {
+                out << event.quantity << ',' << std::setprecision(10) << event.price;
+            } else {
+                out << ',';
+            }
+            out << ',' << event.reference << '\n';
+        }
+    }
+    
+    void writeBinaryFlow(std::ostream& out, const std::vector<FlowEvent>& events) {
+        out.write(BINARY_FLOW_MAGIC.data(), BINARY_FLOW_MAGIC.size());
+        BinaryFlowRecord record;
+        for (const auto& event : events) {
+            if (!toBinaryRecord(event, record)) {
+                throw std::invalid_argument("flow ids longer than 16 bytes have no binary form: " +
+                                            std::string(event.user) + "/" + std::string(event.symbol));
+            }
+            out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        }
+    }
+
+    size_t convertCsvToBinary(const std::string& csvPath, const std::string& binaryPath, size_t* dropped) {
+        MappedFile input(csvPath);
+        OrderFlowReader reader(input);
+        if (reader.isBinary()) throw std::runtime_error(csvPath + " is already binary");
+        
+        std::ofstream out(binaryPath, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("cannot write " + binaryPath);
+        out.write(BINARY_FLOW_MAGIC.data(), BINARY_FLOW_MAGIC.size());
+        
+        size_t written = 0;
+        size_t oversized = 0;
+        FlowEvent event;
+        BinaryFlowRecord record;
+        while (reader.next(event)) {
+            if (!toBinaryRecord(event, record)) {
+                ++oversized;
+                continue;
+            }
+            out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+            ++written;
+        }
+        if (!out.flush()) throw std::runtime_error("cannot write " + binaryPath);
+        if (dropped) *dropped = reader.getMalformedCount() + oversized;
+        return written;
+    }
+    
+    OrderFlowLoader::OrderFlowLoader(TradingEngine& engine, SimulatedClock* clock, size_t batchSize)
+        : engine_(engine), clock_(clock), batchSize_(std::max<size_t>(1, batchSize)),
+          batch_(batchSize_), sweepAt_(MIN_SWEEP_SIZE), submitted_(0), rejected_(0) {}
+        
+    void OrderFlowLoader::setSymbolSetup(std::function<void(const Symbol&)> setup) {
+        symbolSetup_ = std::move(setup);
+    }
+    
+    size_t OrderFlowLoader::load(OrderFlowReader& reader) {
+        size_t total = 0;
+        for (;;) {
+            size_t count = 0;
+            while (count < batchSize_ && reader.next(batch_[count])) ++count;
+            if (count == 0) break;
+            submit(batch_.data(), count);
+            total += count;
+        }
+        return total;
+    }
+    
+    size_t OrderFlowLoader::submit(const FlowEvent* events, size_t count) {
+        size_t accepted = 0;
+        for (size_t i = 0; i < count;) {
+            // Consecutive new orders go to the engine as one batch. With a simulated
+            // clock a run also ends where time moves on, so every order is still
+            // stamped with its own journal time.
+            size_t end = i + 1;
+            if (events[i].action == FlowAction::NEW) {
+                while (end < count && events[end].action == FlowAction::NEW &&
+                       (!clock_ || events[end].timestampNs == events[i].timestampNs)) {
+                    ++end;
+                }
+            }
+            accepted += end - i > 1 ? placeRun(events + i, end - i) : apply(events[i]);
+            i = end;
+        }
+        submitted_ += count;
+        rejected_ += count - accepted;
+        return accepted;
+    }
+    
+    void OrderFlowLoader::prepare(const FlowEvent& event) {
+        if (clock_) {
+            clock_->advanceTo(Timestamp(std::chrono::duration_cast<Timestamp::duration>(
+                std::chrono::nanoseconds(event.timestampNs))));
+        }
+        
+        user_.assign(event.user);
+        if (users_.insert(user_).second) {
+            engine_.registerUser(std::make_shared<User>(user_, user_, "0000000000", "replay@journal"));
+        }
+        
+        if (event.action == FlowAction::NEW) {
+            symbol_.assign(event.symbol);
+            if (symbols_.insert(symbol_).second && symbolSetup_) symbolSetup_(symbol_);
+        }
+    }
+    
+    size_t OrderFlowLoader::placeRun(const FlowEvent* events, size_t count) {
+        requests_.resize(count);
+        results_.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            prepare(events[i]);
+            OrderRequest& request = requests_[i];
+            request.userId = user_;
+            request.symbol = symbol_;
+            request.orderType = events[i].side;
+            request.quantity = events[i].quantity;
+            request.price = events[i].price;
+        }
+        
+        size_t placed = engine_.placeOrders(requests_, results_);
+        for (size_t i = 0; i < count; ++i) {
+            if (results_[i]) track(events[i].reference, std::move(results_[i]));
+            results_[i].reset();
+        }
+        return placed;
+    }
+    
+    namespace {
+        
+        bool isDone(const Order& order) {
+            switch (order.getStatus()) {
+                case OrderStatus::FILLED:
+                case OrderStatus::CANCELLED:
+                case OrderStatus::REJECTED:
+                case OrderStatus::EXPIRED:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+        
+    } // namespace
+    
+    void OrderFlowLoader::track(std::uint64_t reference, std::shared_ptr<Order> order) {
+        // Orders that filled on entry can never be cancelled or modified
+        if (isDone(*order)) {
+            orders_.erase(reference);
+            return;
+        }
+        orders_[reference] = std::move(order);
+        
+        // Resting orders filled later by the other side are swept out once the map has
+        // doubled since the last sweep, so it stays within twice the live order count
+        if (orders_.size() >= sweepAt_) {
+            std::erase_if(orders_, [](const auto& entry) { return isDone(*entry.second); });
+            sweepAt_ = std::max(MIN_SWEEP_SIZE, orders_.size() * 2);
+        }
+    }
+    
+    bool OrderFlowLoader::apply(const FlowEvent& event) {
+        prepare(event);
+        
+        if (event.action == FlowAction::NEW) {
+            auto order = engine_.placeOrder(user_, event.side, symbol_, event.quantity, event.price);
+            if (!order) return false;
+            track(event.reference, std::move(order));
+            return true;
+        }
+        
+        auto it = orders_.find(event.reference);
+        if (it == orders_.end()) return false;
+        if (event.action == FlowAction::CANCEL) {
+            bool cancelled = engine_.cancelOrder(user_, it->second->getOrderId());
+            orders_.erase(it);
+            return cancelled;
+        }
+        const OrderId& orderId = it->second->getOrderId();
+        if (!engine_.modifyOrder(user_, orderId, event.quantity, event.price)) return false;
+        
+        // A modify replaces the order object, so follow the reference to the live one
+        auto live = engine_.getOrderStatus(user_, orderId);
+        if (!live || isDone(*live)) orders_.erase(it);
+        else it->second = std::move(live);
+        return true;
+    }
+    
+    const std::unordered_set<Symbol>& OrderFlowLoader::getSymbols() const {
+        return symbols_;
+    }
+    
+    std::uint64_t OrderFlowLoader::getSubmittedCount() const {
+        return submitted_;
+    }
+    
+    std::uint64_t OrderFlowLoader::getRejectedCount() const {
+        return rejected_;
+    }
+    
+    size_t OrderFlowLoader::getOpenReferenceCount() const {
+        return orders_.size();
+    }
+
+} // namespace TradingSystem
@@ -0,0 +1,440 @@
+#include "../include/OrderGateway.h"
+
+namespace TradingSystem {
+
+    void CompletionQueue::push(Completion completion) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            completions_.push_back(std::move(completion));
+        }
+        ready_.notify_one();
+    }
+    
+    void CompletionQueue::push(const Completion* completions, size_t count) {
+        if (count == 0) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            completions_.insert(completions_.end(), completions, completions + count);
+        }
+        ready_.notify_one();
+    }
+    
+    size_t CompletionQueue::poll(Completion* out, size_t max) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t count = std::min(max, completions_.size());
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = std::move(completions_.front());
+            completions_.pop_front();
+        }
+        return count;
+    }
+    
+    bool CompletionQueue::waitFor(std::chrono::microseconds timeout) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return ready_.wait_for(lock, timeout, [this] { return !completions_.empty(); });
+    }
+    
+    size_t CompletionQueue::size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return completions_.size();
+    }
+    
+    thread_local AsyncOrderGateway::InFlight* AsyncOrderGateway::inFlight_ = nullptr;
+    thread_local AsyncOrderGateway::Worker* AsyncOrderGateway::currentWorker_ = nullptr;
+    
+    namespace {
+        constexpr size_t WORKER_BATCH = 256;
+        constexpr size_t PUBLISH_BATCH = 256;
+        
+        GatewayConfig workerConfig(size_t workers, ThreadGroupConfig threads) {
+            GatewayConfig config;
+            config.workers = workers;
+            config.workerThreads = std::move(threads);
+            return config;
+        }
+    }
+    
+    AsyncOrderGateway::AsyncOrderGateway(TradingEngine& engine, size_t workers, ThreadGroupConfig threads)
+        : AsyncOrderGateway(engine, workerConfig(workers, std::move(threads))) {}
+        
+    AsyncOrderGateway::AsyncOrderGateway(TradingEngine& engine, GatewayConfig config)
+        : engine_(engine), config_(std::move(config)) {
+        engine_.registerObserver(this);
+        for (size_t i = 0; i < std::max<size_t>(1, config_.workers); ++i) {
+            workers_.push_back(std::make_unique<Worker>(i, config_.commandQueueCapacity));
+            if (config_.publisher) {
+                workers_.back()->events = std::make_unique<SpscRing<Delivery>>(config_.eventQueueCapacity,
+                                                                               &publisherSignal_);
+            }
+        }
+        for (auto& worker : workers_) {
+            worker->thread = std::thread([this, &worker = *worker] { runWorker(worker); });
+        }
+        if (config_.publisher) publisher_ = std::thread([this] { runPublisher(); });
+    }
+    
+    // Workers first, so the publisher sees every event they raise before it stops
+    AsyncOrderGateway::~AsyncOrderGateway() {
+        stopping_.store(true);
+        for (auto& worker : workers_) worker->signal.notifyAll();
+        for (auto& worker : workers_) worker->thread.join();
+        if (publisher_.joinable()) {
+            publisherStopping_.store(true);
+            publisherSignal_.notifyAll();
+            publisher_.join();
+        }
+        engine_.unregisterObserver(this);
+    }
+    
+    std::shared_ptr<CompletionQueue> AsyncOrderGateway::connect(const UserId& userId) {
+        std::lock_guard<std::mutex> lock(sessionMutex_);
+        auto& queue = sessions_[userId];
+        if (!queue) queue = std::make_shared<CompletionQueue>();
+        return queue;
+    }
+    
+    Ticket AsyncOrderGateway::submitOrder(const UserId& userId, OrderType orderType, const Symbol& symbol,
+                                          Quantity quantity, Price price, OrderTimeInForce timeInForce) {
+        return enqueue(Command{CommandType::NEW, 0, userId, orderType, symbol, quantity, price,
+                               timeInForce, OrderId(), nullptr});
+    }
+    
+    Ticket AsyncOrderGateway::submitCancel(const UserId& userId, const OrderId& orderId) {
+        return enqueue(Command{CommandType::CANCEL, 0, userId, OrderType::BUY, Symbol(), 0, 0.0,
+                               OrderTimeInForce::GTC, orderId, nullptr});
+    }
+    
+    Ticket AsyncOrderGateway::submitModify(const UserId& userId, const OrderId& orderId,
+                                           Quantity newQuantity, Price newPrice) {
+        return enqueue(Command{CommandType::MODIFY, 0, userId, OrderType::BUY, Symbol(), newQuantity,
+                               newPrice, OrderTimeInForce::GTC, orderId, nullptr});
+    }
+    
+    Ticket AsyncOrderGateway::enqueue(Command command) {
+        if (stopping_.load(std::memory_order_relaxed)) return 0;
+        {
+            std::lock_guard<std::mutex> lock(sessionMutex_);
+            auto it = sessions_.find(command.userId);
+            if (it == sessions_.end()) return 0;
+            command.queue = it->second;
+        }
+        
+        command.ticket = nextTicket_.fetch_add(1, std::memory_order_relaxed);
+        Ticket ticket = command.ticket;
+        Worker& worker = *workers_[std::hash<UserId>{}(command.userId) % workers_.size()];
+        Lane& lane = config_.priorityLanes && pickPriorityLane(command) ? worker.priority : worker.normal;
+        worker.submitted.fetch_add(1, std::memory_order_relaxed);
+        lane.commands.push(std::move(command));
+        return ticket;
+    }
+    
+    // A modify is a reduction when it keeps the price and lowers the quantity of an
+    // order the gateway is routing; judged at submission, so a fill still in flight
+    // can make it a plain modify by the time it runs, which the engine handles anyway;
+    // caller holds routeMutex_
+    bool AsyncOrderGateway::isPriority(const Command& command) {
+        if (command.type == CommandType::CANCEL) return true;
+        if (command.type != CommandType::MODIFY) return false;
+        auto it = routes_.find(command.orderId);
+        return it != routes_.end() && command.price == it->second.price && command.quantity < it->second.remaining;
+    }
+    
+    // Requests for one order stay in submission order: whichever lane already holds
+    // one of them takes the next too, and only an order with nothing queued lets a
+    // cancel or reduction into the priority lane
+    bool AsyncOrderGateway::pickPriorityLane(const Command& command) {
+        if (command.type == CommandType::NEW) return false;
+        std::lock_guard<std::mutex> lock(routeMutex_);
+        QueuedRequests& queued = queued_[command.orderId];
+        bool priority = queued.priority > 0 || (queued.normal == 0 && isPriority(command));
+        ++(priority ? queued.priority : queued.normal);
+        return priority;
+    }
+    
+    void AsyncOrderGateway::dequeued(const Command& command, bool priority) {
+        std::lock_guard<std::mutex> lock(routeMutex_);
+        auto it = queued_.find(command.orderId);
+        --(priority ? it->second.priority : it->second.normal);
+        if (it->second.priority == 0 && it->second.normal == 0) queued_.erase(it);
+    }
+    
+    // Waits on each worker's counters rather than its queue: a request counts as
+    // done only once its worker has finished executing it
+    void AsyncOrderGateway::flush() {
+        for (auto& worker : workers_) {
+            std::uint64_t target = worker->submitted.load(std::memory_order_relaxed);
+            while (!worker->drained.waitUntil(
+                [&worker, target] { return worker->completed.load(std::memory_order_acquire) >= target; },
+                WaitStrategy::BLOCK)) {}
+        }
+        if (!config_.publisher) return;
+        for (auto& worker : workers_) {
+            std::uint64_t target = worker->raised.load(std::memory_order_acquire);
+            while (!delivered_.waitUntil(
+                [&worker, target] { return worker->published.load(std::memory_order_acquire) >= target; },
+                WaitStrategy::BLOCK)) {}
+        }
+    }
+    
+    size_t AsyncOrderGateway::takeFrom(Lane& lane, Command* out, size_t max) {
+        size_t depth = lane.commands.size();
+        if (depth > lane.peakDepth.load(std::memory_order_relaxed)) {
+            lane.peakDepth.store(depth, std::memory_order_relaxed);
+        }
+        return lane.commands.tryPopBatch(out, max);
+    }
+    
+    // Each pass takes the priority lane first, then a bounded run of the normal lane,
+    // so a cancel waits behind at most one normal run however deep that lane is.
+    // Without priority lanes the normal run is WORKER_BATCH long, so a burst from a
+    // pipelining client costs one ring position update rather than one per request.
+    void AsyncOrderGateway::runWorker(Worker& worker) {
+        const ThreadGroupConfig& threads = config_.workerThreads;
+        ThreadPlacement::apply(threads, worker.index);
+        currentWorker_ = &worker;
+        size_t priorityRun = std::clamp<size_t>(config_.priorityBurst, 1, WORKER_BATCH);
+        size_t normalRun = config_.priorityLanes ? std::clamp<size_t>(config_.normalBurst, 1, WORKER_BATCH)
+                                                 : WORKER_BATCH;
+        std::vector<Command> batch(priorityRun + normalRun);
+        for (;;) {
+            size_t urgent = takeFrom(worker.priority, batch.data(), priorityRun);
+            size_t count = urgent + takeFrom(worker.normal, batch.data() + urgent, normalRun);
+            if (count == 0) {
+                if (stopping_.load() && worker.priority.commands.empty() && worker.normal.commands.empty()) {
+                    break;   // nothing left to run
+                }
+                worker.signal.waitUntil(
+                    [this, &worker] {
+                        return worker.priority.commands.readyToPop() || worker.normal.commands.readyToPop() ||
+                               stopping_.load();
+                    },
+                    threads.waitStrategy, std::chrono::microseconds::zero(), threads.spinIterations);
+                continue;
+            }
+            for (size_t i = 0; i < count; ++i) {
+                execute(batch[i]);
+                if (config_.priorityLanes && batch[i].type != CommandType::NEW) dequeued(batch[i], i < urgent);
+                batch[i].queue.reset();
+            }
+            worker.priority.executed.fetch_add(urgent, std::memory_order_relaxed);
+            worker.normal.executed.fetch_add(count - urgent, std::memory_order_relaxed);
+            worker.completed.fetch_add(count, std::memory_order_release);
+            worker.drained.notifyIfWaiting();
+        }
+        currentWorker_ = nullptr;
+    }
+    
+    GatewayStats AsyncOrderGateway::getStats() const {
+        GatewayStats stats;
+        auto snapshot = [](const Lane& lane) {
+            return GatewayLaneStats{lane.commands.size(), lane.peakDepth.load(std::memory_order_relaxed),
+                                    lane.executed.load(std::memory_order_relaxed)};
+        };
+        for (const auto& worker : workers_) {
+            stats.priorityLane.push_back(snapshot(worker->priority));
+            stats.normalLane.push_back(snapshot(worker->normal));
+        }
+        return stats;
+    }
+    
+    // Hands consecutive completions for the same client to its queue in one push
+    void AsyncOrderGateway::runPublisher() {
+        const ThreadGroupConfig& threads = config_.publisherThreads;
+        ThreadPlacement::apply(threads, 0);
+        std::vector<Delivery> batch(PUBLISH_BATCH);
+        std::vector<Completion> run;
+        run.reserve(PUBLISH_BATCH);
+        auto pending = [this] {
+            for (auto& worker : workers_) {
+                if (!worker->events->empty()) return true;
+            }
+            return false;
+        };
+        
+        for (;;) {
+            bool delivered = false;
+            for (auto& worker : workers_) {
+                size_t count = worker->events->tryPopBatch(batch.data(), batch.size());
+                if (count == 0) continue;
+                for (size_t first = 0; first < count;) {
+                    size_t last = first;
+                    run.clear();
+                    while (last < count && batch[last].queue == batch[first].queue) {
+                        run.push_back(std::move(batch[last].completion));
+                        ++last;
+                    }
+                    batch[first].queue->push(run.data(), run.size());
+                    for (size_t i = first; i < last; ++i) batch[i].queue.reset();
+                    first = last;
+                }
+                worker->published.fetch_add(count, std::memory_order_release);
+                delivered = true;
+            }
+            if (delivered) {
+                delivered_.notifyIfWaiting();
+                continue;
+            }
+            if (publisherStopping_.load() && !pending()) return;
+            publisherSignal_.waitUntil([this, &pending] { return pending() || publisherStopping_.load(); },
+                                       threads.waitStrategy, std::chrono::microseconds::zero(),
+                                       threads.spinIterations);
+        }
+    }
+    
+    // From a worker of this gateway in publisher mode, through the worker's event
+    // ring; from anywhere else, straight onto the client's queue
+    void AsyncOrderGateway::deliver(const std::shared_ptr<CompletionQueue>& queue, Completion completion) {
+        Worker* worker = currentWorker_;
+        bool ownWorker = worker && worker->events && worker->index < workers_.size() &&
+                         workers_[worker->index].get() == worker;
+        if (!ownWorker) {
+            queue->push(std::move(completion));
+            return;
+        }
+        worker->raised.fetch_add(1, std::memory_order_relaxed);
+        worker->events->push(Delivery{queue, std::move(completion)});
+    }
+    
+    void AsyncOrderGateway::execute(Command& command) {
+        InFlight context{this, &command, false};
+        inFlight_ = &context;
+        
+        bool succeeded = false;
+        CompletionType success = CompletionType::ACCEPTED;
+        OrderId orderId = command.orderId;
+        switch (command.type) {
+            case CommandType::NEW: {
+                std::uint64_t start = beginNew();
+                auto order = engine_.placeOrder(command.userId, command.orderType, command.symbol,
+                                                command.quantity, command.price, command.timeInForce);
+                endNew(start);
+                succeeded = order != nullptr;
+                if (order) orderId = order->getOrderId();
+                break;
+            }
+            case CommandType::CANCEL:
+                succeeded = engine_.cancelOrder(command.userId, command.orderId);
+                success = CompletionType::CANCELLED;
+                break;
+            case CommandType::MODIFY:
+                succeeded = engine_.modifyOrder(command.userId, command.orderId,
+                                                command.quantity, command.price);
+                success = CompletionType::MODIFIED;
+                break;
+        }
+        
+        inFlight_ = nullptr;
+        if (!context.acknowledged) {
+            deliver(command.queue, Completion{command.ticket, succeeded ? success : CompletionType::REJECTED,
+                                           orderId, 0, 0.0});
+        }
+    }
+    
+    void AsyncOrderGateway::onOrderStatusChanged(const std::shared_ptr<Order>& order) {
+        InFlight* current = inFlight_ && inFlight_->gateway == this ? inFlight_ : nullptr;
+        const OrderId& orderId = order->getOrderId();
+        Completion completion;
+        std::shared_ptr<CompletionQueue> queue;
+        
+        {
+            std::lock_guard<std::mutex> lock(routeMutex_);
+            auto it = routes_.find(orderId);
+            
+            if (it == routes_.end()) {
+                // The order the running NEW request has just placed
+                if (!current || current->acknowledged || current->command->type != CommandType::NEW ||
+                    order->getUserId() != current->command->userId) {
+                    return;
+                }
+                // The route starts from the submitted quantity: fills another worker
+                // made before this callback are already taken off the order. The ack
+                // and those fills go out under the route lock, so they reach the client
+                // ahead of any fill routed once the route exists
+                const Command& command = *current->command;
+                current->acknowledged = true;
+                deliver(command.queue, Completion{command.ticket, CompletionType::ACCEPTED, orderId, 0, 0.0});
+                Quantity remaining = command.quantity;
+                for (const auto& fill : earlyFills_) {
+                    if (fill.orderId != orderId) continue;
+                    deliver(command.queue, Completion{command.ticket, CompletionType::FILL, orderId,
+                                                      fill.quantity, fill.price});
+                    remaining -= fill.quantity;
+                }
+                if (remaining > 0) {
+                    routes_.emplace(orderId, OrderRoute{command.queue, command.ticket, remaining,
+                                                        order->getPrice()});
+                }
+                return;
+            } else {
+                bool answersRequest = current && !current->acknowledged && current->command->orderId == orderId;
+                switch (order->getStatus()) {
+                    case OrderStatus::CANCELLED:
+                    case OrderStatus::EXPIRED:
+                    case OrderStatus::REJECTED:
+                        // An expiry is reported against the ticket that placed the order
+                        queue = it->second.queue;
+                        completion = Completion{it->second.ticket, CompletionType::CANCELLED, orderId, 0, 0.0};
+                        if (answersRequest && current->command->type == CommandType::CANCEL) {
+                            completion.ticket = current->command->ticket;
+                            current->acknowledged = true;
+                        }
+                        routes_.erase(it);
+                        break;
+                    default:
+                        // Modified: the replacement order carries the new remaining quantity and price
+                        it->second.remaining = order->getRemainingQuantity();
+                        it->second.price = order->getPrice();
+                        if (!answersRequest || current->command->type != CommandType::MODIFY) return;
+                        current->acknowledged = true;
+                        queue = it->second.queue;
+                        completion = Completion{current->command->ticket, CompletionType::MODIFIED, orderId, 0, 0.0};
+                        break;
+                }
+            }
+        }
+        deliver(queue, std::move(completion));
+    }
+    
+    void AsyncOrderGateway::onTradeExecuted(const std::shared_ptr<Trade>& trade) {
+        routeFill(trade->getBuyerOrderId(), *trade);
+        routeFill(trade->getSellerOrderId(), *trade);
+    }
+    
+    // Remaining quantity is tracked here rather than read from the order: by the time
+    // the engine reports an aggressor's first trade it has already matched all of them
+    void AsyncOrderGateway::routeFill(const OrderId& orderId, const Trade& trade) {
+        Completion completion;
+        std::shared_ptr<CompletionQueue> queue;
+        {
+            std::lock_guard<std::mutex> lock(routeMutex_);
+            auto it = routes_.find(orderId);
+            if (it == routes_.end()) {
+                if (!newsInFlight_.empty()) {
+                    earlyFills_.push_back({fillSequence_++, orderId, trade.getQuantity(), trade.getPrice()});
+                }
+                return;
+            }
+            queue = it->second.queue;
+            completion = Completion{it->second.ticket, CompletionType::FILL, orderId,
+                                    trade.getQuantity(), trade.getPrice()};
+            it->second.remaining -= trade.getQuantity();
+            if (it->second.remaining <= 0) routes_.erase(it);
+        }
+        deliver(queue, std::move(completion));
+    }
+
+    std::uint64_t AsyncOrderGateway::beginNew() {
+        std::lock_guard<std::mutex> lock(routeMutex_);
+        newsInFlight_.insert(fillSequence_);
+        return fillSequence_;
+    }
+    
+    // Held fills older than every NEW still running can belong to none of them
+    void AsyncOrderGateway::endNew(std::uint64_t start) {
+        std::lock_guard<std::mutex> lock(routeMutex_);
+        newsInFlight_.erase(newsInFlight_.find(start));
+        std::uint64_t oldest = newsInFlight_.empty() ? fillSequence_ : *newsInFlight_.begin();
+        while (!earlyFills_.empty() && earlyFills_.front().sequence < oldest) earlyFills_.pop_front();
+    }
+
+} // namespace TradingSystem
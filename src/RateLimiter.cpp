@@ -0,0 +1,25 @@
+#include "../include/RateLimiter.h"
+
+namespace TradingSystem {
+
+    void TokenBucket::configure(double ratePerSecond, double burstSize, double ticksPerSecond) {
+        if (ratePerSecond <= 0.0) {
+            emissionInterval_.store(0, std::memory_order_relaxed);
+            return;
+        }
+        
+        double interval = ticksPerSecond / ratePerSecond;
+        double burst = std::max(burstSize, 1.0);
+        
+        burstTolerance_.store(static_cast<CycleCount>(interval * (burst - 1.0)),
+                              std::memory_order_relaxed);
+        theoreticalArrival_.store(0, std::memory_order_relaxed);
+        emissionInterval_.store(std::max<CycleCount>(static_cast<CycleCount>(interval), 1),
+                                std::memory_order_relaxed);
+    }
+    
+    bool TokenBucket::isLimited() const {
+        return emissionInterval_.load(std::memory_order_relaxed) != 0;
+    }
+
+} // namespace TradingSystem
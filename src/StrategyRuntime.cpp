@@ -0,0 +1,207 @@
+#include "../include/StrategyRuntime.h"
+
+namespace TradingSystem {
+
+    StrategyTask& StrategyTask::operator=(StrategyTask&& other) noexcept {
+        if (this != &other) {
+            if (handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+    
+    StrategyTask::~StrategyTask() {
+        if (handle_) handle_.destroy();
+    }
+    
+    std::optional<Fill> OrderHandle::FillAwaiter::await_resume() {
+        if (state_->fills.empty()) return std::nullopt;
+        Fill fill = state_->fills.front();
+        state_->fills.pop_front();
+        return fill;
+    }
+    
+    StrategySession::StrategySession(StrategyScheduler& scheduler, AsyncOrderGateway& gateway,
+                                     const UserId& userId)
+        : scheduler_(scheduler), gateway_(gateway), userId_(userId), queue_(gateway.connect(userId)) {}
+        
+    StrategySession::PlaceAwaiter StrategySession::place(OrderType orderType, const Symbol& symbol,
+                                                         Quantity quantity, Price price,
+                                                         OrderTimeInForce timeInForce) {
+        auto state = std::make_shared<StrategyOrderState>();
+        state->remaining = quantity;
+        state->ticket = gateway_.submitOrder(userId_, orderType, symbol, quantity, price, timeInForce);
+        if (state->ticket == 0) {
+            state->answered = true;
+            state->open = false;
+        } else {
+            scheduler_.orders_.emplace(state->ticket, state);
+        }
+        return PlaceAwaiter(state);
+    }
+    
+    StrategySession::RequestAwaiter StrategySession::cancel(const OrderHandle& order) {
+        auto state = std::make_shared<StrategyRequestState>();
+        state->orderId = order.getOrderId();
+        state->ticket = order.isOpen() ? gateway_.submitCancel(userId_, state->orderId) : 0;
+        if (state->ticket == 0) state->answered = true;
+        else scheduler_.requests_.emplace(state->ticket, state);
+        return RequestAwaiter(state);
+    }
+    
+    StrategySession::RequestAwaiter StrategySession::modify(const OrderHandle& order, Quantity newQuantity,
+                                                            Price newPrice) {
+        auto state = std::make_shared<StrategyRequestState>();
+        state->orderId = order.getOrderId();
+        state->newQuantity = newQuantity;
+        state->ticket = order.isOpen() ? gateway_.submitModify(userId_, state->orderId, newQuantity, newPrice) : 0;
+        if (state->ticket == 0) state->answered = true;
+        else scheduler_.requests_.emplace(state->ticket, state);
+        return RequestAwaiter(state);
+    }
+    
+    StrategyScheduler::StrategyScheduler(AsyncOrderGateway& gateway)
+        : gateway_(gateway), completions_(POLL_BATCH) {}
+        
+    StrategyScheduler::~StrategyScheduler() {
+        for (auto handle : tasks_) handle.destroy();
+    }
+    
+    StrategySession& StrategyScheduler::session(const UserId& userId) {
+        for (auto& session : sessions_) {
+            if (session->getUserId() == userId) return *session;
+        }
+        sessions_.push_back(std::make_unique<StrategySession>(*this, gateway_, userId));
+        return *sessions_.back();
+    }
+    
+    void StrategyScheduler::spawn(StrategyTask task) {
+        auto handle = task.release();
+        if (!handle) return;
+        tasks_.push_back(handle);
+        ready_.push_back(handle);
+    }
+    
+    size_t StrategyScheduler::getActiveCount() const {
+        return tasks_.size();
+    }
+    
+    void StrategyScheduler::wake(std::coroutine_handle<>& waiter) {
+        if (waiter) ready_.push_back(std::exchange(waiter, nullptr));
+    }
+    
+    void StrategyScheduler::closeOrder(StrategyOrderState& order) {
+        order.open = false;
+        if (!order.orderId.empty()) orderTickets_.erase(order.orderId);
+        wake(order.waiter);
+        orders_.erase(order.ticket);   // may release the last reference to `order`
+    }
+    
+    void StrategyScheduler::dispatch(const Completion& completion) {
+        auto orderIt = orders_.find(completion.ticket);
+        if (orderIt != orders_.end()) {
+            auto order = orderIt->second;   // keeps the state alive through closeOrder
+            switch (completion.type) {
+                case CompletionType::ACCEPTED:
+                    order->answered = true;
+                    order->accepted = true;
+                    order->orderId = completion.orderId;
+                    orderTickets_[completion.orderId] = order->ticket;
+                    wake(order->waiter);
+                    break;
+                case CompletionType::REJECTED:
+                    order->answered = true;
+                    closeOrder(*order);
+                    break;
+                case CompletionType::FILL:
+                    order->fills.push_back(Fill{completion.quantity, completion.price});
+                    order->filled += completion.quantity;
+                    order->remaining -= completion.quantity;
+                    if (order->remaining <= 0) closeOrder(*order);
+                    else wake(order->waiter);
+                    break;
+                case CompletionType::CANCELLED:   // expired
+                    closeOrder(*order);
+                    break;
+                case CompletionType::MODIFIED:
+                    break;
+            }
+            return;
+        }
+        
+        auto requestIt = requests_.find(completion.ticket);
+        if (requestIt == requests_.end()) return;
+        auto request = requestIt->second;
+        requests_.erase(requestIt);
+        request->answered = true;
+        request->succeeded = completion.type != CompletionType::REJECTED;
+        
+        // The order a successful cancel or modify acted on
+        auto ticketIt = orderTickets_.find(request->orderId);
+        if (request->succeeded && ticketIt != orderTickets_.end()) {
+            auto order = orders_[ticketIt->second];
+            if (completion.type == CompletionType::CANCELLED) {
+                closeOrder(*order);
+            } else {
+                order->remaining = request->newQuantity - order->filled;
+            }
+        }
+        wake(request->waiter);
+    }
+    
+    size_t StrategyScheduler::pollSessions() {
+        size_t total = 0;
+        for (auto& session : sessions_) {
+            while (size_t count = session->queue_->poll(completions_.data(), completions_.size())) {
+                for (size_t i = 0; i < count; ++i) dispatch(completions_[i]);
+                total += count;
+                if (count < completions_.size()) break;
+            }
+        }
+        return total;
+    }
+    
+    bool StrategyScheduler::resumeReady() {
+        if (ready_.empty()) return false;
+        std::deque<std::coroutine_handle<>> batch;
+        batch.swap(ready_);
+        for (auto handle : batch) handle.resume();
+        
+        // Reap strategies that ran to completion
+        std::exception_ptr failure;
+        auto finished = std::remove_if(tasks_.begin(), tasks_.end(), [&failure](auto handle) {
+            if (!handle.done()) return false;
+            if (handle.promise().exception && !failure) failure = handle.promise().exception;
+            handle.destroy();
+            return true;
+        });
+        tasks_.erase(finished, tasks_.end());
+        if (failure) std::rethrow_exception(failure);
+        return true;
+    }
+    
+    std::uint64_t StrategyScheduler::run() {
+        std::uint64_t resumptions = 0;
+        int idleRounds = 0;
+        while (!tasks_.empty()) {
+            size_t ready = ready_.size();
+            if (resumeReady()) {
+                resumptions += ready;
+                idleRounds = 0;
+                continue;
+            }
+            if (pollSessions() > 0) {
+                idleRounds = 0;
+                continue;
+            }
+            
+            // Nothing to do until the gateway answers; back off from spinning to
+            // yielding to short sleeps so an idle scheduler leaves its core alone
+            if (++idleRounds < 64) continue;
+            if (idleRounds < 128) std::this_thread::yield();
+            else std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        return resumptions;
+    }
+
+} // namespace TradingSystem
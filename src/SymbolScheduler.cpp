@@ -0,0 +1,344 @@
+#include "../include/SymbolScheduler.h"
+
+namespace TradingSystem {
+
+    namespace {
+        // A blocked worker re-checks for work to steal at least this often, in case
+        // it went to sleep just as a peer queued a symbol without waking anyone
+        constexpr std::chrono::microseconds IDLE_RECHECK{1000};
+    }
+    
+    thread_local const SymbolScheduler* SymbolScheduler::currentScheduler_ = nullptr;
+    thread_local int SymbolScheduler::currentWorker_ = -1;
+    
+    SymbolScheduler::SymbolScheduler(SymbolSchedulerConfig config) : config_(config) {
+        if (config_.workers == 0) config_.workers = std::max(1u, std::thread::hardware_concurrency());
+        config_.quantum = std::max<size_t>(1, config_.quantum);
+        for (size_t i = 0; i < config_.workers; ++i) {
+            workers_.push_back(std::make_unique<Worker>());
+            workers_.back()->index = i;
+        }
+        pinnedSymbol_.assign(config_.workers, nullptr);
+        for (auto& worker : workers_) {
+            worker->thread = std::thread([this, &worker = *worker] { runWorker(worker); });
+        }
+        if (config_.rebalanceInterval.count() > 0) {
+            monitor_ = std::thread([this] { runMonitor(); });
+        }
+    }
+    
+    SymbolScheduler::~SymbolScheduler() {
+        drain();
+        {
+            std::lock_guard<std::mutex> lock(monitorMutex_);
+            stopping_.store(true);
+        }
+        monitorStop_.notify_all();
+        for (auto& worker : workers_) worker->signal.notifyAll();
+        for (auto& worker : workers_) worker->thread.join();
+        if (monitor_.joinable()) monitor_.join();
+    }
+    
+    SymbolScheduler::SymbolQueue* SymbolScheduler::findSymbol(const Symbol& symbol) const {
+        std::shared_lock<std::shared_mutex> lock(symbolsMutex_);
+        auto it = symbols_.find(symbol);
+        return it == symbols_.end() ? nullptr : it->second.get();
+    }
+    
+    SymbolScheduler::SymbolQueue& SymbolScheduler::symbolQueue(const Symbol& symbol) {
+        if (SymbolQueue* queue = findSymbol(symbol)) return *queue;
+        std::unique_lock<std::shared_mutex> lock(symbolsMutex_);
+        auto& queue = symbols_[symbol];
+        if (!queue) {
+            queue = std::make_unique<SymbolQueue>();
+            queue->symbol = symbol;
+            queue->hash = std::hash<Symbol>{}(symbol);
+        }
+        return *queue;
+    }
+    
+    // The symbol's static shard, skipping workers dedicated to a hot symbol
+    size_t SymbolScheduler::homeWorker(const SymbolQueue& queue) const {
+        size_t count = workers_.size();
+        size_t start = queue.hash % count;
+        for (size_t k = 0; k < count; ++k) {
+            size_t index = (start + k) % count;
+            if (!workers_[index]->dedicated.load(std::memory_order_relaxed)) return index;
+        }
+        return start;
+    }
+    
+    void SymbolScheduler::submit(const Symbol& symbol, SymbolCommand command) {
+        SymbolQueue& queue = symbolQueue(symbol);
+        queue.windowCommands.fetch_add(1, std::memory_order_relaxed);
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        
+        bool schedule;
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.commands.push_back(std::move(command));
+            schedule = !queue.scheduled;
+            queue.scheduled = true;
+        }
+        if (schedule) {
+            const Worker* current = currentScheduler_ == this ? workers_[currentWorker_].get() : nullptr;
+            dispatch(queue, current);
+        }
+    }
+    
+    // Queues a symbol that has commands and is not queued or running anywhere. With
+    // work stealing a worker keeps what it schedules itself (the symbol's state is
+    // warm in its cache); everything else goes to the symbol's home worker.
+    void SymbolScheduler::dispatch(SymbolQueue& queue, const Worker* current) {
+        int dedicated = queue.dedicatedWorker.load(std::memory_order_acquire);
+        size_t target;
+        if (dedicated >= 0) {
+            target = static_cast<size_t>(dedicated);
+        } else if (config_.workStealing && current && !current->dedicated.load(std::memory_order_relaxed)) {
+            target = current->index;
+        } else {
+            target = homeWorker(queue);
+        }
+        
+        Worker& worker = *workers_[target];
+        bool backlog;
+        {
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.runnable.push_back(&queue);
+            backlog = &worker != current || worker.runnable.size() > 1;
+        }
+        if (&worker != current) worker.signal.notify();
+        if (config_.workStealing && dedicated < 0 && backlog) wakeThief(worker);
+    }
+    
+    // The target may be busy: wake one blocked pool worker to come and steal.
+    // Spinning workers look for work to steal on their own.
+    void SymbolScheduler::wakeThief(const Worker& busy) {
+        size_t count = workers_.size();
+        for (size_t k = 1; k < count; ++k) {
+            Worker& worker = *workers_[(busy.index + k) % count];
+            if (worker.dedicated.load(std::memory_order_relaxed)) continue;
+            if (worker.signal.hasBlockedWaiter()) {
+                worker.signal.notify();
+                return;
+            }
+        }
+    }
+    
+    // Takes the most recently queued symbol of the first pool worker that has a
+    // backlog; the owner keeps working from the front of its queue
+    SymbolScheduler::SymbolQueue* SymbolScheduler::steal(Worker& thief) {
+        size_t count = workers_.size();
+        for (size_t k = 1; k < count; ++k) {
+            Worker& victim = *workers_[(thief.index + k) % count];
+            if (victim.dedicated.load(std::memory_order_relaxed)) continue;
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.runnable.empty()) continue;
+            SymbolQueue* queue = victim.runnable.back();
+            victim.runnable.pop_back();
+            steals_.fetch_add(1, std::memory_order_relaxed);
+            return queue;
+        }
+        return nullptr;
+    }
+    
+    void SymbolScheduler::runSymbol(SymbolQueue& queue, Worker& worker, std::vector<SymbolCommand>& batch) {
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            size_t count = std::min(config_.quantum, queue.commands.size());
+            for (size_t i = 0; i < count; ++i) {
+                batch.push_back(std::move(queue.commands.front()));
+                queue.commands.pop_front();
+            }
+        }
+        for (auto& command : batch) {
+            try {
+                command();
+            } catch (...) {
+                failed_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        size_t count = batch.size();
+        batch.clear();
+        worker.executed.fetch_add(count, std::memory_order_relaxed);
+        
+        bool more;
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            more = !queue.commands.empty();
+            if (!more) queue.scheduled = false;
+        }
+        if (more) dispatch(queue, &worker);
+        
+        if (pending_.fetch_sub(count, std::memory_order_acq_rel) == count) {
+            std::lock_guard<std::mutex> lock(drainMutex_);
+            drained_.notify_all();
+        }
+    }
+    
+    void SymbolScheduler::runWorker(Worker& worker) {
+        currentScheduler_ = this;
+        currentWorker_ = static_cast<int>(worker.index);
+        ThreadPlacement::apply(config_.threads, worker.index);
+        std::vector<SymbolCommand> batch;
+        batch.reserve(config_.quantum);
+        
+        for (;;) {
+            std::uint32_t seen = worker.signal.epoch();
+            SymbolQueue* queue = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(worker.mutex);
+                if (!worker.runnable.empty()) {
+                    queue = worker.runnable.front();
+                    worker.runnable.pop_front();
+                }
+            }
+            if (!queue && config_.workStealing && !worker.dedicated.load(std::memory_order_relaxed)) {
+                queue = steal(worker);
+            }
+            if (queue) {
+                runSymbol(*queue, worker, batch);
+                continue;
+            }
+            
+            if (stopping_.load()) return;   // only set once every command has run
+            worker.signal.wait(seen, config_.threads.waitStrategy, IDLE_RECHECK, config_.threads.spinIterations);
+        }
+    }
+    
+    void SymbolScheduler::drain() {
+        std::unique_lock<std::mutex> lock(drainMutex_);
+        drained_.wait(lock, [this] { return pending_.load(std::memory_order_acquire) == 0; });
+    }
+    
+    void SymbolScheduler::runMonitor() {
+        std::unique_lock<std::mutex> lock(monitorMutex_);
+        while (!monitorStop_.wait_for(lock, config_.rebalanceInterval, [this] { return stopping_.load(); })) {
+            lock.unlock();
+            rebalance();
+            lock.lock();
+        }
+    }
+    
+    // A pinned symbol moves to its worker the next time it is queued; whatever was
+    // already queued on that worker still runs there once
+    bool SymbolScheduler::pinLocked(SymbolQueue& queue, size_t worker) {
+        if (worker >= workers_.size()) return false;
+        if (queue.dedicatedWorker.load() == static_cast<int>(worker)) return true;
+        if (workers_[worker]->dedicated.load()) return false;
+        
+        size_t pool = 0;
+        for (const auto& w : workers_) {
+            if (!w->dedicated.load()) ++pool;
+        }
+        bool alreadyPinned = queue.dedicatedWorker.load() >= 0;
+        if (pool <= 1 && !alreadyPinned) return false;
+        
+        unpinLocked(queue);
+        workers_[worker]->dedicated.store(true);
+        pinnedSymbol_[worker] = &queue;
+        queue.dedicatedWorker.store(static_cast<int>(worker), std::memory_order_release);
+        return true;
+    }
+    
+    void SymbolScheduler::unpinLocked(SymbolQueue& queue) {
+        int worker = queue.dedicatedWorker.load();
+        if (worker < 0) return;
+        queue.dedicatedWorker.store(-1, std::memory_order_release);
+        queue.autoPinned = false;
+        pinnedSymbol_[worker] = nullptr;
+        workers_[worker]->dedicated.store(false);
+    }
+    
+    bool SymbolScheduler::pin(const Symbol& symbol, size_t worker) {
+        SymbolQueue& queue = symbolQueue(symbol);
+        std::lock_guard<std::mutex> lock(pinMutex_);
+        if (!pinLocked(queue, worker)) return false;
+        queue.autoPinned = false;
+        return true;
+    }
+    
+    bool SymbolScheduler::unpin(const Symbol& symbol) {
+        SymbolQueue* queue = findSymbol(symbol);
+        if (!queue) return false;
+        std::lock_guard<std::mutex> lock(pinMutex_);
+        if (queue->dedicatedWorker.load() < 0) return false;
+        unpinLocked(*queue);
+        return true;
+    }
+    
+    int SymbolScheduler::getDedicatedWorker(const Symbol& symbol) const {
+        SymbolQueue* queue = findSymbol(symbol);
+        return queue ? queue->dedicatedWorker.load() : -1;
+    }
+    
+    std::vector<SymbolLoad> SymbolScheduler::rebalance() {
+        std::vector<std::pair<SymbolQueue*, std::uint64_t>> counts;
+        {
+            std::shared_lock<std::shared_mutex> lock(symbolsMutex_);
+            counts.reserve(symbols_.size());
+            for (auto& entry : symbols_) counts.emplace_back(entry.second.get(), 0);
+        }
+        
+        std::lock_guard<std::mutex> lock(pinMutex_);
+        std::uint64_t total = 0;
+        for (auto& entry : counts) {
+            entry.second = entry.first->windowCommands.exchange(0, std::memory_order_relaxed);
+            total += entry.second;
+        }
+        std::sort(counts.begin(), counts.end(),
+                  [](const auto& a, const auto& b) { return a.second > b.second; });
+        auto share = [total](std::uint64_t commands) {
+            return total == 0 ? 0.0 : static_cast<double>(commands) / static_cast<double>(total);
+        };
+        
+        // Release cooled-down symbols first so their workers can go to new hot ones
+        size_t autoPinned = 0;
+        for (auto& entry : counts) {
+            if (!entry.first->autoPinned) continue;
+            if (share(entry.second) < config_.hotShare) unpinLocked(*entry.first);
+            else ++autoPinned;
+        }
+        // Dedicate the highest-numbered free workers, keeping the low ones as the pool
+        for (auto& entry : counts) {
+            if (autoPinned >= config_.maxDedicated || share(entry.second) < config_.hotShare) break;
+            if (entry.first->dedicatedWorker.load() >= 0) continue;
+            for (size_t worker = workers_.size(); worker-- > 0;) {
+                if (pinLocked(*entry.first, worker)) {
+                    entry.first->autoPinned = true;
+                    ++autoPinned;
+                    break;
+                }
+            }
+        }
+        
+        std::vector<SymbolLoad> loads;
+        loads.reserve(counts.size());
+        for (const auto& entry : counts) {
+            loads.push_back(SymbolLoad{entry.first->symbol, entry.second, share(entry.second),
+                                       entry.first->dedicatedWorker.load()});
+        }
+        return loads;
+    }
+    
+    SymbolSchedulerStats SymbolScheduler::getStats() const {
+        SymbolSchedulerStats stats;
+        for (const auto& worker : workers_) {
+            std::uint64_t executed = worker->executed.load(std::memory_order_relaxed);
+            stats.executedPerWorker.push_back(executed);
+            stats.executed += executed;
+        }
+        stats.failed = failed_.load(std::memory_order_relaxed);
+        stats.steals = steals_.load(std::memory_order_relaxed);
+        return stats;
+    }
+    
+    size_t SymbolScheduler::getWorkerCount() const {
+        return workers_.size();
+    }
+    
+    int SymbolScheduler::currentWorker() const {
+        return currentScheduler_ == this ? currentWorker_ : -1;
+    }
+
+} // namespace TradingSystem
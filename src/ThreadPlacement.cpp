@@ -0,0 +1,150 @@
+#include "../include/ThreadPlacement.h"
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <cstdlib>
+#include <filesystem>
+
+namespace TradingSystem {
+
+    namespace {
+        int parseInt(const std::string& text, const std::string& context) {
+            size_t used = 0;
+            int value = -1;
+            try {
+                value = std::stoi(text, &used);
+            } catch (const std::exception&) {
+                used = 0;
+            }
+            if (used == 0 || used != text.size() || value < 0) {
+                throw std::invalid_argument("bad number '" + text + "' in " + context);
+            }
+            return value;
+        }
+        
+        bool parseFlag(const std::string& text, const std::string& context) {
+            if (text == "1" || text == "on") return true;
+            if (text == "0" || text == "off") return false;
+            throw std::invalid_argument("bad flag '" + text + "' in " + context);
+        }
+        
+        // `wait`, `spin` and `numa` settings; false if `key` is none of them
+        bool applySetting(ThreadGroupConfig& group, const std::string& key, const std::string& value,
+                          const std::string& token) {
+            if (key == "wait") group.waitStrategy = parseWaitStrategy(value);
+            else if (key == "spin") group.spinIterations = static_cast<std::uint32_t>(parseInt(value, token));
+            else if (key == "numa") group.numaLocalMemory = parseFlag(value, token);
+            else return false;
+            return true;
+        }
+    }
+    
+    ThreadGroupConfig ThreadLayout::group(const std::string& role) const {
+        auto it = groups.find(role);
+        return it == groups.end() ? defaults : it->second;
+    }
+    
+    // Defaults first, whatever their position in the spec, so every role inherits them
+    ThreadLayout ThreadLayout::parse(const std::string& spec) {
+        std::vector<std::pair<std::string, std::string>> settings;
+        std::stringstream stream(spec);
+        std::string token;
+        while (stream >> token) {
+            size_t equals = token.find('=');
+            if (equals == std::string::npos || equals == 0 || equals + 1 == token.size()) {
+                throw std::invalid_argument("expected key=value, got '" + token + "'");
+            }
+            settings.emplace_back(token.substr(0, equals), token.substr(equals + 1));
+        }
+        
+        ThreadLayout layout;
+        for (const auto& [key, value] : settings) {
+            applySetting(layout.defaults, key, value, key + "=" + value);
+        }
+        for (const auto& [key, value] : settings) {
+            std::string context = key + "=" + value;
+            size_t dot = key.find('.');
+            if (dot == std::string::npos) {
+                if (key == "wait" || key == "spin" || key == "numa") continue;
+                layout.groups.emplace(key, layout.defaults).first->second.cpus = ThreadPlacement::parseCpuList(value);
+                continue;
+            }
+            auto& group = layout.groups.emplace(key.substr(0, dot), layout.defaults).first->second;
+            if (!applySetting(group, key.substr(dot + 1), value, context)) {
+                throw std::invalid_argument("unknown setting " + context);
+            }
+        }
+        return layout;
+    }
+    
+    ThreadLayout ThreadLayout::fromEnvironment(const char* variable) {
+        const char* spec = std::getenv(variable);
+        return spec ? parse(spec) : ThreadLayout();
+    }
+    
+    std::vector<int> ThreadPlacement::parseCpuList(const std::string& list) {
+        std::vector<int> cpus;
+        std::stringstream stream(list);
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            size_t dash = item.find('-');
+            int first = parseInt(item.substr(0, dash), list);
+            int last = dash == std::string::npos ? first : parseInt(item.substr(dash + 1), list);
+            if (last < first) throw std::invalid_argument("descending CPU range in " + list);
+            for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+        }
+        if (cpus.empty()) throw std::invalid_argument("empty CPU list");
+        return cpus;
+    }
+    
+    int ThreadPlacement::cpuCount() {
+        long count = sysconf(_SC_NPROCESSORS_CONF);
+        return count > 0 ? static_cast<int>(count) : 1;
+    }
+    
+    int ThreadPlacement::currentCpu() {
+        return sched_getcpu();
+    }
+    
+    int ThreadPlacement::numaNodeOf(int cpu) {
+        std::error_code error;
+        std::filesystem::directory_iterator entries("/sys/devices/system/cpu/cpu" + std::to_string(cpu), error);
+        if (error) return -1;
+        for (const auto& entry : entries) {
+            std::string name = entry.path().filename().string();
+            if (name.size() > 4 && name.compare(0, 4, "node") == 0 &&
+                std::all_of(name.begin() + 4, name.end(), ::isdigit)) {
+                return std::atoi(name.c_str() + 4);
+            }
+        }
+        return -1;
+    }
+    
+    bool ThreadPlacement::pinCurrentThread(int cpu) {
+        if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+    }
+    
+    bool ThreadPlacement::preferNumaNode(int node) {
+        if (node < 0 || node >= 64) return false;
+        unsigned long mask = 1UL << node;
+        return syscall(SYS_set_mempolicy, MPOL_PREFERRED, &mask, 64UL) == 0;
+    }
+    
+    bool ThreadPlacement::apply(const ThreadGroupConfig& group, size_t index) {
+        if (group.cpus.empty()) return true;
+        int cpu = group.cpus[index % group.cpus.size()];
+        if (!pinCurrentThread(cpu)) return false;
+        if (group.numaLocalMemory) {
+            int node = numaNodeOf(cpu);
+            if (node >= 0) preferNumaNode(node);   // best effort: placement still holds without it
+        }
+        return true;
+    }
+
+} // namespace TradingSystem
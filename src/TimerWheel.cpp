@@ -0,0 +1,127 @@
+#include "../include/TimerWheel.h"
+#include <algorithm>
+#include <limits>
+
+namespace TradingSystem {
+
+    TimerWheel::TimerWheel(Tick startTick) : currentTick_(startTick), size_(0), rootCount_(0) {
+        levels_[0].resize(ROOT_SIZE);
+        for (int level = 1; level < LEVELS; ++level) {
+            levels_[level].resize(LEVEL_SIZE);
+        }
+    }
+    
+    int TimerWheel::levelShift(int level) {
+        return level == 0 ? 0 : ROOT_BITS + LEVEL_BITS * (level - 1);
+    }
+    
+    void TimerWheel::schedule(Tick expiry, Tick nowTick, std::shared_ptr<Order> order) {
+        if (size_ == 0 && nowTick > currentTick_) currentTick_ = nowTick;
+        
+        // Anything already due fires on the next tick
+        place({std::max(expiry, currentTick_ + 1), std::move(order)});
+        ++size_;
+    }
+    
+    void TimerWheel::place(Timer timer) {
+        // A cascade can hand down a timer due on the current tick: it lands in the
+        // current root slot, which advance() fires right after the cascade
+        Tick delta = timer.expiry - currentTick_;
+        
+        for (int level = 0; level < LEVELS; ++level) {
+            int span = levelShift(level) + (level == 0 ? ROOT_BITS : LEVEL_BITS);
+            if (delta < (Tick(1) << span)) {
+                Tick mask = (level == 0 ? ROOT_SIZE : LEVEL_SIZE) - 1;
+                Tick index = (timer.expiry >> levelShift(level)) & mask;
+                levels_[level][index].push_back(std::move(timer));
+                if (level == 0) ++rootCount_;
+                return;
+            }
+        }
+        
+        overflow_.push_back(std::move(timer));
+    }
+    
+    // Re-distributes the slot of `level` that starts at the current tick
+    void TimerWheel::cascade(int level) {
+        if (level >= LEVELS) {
+            Slot pending;
+            pending.swap(overflow_);
+            for (auto& timer : pending) place(std::move(timer));
+            return;
+        }
+        
+        Tick index = (currentTick_ >> levelShift(level)) & (LEVEL_SIZE - 1);
+        if (index == 0) cascade(level + 1);
+        
+        Slot pending;
+        pending.swap(levels_[level][index]);
+        for (auto& timer : pending) place(std::move(timer));
+    }
+    
+    // First tick at which a non-empty slot of levels 1+ (or the overflow list) is
+    // cascaded. A slot is cascaded at its start tick, so the distance to the next
+    // occupied slot of each level gives its cascade tick directly
+    TimerWheel::Tick TimerWheel::nextCascadeTick() const {
+        Tick next = std::numeric_limits<Tick>::max();
+        for (int level = 1; level < LEVELS; ++level) {
+            int shift = levelShift(level);
+            Tick current = (currentTick_ >> shift) & (LEVEL_SIZE - 1);
+            for (Tick distance = 1; distance <= LEVEL_SIZE; ++distance) {
+                if (!levels_[level][(current + distance) & (LEVEL_SIZE - 1)].empty()) {
+                    next = std::min(next, ((currentTick_ >> shift) + distance) << shift);
+                    break;
+                }
+            }
+        }
+        
+        // The overflow list is re-placed whenever the top level wraps
+        if (!overflow_.empty()) {
+            int span = levelShift(LEVELS - 1) + LEVEL_BITS;
+            next = std::min(next, ((currentTick_ >> span) + 1) << span);
+        }
+        return next;
+    }
+    
+    void TimerWheel::advance(Tick nowTick, std::vector<std::shared_ptr<Order>>& due) {
+        while (currentTick_ < nowTick) {
+            // Nothing scheduled: jump straight to the target tick
+            if (size_ == 0) {
+                currentTick_ = nowTick;
+                return;
+            }
+            
+            // Empty root wheel: skip to the last tick before the next cascade that
+            // has timers to re-distribute
+            if (rootCount_ == 0) {
+                Tick next = nextCascadeTick();
+                if (next > nowTick) {
+                    currentTick_ = nowTick;
+                    return;
+                }
+                currentTick_ = next - 1;
+            }
+            
+            ++currentTick_;
+            Tick index = currentTick_ & (ROOT_SIZE - 1);
+            if (index == 0) cascade(1);
+            
+            Slot& slot = levels_[0][index];
+            for (auto& timer : slot) {
+                due.push_back(std::move(timer.order));
+            }
+            size_ -= slot.size();
+            rootCount_ -= slot.size();
+            slot.clear();
+        }
+    }
+    
+    size_t TimerWheel::size() const { return size_; }
+    TimerWheel::Tick TimerWheel::getCurrentTick() const { return currentTick_; }
+    
+    TimerWheel::Tick TimerWheel::toTick(const Timestamp& timestamp) {
+        return static_cast<Tick>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            timestamp.time_since_epoch()).count());
+    }
+
+} // namespace TradingSystem
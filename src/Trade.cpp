@@ -4,11 +4,12 @@ namespace TradingSystem {
 
     Trade::Trade(const TradeId& tradeId, OrderType tradeType,
               const OrderId& buyerOrderId, const OrderId& sellerOrderId,
-              const Symbol& symbol, Quantity quantity, Price price)
+              const Symbol& symbol, Quantity quantity, Price price,
+              const Clock& clock)
         : tradeId_(tradeId), tradeType_(tradeType),
           buyerOrderId_(buyerOrderId), sellerOrderId_(sellerOrderId),
           symbol_(symbol), quantity_(quantity), price_(price),
-          timestamp_(getCurrentTimestamp()) {}
+          executionTicks_(clock.now()), clock_(&clock) {}
     
     const TradeId& Trade::getTradeId() const { return tradeId_; }
     OrderType Trade::getTradeType() const { return tradeType_; }
@@ -17,6 +18,7 @@ namespace TradingSystem {
     const Symbol& Trade::getSymbol() const { return symbol_; }
     Quantity Trade::getQuantity() const { return quantity_; }
     Price Trade::getPrice() const { return price_; }
-    const Timestamp& Trade::getTimestamp() const { return timestamp_; }
+    Timestamp Trade::getTimestamp() const { return clock_->toTimestamp(executionTicks_); }
+    CycleCount Trade::getExecutionTicks() const { return executionTicks_; }
 
 } // namespace TradingSystem
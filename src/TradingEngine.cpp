@@ -2,15 +2,16 @@
 
 namespace TradingSystem {
 
-    TradingEngine* TradingEngine::instance_ = nullptr;
-    std::mutex TradingEngine::instanceMutex_;
+    TradingEngine::TradingEngine(std::shared_ptr<const Clock> clock,
+                                 std::shared_ptr<IdGenerator> idGenerator)
+        : clock_(clock ? std::move(clock)
+                       : std::shared_ptr<const Clock>(&RealTimeClock::instance(), [](const Clock*) {})),
+          idGenerator_(idGenerator ? std::move(idGenerator)
+                                   : std::shared_ptr<IdGenerator>(&UuidGenerator::instance(), [](IdGenerator*) {})) {}
     
     TradingEngine& TradingEngine::getInstance() {
-        std::lock_guard lock(instanceMutex_);
-        if (!instance_) {
-            instance_ = new TradingEngine();
-        }
-        return *instance_;
+        static TradingEngine instance;
+        return instance;
     }
     
     bool TradingEngine::registerUser(const std::shared_ptr<User>& user) {
@@ -27,54 +28,249 @@ namespace TradingSystem {
         return it != users_.end() ? it->second : nullptr;
     }
     
+    bool TradingEngine::setUserThrottle(const UserId& userId, const ThrottleConfig& config) {
+        auto user = getUser(userId);
+        if (!user) return false;
+        user->setThrottle(config, clock_->ticksPerSecond());
+        return true;
+    }
+    
     std::shared_ptr<Order> TradingEngine::placeOrder(const UserId& userId, OrderType orderType,
                                          const Symbol& symbol, Quantity quantity, 
                                          Price price) {
-        if (!getUser(userId)) return nullptr;
+        return placeOrder(userId, orderType, symbol, quantity, price, OrderTimeInForce::GTC);
+    }
+    
+    std::shared_ptr<Order> TradingEngine::placeOrder(const UserId& userId, OrderType orderType,
+                                         const Symbol& symbol, Quantity quantity,
+                                         Price price, OrderTimeInForce timeInForce,
+                                         Timestamp expireTime) {
+        LatencyTimer timer(LatencyMetric::PLACE_ORDER);
         
-        OrderId orderId = generateUUID();
-        std::unique_ptr<Order> order;
+        auto user = admitNewOrder(userId);
+        if (!user) return nullptr;
         
         // Validate price before creating order
         if (price < 0) {
             return nullptr; // Reject negative prices immediately
         }
         
+        std::unique_ptr<Order> order;
+        
         if (price > 0) {
-            order = std::make_unique<LimitOrder>(orderId, userId, orderType, symbol, quantity, price);
+            order = newOrder<LimitOrder>(userId, orderType, symbol, quantity, price);
         } else {
-            order = std::make_unique<MarketOrder>(orderId, userId, orderType, symbol, quantity);
+            order = newOrder<MarketOrder>(userId, orderType, symbol, quantity);
         }
         
-        if (!order->isValid()) return nullptr;
+        if (!order->setTimeInForce(timeInForce, expireTime)) return nullptr;
         
-        auto orderBook = getOrCreateOrderBook(symbol);
-        if (!orderBook) return nullptr;
+        return submitOrder(std::move(order), *user);
+    }
+    
+    namespace {
+        // Per-thread working set of placeOrders, reused so a batch costs no heap
+        // allocation beyond the orders and trades themselves. An observer that places
+        // a batch from its callback gets a fresh set instead of clobbering this one
+        struct BatchScratch {
+            std::vector<std::shared_ptr<User>> users;
+            std::vector<OrderBook*> books;
+            std::vector<std::shared_ptr<Order>> orders;
+            std::unordered_map<OrderBook*, size_t> firstIndex;
+            std::vector<std::pair<size_t, size_t>> byBook;
+            std::vector<std::shared_ptr<Order>> run;
+            std::vector<size_t> tradeEnds;
+            std::vector<std::shared_ptr<Trade>> trades;
+            std::vector<TradeObserver*> observers;
+            bool inUse = false;
+            
+            void release() {
+                users.clear();
+                orders.clear();
+                run.clear();
+                trades.clear();
+                inUse = false;
+            }
+        };
         
-        auto sharedOrder = std::shared_ptr<Order>(order.release());
+        thread_local BatchScratch batchScratch;
+    }
+    
+    size_t TradingEngine::placeOrders(std::span<const OrderRequest> requests,
+                                      std::span<std::shared_ptr<Order>> results) {
+        LatencyTimer timer(LatencyMetric::PLACE_ORDER_BATCH);
         
-        // Store order in allOrders before adding to order book
+        const size_t count = std::min(requests.size(), results.size());
+        std::fill(results.begin(), results.end(), nullptr);
+        if (count == 0 || killSwitch_.load(std::memory_order_relaxed)) return 0;
+        
+        BatchScratch nested;
+        BatchScratch& scratch = batchScratch.inUse ? nested : batchScratch;
+        scratch.inUse = true;
+        auto& users = scratch.users;
+        auto& books = scratch.books;
+        auto& orders = scratch.orders;
+        users.assign(count, nullptr);
+        books.assign(count, nullptr);
+        orders.assign(count, nullptr);
+        
+        // One shared lock resolves every user and existing book in the batch
         {
-            std::unique_lock lock(mutex_);
-            allOrders_[sharedOrder->getOrderId()] = sharedOrder;
+            std::shared_lock lock(mutex_);
+            for (size_t i = 0; i < count; ++i) {
+                auto userIt = users_.find(requests[i].userId);
+                if (userIt != users_.end()) users[i] = userIt->second;
+                auto bookIt = orderBooks_.find(requests[i].symbol);
+                if (bookIt != orderBooks_.end()) books[i] = bookIt->second.get();
+            }
+            scratch.observers = observers_;
         }
         
-        if (orderBook->addOrder(sharedOrder)) {
-            notifyOrderStatusChanged(sharedOrder);
+        // Admission and validation in request order, exactly as placeOrder does them
+        bool missingBook = false;
+        for (size_t i = 0; i < count; ++i) {
+            const OrderRequest& request = requests[i];
+            const auto& user = users[i];
+            if (!user || user->isKillSwitchActive() || !user->admitOrder(clock_->now())) continue;
+            if (request.price < 0) continue;
             
-            auto trades = orderBook->matchOrders();
-            for (const auto& trade : trades) {
-                notifyTradeExecuted(trade);
+            std::unique_ptr<Order> order;
+            if (request.price > 0) {
+                order = newOrder<LimitOrder>(request.userId, request.orderType, request.symbol,
+                                             request.quantity, request.price);
+            } else {
+                order = newOrder<MarketOrder>(request.userId, request.orderType, request.symbol,
+                                              request.quantity);
             }
+            if (!order->setTimeInForce(request.timeInForce, request.expireTime) || !order->isValid()) continue;
             
-            return sharedOrder;
+            orders[i] = std::shared_ptr<Order>(order.release());
+            missingBook |= books[i] == nullptr;
         }
         
-        return nullptr;
+        // One exclusive lock registers the orders and creates any new books
+        {
+            std::unique_lock lock(mutex_);
+            for (size_t i = 0; i < count; ++i) {
+                if (!orders[i]) continue;
+                if (missingBook && !books[i]) {
+                    auto& book = orderBooks_[requests[i].symbol];
+                    if (!book) book = std::make_unique<OrderBook>(requests[i].symbol, *clock_, *idGenerator_);
+                    books[i] = book.get();
+                }
+                allOrders_[orders[i]->getOrderId()] = orders[i];
+            }
+        }
+        
+        // One run per book: sorting (first index of the book, index) pairs groups the
+        // batch, runs books in the order they first appear and keeps arrival order
+        // within each run, so trade ids do not depend on where the books live in memory
+        auto& firstIndex = scratch.firstIndex;
+        auto& byBook = scratch.byBook;
+        firstIndex.clear();
+        byBook.clear();
+        for (size_t i = 0; i < count; ++i) {
+            if (orders[i]) byBook.emplace_back(firstIndex.try_emplace(books[i], i).first->second, i);
+        }
+        std::sort(byBook.begin(), byBook.end());
+        
+        size_t placed = 0;
+        auto& run = scratch.run;
+        auto& tradeEnds = scratch.tradeEnds;
+        auto& trades = scratch.trades;
+        for (size_t first = 0, last = 0; first < byBook.size(); first = last) {
+            OrderBook* book = books[byBook[first].first];
+            run.clear();
+            for (last = first; last < byBook.size() && byBook[last].first == byBook[first].first; ++last) {
+                run.push_back(orders[byBook[last].second]);
+            }
+            expireDue(*book);
+            tradeEnds.resize(run.size());
+            trades.clear();
+            placed += book->addOrders(run.data(), run.size(), trades, tradeEnds.data());
+            
+            LatencyTimer dispatchTimer(LatencyMetric::OBSERVER_DISPATCH);
+            size_t tradeIndex = 0;
+            for (size_t k = 0; k < run.size(); ++k) {
+                size_t index = byBook[first + k].second;
+                if (run[k] && cancelIfFrozen(*book, *users[index], run[k])) {
+                    run[k].reset();
+                    --placed;
+                }
+                if (run[k]) {
+                    results[index] = run[k];
+                    for (auto observer : scratch.observers) {
+                        if (observer) observer->onOrderStatusChanged(run[k]);
+                    }
+                }
+                for (; tradeIndex < tradeEnds[k]; ++tradeIndex) {
+                    for (auto observer : scratch.observers) {
+                        if (observer) observer->onTradeExecuted(trades[tradeIndex]);
+                    }
+                }
+            }
+        }
+        
+        scratch.release();
+        return placed;
+    }
+    
+    std::shared_ptr<Order> TradingEngine::placeStopOrder(const UserId& userId, OrderType orderType,
+                                         const Symbol& symbol, Quantity quantity,
+                                         Price stopPrice, Price limitPrice) {
+        LatencyTimer timer(LatencyMetric::PLACE_ORDER);
+        
+        auto user = admitNewOrder(userId);
+        if (!user) return nullptr;
+        
+        if (stopPrice <= 0 || limitPrice < 0) {
+            return nullptr;
+        }
+        
+        std::unique_ptr<Order> order;
+        
+        if (limitPrice > 0) {
+            order = newOrder<StopLimitOrder>(userId, orderType, symbol, quantity, stopPrice, limitPrice);
+        } else {
+            order = newOrder<StopOrder>(userId, orderType, symbol, quantity, stopPrice);
+        }
+        
+        return submitOrder(std::move(order), *user);
+    }
+    
+    std::shared_ptr<Order> TradingEngine::placeIcebergOrder(const UserId& userId, OrderType orderType,
+                                         const Symbol& symbol, Quantity quantity,
+                                         Price price, Quantity peakQuantity) {
+        LatencyTimer timer(LatencyMetric::PLACE_ORDER);
+        
+        auto user = admitNewOrder(userId);
+        if (!user) return nullptr;
+        
+        if (price <= 0) {
+            return nullptr; // Icebergs are always limit orders
+        }
+        
+        return submitOrder(newOrder<IcebergOrder>(userId, orderType, symbol, quantity,
+                                                  price, peakQuantity), *user);
+    }
+    
+    std::shared_ptr<Order> TradingEngine::placePeggedOrder(const UserId& userId, OrderType orderType,
+                                         const Symbol& symbol, Quantity quantity,
+                                         PegType pegType, Price offset) {
+        LatencyTimer timer(LatencyMetric::PLACE_ORDER);
+        
+        auto user = admitNewOrder(userId);
+        if (!user) return nullptr;
+        
+        return submitOrder(newOrder<PeggedOrder>(userId, orderType, symbol, quantity,
+                                                 pegType, offset), *user);
     }
     
     bool TradingEngine::cancelOrder(const UserId& userId, const OrderId& orderId) {
-        if (!getUser(userId)) return false;
+        LatencyTimer timer(LatencyMetric::CANCEL_ORDER);
+        
+        auto user = getUser(userId);
+        if (!user || !user->admitMessage(clock_->now())) return false;
         
         // Check if order exists and belongs to user
         std::shared_ptr<Order> order;
@@ -103,7 +299,13 @@ namespace TradingSystem {
     
     bool TradingEngine::modifyOrder(const UserId& userId, const OrderId& orderId,
                         Quantity newQuantity, Price newPrice) {
-        if (!getUser(userId)) return false;
+        LatencyTimer timer(LatencyMetric::MODIFY_ORDER);
+        
+        if (killSwitch_.load(std::memory_order_relaxed)) return false;
+        
+        auto user = getUser(userId);
+        if (!user || user->isKillSwitchActive()) return false;
+        if (!user->admitMessage(clock_->now())) return false;
         
         // Validate price before attempting modification
         if (newPrice < 0) {
@@ -134,6 +336,8 @@ namespace TradingSystem {
             orderBook = bookIt->second.get();
         }
         
+        expireDue(*orderBook);
+        
         // Perform modification
         if (orderBook->modifyOrder(orderId, newQuantity, newPrice)) {
             // Get the updated order
@@ -158,6 +362,10 @@ namespace TradingSystem {
         return false;
     }
     
+    const Clock& TradingEngine::getClock() const {
+        return *clock_;
+    }
+    
     std::shared_ptr<Order> TradingEngine::getOrderStatus(const UserId& userId, const OrderId& orderId) const {
         if (!getUser(userId)) return nullptr;
         
@@ -187,6 +395,175 @@ namespace TradingSystem {
         return userOrders;
     }
     
+    size_t TradingEngine::processExpirations() {
+        return processExpirations(clock_->currentTimestamp());
+    }
+    
+    size_t TradingEngine::processExpirations(Timestamp now) {
+        std::vector<OrderBook*> books;
+        {
+            std::shared_lock lock(mutex_);
+            for (const auto& [symbol, orderBook] : orderBooks_) {
+                books.push_back(orderBook.get());
+            }
+        }
+        
+        size_t expiredCount = 0;
+        for (auto orderBook : books) {
+            for (const auto& order : orderBook->expireOrders(now)) {
+                notifyOrderStatusChanged(order);
+                ++expiredCount;
+            }
+        }
+        
+        return expiredCount;
+    }
+    
+    size_t TradingEngine::endTradingSession() {
+        std::vector<OrderBook*> books;
+        {
+            std::shared_lock lock(mutex_);
+            for (const auto& [symbol, orderBook] : orderBooks_) {
+                books.push_back(orderBook.get());
+            }
+        }
+        
+        size_t expiredCount = 0;
+        for (auto orderBook : books) {
+            for (const auto& order : orderBook->endSession()) {
+                notifyOrderStatusChanged(order);
+                ++expiredCount;
+            }
+        }
+        
+        return expiredCount;
+    }
+    
+    void TradingEngine::beginCallAuction(const Symbol& symbol) {
+        OrderBook* orderBook = getOrCreateOrderBook(symbol);
+        if (orderBook) orderBook->beginCallAuction();
+    }
+    
+    size_t TradingEngine::uncrossAuction(const Symbol& symbol) {
+        OrderBook* orderBook = findOrderBook(symbol);
+        if (!orderBook) return 0;
+        
+        auto trades = orderBook->uncrossAuction();
+        for (const auto& trade : trades) {
+            notifyTradeExecuted(trade);
+        }
+        return trades.size();
+    }
+    
+    AuctionIndicative TradingEngine::getIndicativeAuction(const Symbol& symbol) const {
+        OrderBook* orderBook = findOrderBook(symbol);
+        return orderBook ? orderBook->getIndicativeAuction() : AuctionIndicative();
+    }
+    
+    void TradingEngine::setBatchAuctionInterval(const Symbol& symbol,
+                                                std::chrono::microseconds interval) {
+        OrderBook* orderBook = getOrCreateOrderBook(symbol);
+        if (!orderBook) return;
+        
+        bool wasBatching = orderBook->isBatchMode();
+        orderBook->setBatchInterval(interval);
+        
+        // Leaving batch mode: flush whatever is still buffered
+        if (wasBatching && interval.count() == 0) {
+            for (const auto& trade : orderBook->runBatchAuction(true)) {
+                notifyTradeExecuted(trade);
+            }
+            for (const auto& trade : orderBook->matchOrders()) {
+                notifyTradeExecuted(trade);
+            }
+        }
+    }
+    
+    size_t TradingEngine::runBatchAuctions() {
+        std::vector<OrderBook*> books;
+        {
+            std::shared_lock lock(mutex_);
+            for (const auto& [symbol, orderBook] : orderBooks_) {
+                if (orderBook->isBatchMode()) books.push_back(orderBook.get());
+            }
+        }
+        
+        size_t tradeCount = 0;
+        for (auto orderBook : books) {
+            expireDue(*orderBook);
+            for (const auto& trade : orderBook->runBatchAuction()) {
+                notifyTradeExecuted(trade);
+                ++tradeCount;
+            }
+        }
+        
+        return tradeCount;
+    }
+    
+    BatchAuctionStats TradingEngine::getBatchAuctionStats(const Symbol& symbol) const {
+        OrderBook* orderBook = findOrderBook(symbol);
+        return orderBook ? orderBook->getBatchAuctionStats() : BatchAuctionStats();
+    }
+    
+    void TradingEngine::setMatchingAlgorithm(const Symbol& symbol, MatchingAlgorithm algorithm) {
+        OrderBook* orderBook = getOrCreateOrderBook(symbol);
+        if (orderBook) orderBook->setMatchingAlgorithm(algorithm);
+    }
+    
+    std::vector<DepthLevel> TradingEngine::getBidDepth(const Symbol& symbol, size_t maxLevels) const {
+        OrderBook* orderBook = findOrderBook(symbol);
+        return orderBook ? orderBook->getBidDepth(maxLevels) : std::vector<DepthLevel>();
+    }
+    
+    std::vector<DepthLevel> TradingEngine::getAskDepth(const Symbol& symbol, size_t maxLevels) const {
+        OrderBook* orderBook = findOrderBook(symbol);
+        return orderBook ? orderBook->getAskDepth(maxLevels) : std::vector<DepthLevel>();
+    }
+    
+    void TradingEngine::setKillSwitch(bool active) {
+        killSwitch_.store(active, std::memory_order_relaxed);
+    }
+    
+    bool TradingEngine::isKillSwitchActive() const {
+        return killSwitch_.load(std::memory_order_relaxed);
+    }
+    
+    bool TradingEngine::setUserKillSwitch(const UserId& userId, bool active, bool cancelOpenOrders) {
+        auto user = getUser(userId);
+        if (!user) return false;
+        
+        // The flag is published first: new orders are refused before the sweep starts,
+        // and orders already past admission cancel themselves (see cancelIfFrozen)
+        user->setKillSwitch(active);
+        if (active && cancelOpenOrders) {
+            cancelAllOrders(userId);
+        }
+        return true;
+    }
+    
+    int TradingEngine::cancelAllOrders(const UserId& userId) {
+        std::vector<std::shared_ptr<Order>> openOrders;
+        {
+            std::shared_lock lock(mutex_);
+            for (const auto& [orderId, order] : allOrders_) {
+                if (order->getUserId() == userId && order->canCancel()) {
+                    openOrders.push_back(order);
+                }
+            }
+        }
+        
+        int cancelled = 0;
+        for (const auto& order : openOrders) {
+            OrderBook* orderBook = findOrderBook(order->getSymbol());
+            if (orderBook && orderBook->cancelOrder(order->getOrderId())) {
+                notifyOrderStatusChanged(order);
+                ++cancelled;
+            }
+        }
+        
+        return cancelled;
+    }
+    
     void TradingEngine::registerObserver(TradeObserver* observer) {
         std::unique_lock lock(mutex_);
         observers_.push_back(observer);
@@ -200,17 +577,85 @@ namespace TradingSystem {
         );
     }
     
+    std::shared_ptr<User> TradingEngine::admitNewOrder(const UserId& userId) {
+        if (killSwitch_.load(std::memory_order_relaxed)) return nullptr;
+        
+        auto user = getUser(userId);
+        if (!user || user->isKillSwitchActive()) return nullptr;
+        
+        // Throttle before any order is built or any book/map lock is taken
+        return user->admitOrder(clock_->now()) ? user : nullptr;
+    }
+    
+    // An order admitted just before its user was frozen may reach the book after
+    // the mass cancel took its snapshot; both sides go through the book lock, so
+    // either the sweep finds the order or this check sees the flag
+    bool TradingEngine::cancelIfFrozen(OrderBook& orderBook, const User& user,
+                                       const std::shared_ptr<Order>& order) {
+        if (!user.isKillSwitchActive() || !orderBook.cancelOrder(order->getOrderId())) {
+            return false;
+        }
+        notifyOrderStatusChanged(order);
+        return true;
+    }
+    
+    // Fires the book's due GTD orders before new flow can match against them; with
+    // nothing due this is one wheel advance under the book lock
+    void TradingEngine::expireDue(OrderBook& orderBook) {
+        for (const auto& order : orderBook.expireOrders(clock_->currentTimestamp())) {
+            notifyOrderStatusChanged(order);
+        }
+    }
+    
+    std::shared_ptr<Order> TradingEngine::submitOrder(std::unique_ptr<Order> order, const User& user) {
+        if (!order->isValid()) return nullptr;
+        
+        auto orderBook = getOrCreateOrderBook(order->getSymbol());
+        if (!orderBook) return nullptr;
+        
+        auto sharedOrder = std::shared_ptr<Order>(order.release());
+        
+        // Store order in allOrders before adding to order book
+        {
+            std::unique_lock lock(mutex_);
+            allOrders_[sharedOrder->getOrderId()] = sharedOrder;
+        }
+        
+        expireDue(*orderBook);
+        if (orderBook->addOrder(sharedOrder)) {
+            if (cancelIfFrozen(*orderBook, user, sharedOrder)) return nullptr;
+            notifyOrderStatusChanged(sharedOrder);
+            
+            auto trades = orderBook->matchOrders();
+            for (const auto& trade : trades) {
+                notifyTradeExecuted(trade);
+            }
+            
+            return sharedOrder;
+        }
+        
+        return nullptr;
+    }
+    
     OrderBook* TradingEngine::getOrCreateOrderBook(const Symbol& symbol) {
         std::unique_lock lock(mutex_);
         auto it = orderBooks_.find(symbol);
         if (it == orderBooks_.end()) {
-            auto orderBook = std::make_unique<OrderBook>(symbol);
+            auto orderBook = std::make_unique<OrderBook>(symbol, *clock_, *idGenerator_);
             it = orderBooks_.emplace(symbol, std::move(orderBook)).first;
         }
         return it->second.get();
     }
     
+    OrderBook* TradingEngine::findOrderBook(const Symbol& symbol) const {
+        std::shared_lock lock(mutex_);
+        auto it = orderBooks_.find(symbol);
+        return it != orderBooks_.end() ? it->second.get() : nullptr;
+    }
+    
     void TradingEngine::notifyTradeExecuted(const std::shared_ptr<Trade>& trade) {
+        LatencyTimer timer(LatencyMetric::OBSERVER_DISPATCH);
+        
         // Make a copy of observers to avoid holding lock during notification
         std::vector<TradeObserver*> observersCopy;
         {
@@ -226,6 +671,8 @@ namespace TradingSystem {
     }
     
     void TradingEngine::notifyOrderStatusChanged(const std::shared_ptr<Order>& order) {
+        LatencyTimer timer(LatencyMetric::OBSERVER_DISPATCH);
+        
         // Make a copy of observers to avoid holding lock during notification
         std::vector<TradeObserver*> observersCopy;
         {
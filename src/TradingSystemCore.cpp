@@ -1,12 +1,14 @@
 #include "../include/TradingSystemCore.h"
+#include <array>
+#include <ctime>
 
 namespace TradingSystem {
 
     std::string generateUUID() {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        static std::uniform_int_distribution<> dis(0, 15);
-        static std::uniform_int_distribution<> dis2(8, 11);
+        // Per-thread generator: order entry calls this concurrently from many threads
+        static thread_local std::mt19937 gen(std::random_device{}());
+        static thread_local std::uniform_int_distribution<> dis(0, 15);
+        static thread_local std::uniform_int_distribution<> dis2(8, 11);
         
         std::stringstream ss;
         ss << std::hex;
@@ -24,7 +26,143 @@ namespace TradingSystem {
     }
 
     Timestamp getCurrentTimestamp() {
-        return std::chrono::system_clock::now();
+        return TscClock::toTimestamp(TscClock::now());
+    }
+
+    double cycleCounterFrequency() {
+        return 1e9 / TscClock::calibration().nsPerTick;
+    }
+    
+    namespace {
+    
+        std::int64_t readClockNs(clockid_t clock) {
+            timespec ts;
+            clock_gettime(clock, &ts);
+            return static_cast<std::int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+        }
+        
+        // Brackets both clock reads between two counter reads and keeps the tightest
+        // of a few attempts, so a preemption mid-sample does not skew the anchor
+        ClockCalibration sampleClocks() {
+            ClockCalibration best;
+            CycleCount bestWidth = ~CycleCount(0);
+            for (int attempt = 0; attempt < 8; ++attempt) {
+                CycleCount before = readCycleCounter();
+                std::int64_t realtime = readClockNs(CLOCK_REALTIME);
+                std::int64_t monotonic = readClockNs(CLOCK_MONOTONIC);
+                CycleCount after = readCycleCounter();
+                if (after - before < bestWidth) {
+                    bestWidth = after - before;
+                    best.ticks = before + (after - before) / 2;
+                    best.realtimeNs = realtime;
+                    best.monotonicNs = monotonic;
+                }
+            }
+            return best;
+        }
+        
+        double nsPerTickBetween(const ClockCalibration& from, const ClockCalibration& to) {
+            return static_cast<double>(to.monotonicNs - from.monotonicNs) /
+                   static_cast<double>(to.ticks - from.ticks);
+        }
+        
+        // Extrapolates one kernel clock from an anchor, applying its half-rate
+        // catch-up to the ticks that follow the anchor
+        std::int64_t extrapolate(const ClockCalibration& anchor, std::int64_t anchorNs,
+                                 CycleCount catchUpTicks, CycleCount ticks) {
+            auto delta = static_cast<std::int64_t>(ticks - anchor.ticks);
+            double ns = static_cast<double>(delta) * anchor.nsPerTick;
+            if (delta > 0 && catchUpTicks > 0) {
+                ns -= static_cast<double>(std::min(static_cast<CycleCount>(delta), catchUpTicks)) *
+                      anchor.nsPerTick / 2.0;
+            }
+            return anchorNs + static_cast<std::int64_t>(ns);
+        }
+        
+        // A measured clock behind the previous anchor's extrapolation is not stepped
+        // back: the new anchor continues from the extrapolation and catches up at
+        // half rate over twice the gap
+        void continueFrom(std::int64_t continuedNs, std::int64_t& anchorNs,
+                          CycleCount& catchUpTicks, double nsPerTick) {
+            if (anchorNs >= continuedNs) return;
+            catchUpTicks = static_cast<CycleCount>(
+                2.0 * static_cast<double>(continuedNs - anchorNs) / nsPerTick);
+            anchorNs = continuedNs;
+        }
+        
+        // The rate baseline stays the startup sample, so every recalibration measures
+        // over a longer window. Anchors live in a fixed ring; `latest` counts every
+        // calibration taken, the newest being history[latest % CALIBRATION_HISTORY]
+        struct CalibrationState {
+            ClockCalibration origin;
+            std::array<ClockCalibration, TscClock::CALIBRATION_HISTORY> history;
+            std::atomic<std::uint64_t> latest{0};
+            std::mutex recalibrateMutex;
+            
+            CalibrationState() : origin(sampleClocks()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                history[0] = sampleClocks();
+                history[0].nsPerTick = nsPerTickBetween(origin, history[0]);
+            }
+            
+            // Newest anchor taken at or before `ticks`
+            const ClockCalibration& anchorFor(CycleCount ticks) const {
+                std::uint64_t newest = latest.load(std::memory_order_acquire);
+                std::uint64_t oldest = newest >= history.size() ? newest - history.size() + 1 : 0;
+                for (std::uint64_t index = newest; index > oldest; --index) {
+                    const ClockCalibration& anchor = history[index % history.size()];
+                    if (static_cast<std::int64_t>(ticks - anchor.ticks) >= 0) return anchor;
+                }
+                return history[oldest % history.size()];
+            }
+        };
+        
+        CalibrationState& calibrationState() {
+            static CalibrationState* state = new CalibrationState();
+            return *state;
+        }
+        
+        // Pays the 20 ms calibration at startup rather than on the first order
+        const bool calibratedAtStartup = (calibrationState(), true);
+        
+    } // namespace
+    
+    const ClockCalibration& TscClock::calibration() {
+        const CalibrationState& state = calibrationState();
+        return state.history[state.latest.load(std::memory_order_acquire) % CALIBRATION_HISTORY];
+    }
+    
+    void TscClock::recalibrate() {
+        CalibrationState& state = calibrationState();
+        std::lock_guard lock(state.recalibrateMutex);
+        std::uint64_t latest = state.latest.load(std::memory_order_relaxed);
+        const ClockCalibration& previous = state.history[latest % CALIBRATION_HISTORY];
+        
+        ClockCalibration next = sampleClocks();
+        next.nsPerTick = nsPerTickBetween(state.origin, next);
+        continueFrom(extrapolate(previous, previous.realtimeNs, previous.realtimeCatchUpTicks, next.ticks),
+                     next.realtimeNs, next.realtimeCatchUpTicks, next.nsPerTick);
+        continueFrom(extrapolate(previous, previous.monotonicNs, previous.monotonicCatchUpTicks, next.ticks),
+                     next.monotonicNs, next.monotonicCatchUpTicks, next.nsPerTick);
+        
+        state.history[(latest + 1) % CALIBRATION_HISTORY] = next;
+        state.latest.store(latest + 1, std::memory_order_release);
+    }
+    
+    std::chrono::nanoseconds TscClock::toDuration(CycleCount elapsedTicks) {
+        return std::chrono::nanoseconds(static_cast<std::int64_t>(
+            static_cast<double>(elapsedTicks) * calibration().nsPerTick));
+    }
+    
+    std::int64_t TscClock::toMonotonicNs(CycleCount ticks) {
+        const ClockCalibration& anchor = calibrationState().anchorFor(ticks);
+        return extrapolate(anchor, anchor.monotonicNs, anchor.monotonicCatchUpTicks, ticks);
+    }
+    
+    Timestamp TscClock::toTimestamp(CycleCount ticks) {
+        const ClockCalibration& anchor = calibrationState().anchorFor(ticks);
+        auto ns = extrapolate(anchor, anchor.realtimeNs, anchor.realtimeCatchUpTicks, ticks);
+        return Timestamp(std::chrono::duration_cast<Timestamp::duration>(std::chrono::nanoseconds(ns)));
     }
 
 } // namespace TradingSystem
@@ -16,5 +16,34 @@ namespace TradingSystem {
         return !userId_.empty() && !userName_.empty() && 
                !phoneNumber_.empty() && !emailId_.empty();
     }
+    
+    void User::setThrottle(const ThrottleConfig& config, double ticksPerSecond) {
+        throttle_.messages.configure(config.messagesPerSecond, config.messageBurst, ticksPerSecond);
+        throttle_.orders.configure(config.ordersPerSecond, config.orderBurst, ticksPerSecond);
+    }
+    
+    bool User::admitMessage(CycleCount now) {
+        if (throttle_.messages.tryConsume(now)) return true;
+        throttle_.rejected.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    
+    // A new order is one message and one order; an order-limit reject hands the
+    // message token back, so it does not eat into the user's cancel allowance
+    bool User::admitOrder(CycleCount now) {
+        if (!admitMessage(now)) return false;
+        if (throttle_.orders.tryConsume(now)) return true;
+        throttle_.messages.refund();
+        throttle_.rejected.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    
+    void User::setKillSwitch(bool active) {
+        killSwitch_.store(active, std::memory_order_relaxed);
+    }
+    
+    std::uint64_t User::getThrottleRejectCount() const {
+        return throttle_.rejected.load(std::memory_order_relaxed);
+    }
 
 } // namespace TradingSystem
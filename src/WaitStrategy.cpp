@@ -0,0 +1,82 @@
+#include "../include/WaitStrategy.h"
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ctime>
+
+namespace TradingSystem {
+
+    namespace {
+        long futex(std::atomic<std::uint32_t>& word, int op, std::uint32_t value, const timespec* timeout) {
+            return syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), op, value, timeout, nullptr, 0);
+        }
+    }
+    
+    const char* toString(WaitStrategy strategy) {
+        switch (strategy) {
+            case WaitStrategy::BLOCK: return "block";
+            case WaitStrategy::SPIN_YIELD: return "spin-yield";
+            case WaitStrategy::BUSY_SPIN: return "busy-spin";
+        }
+        return "block";
+    }
+    
+    WaitStrategy parseWaitStrategy(const std::string& name) {
+        if (name == "block") return WaitStrategy::BLOCK;
+        if (name == "spin-yield") return WaitStrategy::SPIN_YIELD;
+        if (name == "busy-spin") return WaitStrategy::BUSY_SPIN;
+        throw std::invalid_argument("unknown wait strategy " + name);
+    }
+    
+    void WorkSignal::notify() {
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+        if (blocked_.load(std::memory_order_seq_cst) != 0) futex(epoch_, FUTEX_WAKE_PRIVATE, 1, nullptr);
+    }
+    
+    void WorkSignal::notifyAll() {
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+        if (blocked_.load(std::memory_order_seq_cst) != 0) futex(epoch_, FUTEX_WAKE_PRIVATE, INT32_MAX, nullptr);
+    }
+    
+    bool WorkSignal::wait(std::uint32_t seen, WaitStrategy strategy, std::chrono::microseconds timeout,
+                          std::uint32_t spinIterations) {
+        switch (strategy) {
+            case WaitStrategy::BUSY_SPIN:
+                for (std::uint32_t i = 0; i < spinIterations; ++i) {
+                    if (epoch() != seen) return true;
+                    cpuRelax();
+                }
+                return epoch() != seen;
+            case WaitStrategy::SPIN_YIELD:
+                for (std::uint32_t i = 0; i < spinIterations; ++i) {
+                    if (epoch() != seen) return true;
+                    cpuRelax();
+                }
+                std::this_thread::yield();
+                return epoch() != seen;
+            case WaitStrategy::BLOCK:
+                break;
+        }
+        
+        // Registering as blocked before the final epoch check pairs with notify()
+        // bumping the epoch before it looks for blocked waiters (both seq_cst)
+        blocked_.fetch_add(1, std::memory_order_seq_cst);
+        if (epoch_.load(std::memory_order_seq_cst) == seen) block(seen, timeout);
+        blocked_.fetch_sub(1, std::memory_order_seq_cst);
+        return epoch() != seen;
+    }
+
+    // Returns at once if the epoch already moved; spurious wake-ups simply send the
+    // caller back around its loop
+    void WorkSignal::block(std::uint32_t seen, std::chrono::microseconds timeout) {
+        timespec relative{};
+        const timespec* limit = nullptr;
+        if (timeout.count() > 0) {
+            relative.tv_sec = static_cast<time_t>(timeout.count() / 1000000);
+            relative.tv_nsec = static_cast<long>(timeout.count() % 1000000) * 1000;
+            limit = &relative;
+        }
+        futex(epoch_, FUTEX_WAIT_PRIVATE, seen, limit);
+    }
+
+} // namespace TradingSystem
@@ -5,6 +5,15 @@
 #include "../include/OrderBook.h"
 #include "../include/TradeObserver.h"
 #include "../include/TradingEngine.h"
+#include "../include/LatencyHistogram.h"
+#include "../include/BacktestRunner.h"
+#include "../include/OrderGateway.h"
+#include "../include/StrategyRuntime.h"
+#include "../include/SymbolScheduler.h"
+#include "../include/ThreadPlacement.h"
+#include "../include/RingQueue.h"
+#include <fstream>
+#include <sstream>
 
 // ============================================================================
 // COMPREHENSIVE TEST SUITE
@@ -88,9 +97,6 @@ bool testOrderMatching() {
     auto sellOrder = engine.placeOrder("U3", OrderType::SELL, "WIPRO", 100, 500.0);
     assert(sellOrder != nullptr);
     
-    // Give some time for matching to occur
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    
     assert(observer.tradeCount > 0);
     if (observer.tradeCount > 0) {
         auto trade = observer.executedTrades[0];
@@ -118,13 +124,10 @@ bool testPriceTimePriority() {
     observer.reset();
     
     auto order1 = engine.placeOrder("U4", OrderType::BUY, "INFY", 100, 1800.0);
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
     auto order2 = engine.placeOrder("U4", OrderType::BUY, "INFY", 100, 1800.0);
     
     auto sellOrder = engine.placeOrder("U4", OrderType::SELL, "INFY", 100, 1800.0);
     
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    
     assert(observer.tradeCount > 0);
     if (observer.tradeCount > 0) {
         auto trade = observer.executedTrades[0];
@@ -185,9 +188,6 @@ bool testOrderModification() {
     
     OrderId orderId = order->getOrderId();
     
-    // Wait a bit to ensure order is processed
-    std::this_thread::sleep_for(std::chrono::milliseconds(50));
-    
     bool modifyResult = engine.modifyOrder("U6", orderId, 150, 1600.0);
     assert(modifyResult);
     
@@ -223,8 +223,6 @@ bool testPartialOrderMatching() {
     auto sellOrder1 = engine.placeOrder("U8", OrderType::SELL, "SBIN", 300, 600.0);
     auto sellOrder2 = engine.placeOrder("U8", OrderType::SELL, "SBIN", 400, 600.0);
     
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    
     auto updatedOrder = engine.getOrderStatus("U7", buyOrderId);
     assert(updatedOrder != nullptr);
     assert(updatedOrder->getStatus() == OrderStatus::PARTIALLY_FILLED);
@@ -377,6 +375,1924 @@ bool testMultipleSymbols() {
     return true;
 }
 
+bool testOrderThrottling() {
+    std::cout << "\n=== Test 11: Per-User Order Throttling ===" << std::endl;
+    
+    auto& engine = TradingEngine::getInstance();
+    
+    auto user = std::make_shared<User>("U13", "Flooder", "1313131313", "flood@test.com");
+    engine.registerUser(user);
+    
+    // One order per minute with a burst of two: the third order must be rejected
+    ThrottleConfig config;
+    config.ordersPerSecond = 1.0 / 60.0;
+    config.orderBurst = 2.0;
+    assert(engine.setUserThrottle("U13", config));
+    
+    auto order1 = engine.placeOrder("U13", OrderType::BUY, "BHARTI", 10, 800.0);
+    auto order2 = engine.placeOrder("U13", OrderType::BUY, "BHARTI", 10, 801.0);
+    auto order3 = engine.placeOrder("U13", OrderType::BUY, "BHARTI", 10, 802.0);
+    assert(order1 != nullptr);
+    assert(order2 != nullptr);
+    assert(order3 == nullptr);
+    assert(user->getThrottleRejectCount() == 1);
+    
+    // Message limit also applies to cancels
+    config = ThrottleConfig();
+    config.messagesPerSecond = 1.0 / 60.0;
+    config.messageBurst = 1.0;
+    engine.setUserThrottle("U13", config);
+    assert(engine.cancelOrder("U13", order1->getOrderId()));
+    assert(!engine.cancelOrder("U13", order2->getOrderId()));
+    
+    // An order the order limit rejects gives its message token back: with room for
+    // two messages, an order, a rejected order and a cancel all get through
+    config.messagesPerSecond = 1.0 / 60.0;
+    config.messageBurst = 2.0;
+    config.ordersPerSecond = 1.0 / 60.0;
+    config.orderBurst = 1.0;
+    engine.setUserThrottle("U13", config);
+    auto order4 = engine.placeOrder("U13", OrderType::BUY, "BHARTI", 10, 803.0);
+    assert(order4 != nullptr);
+    assert(engine.placeOrder("U13", OrderType::BUY, "BHARTI", 10, 804.0) == nullptr);
+    assert(engine.cancelOrder("U13", order4->getOrderId()));
+    assert(!engine.cancelOrder("U13", order2->getOrderId()));
+    
+    // Lifting the throttle restores normal flow
+    engine.setUserThrottle("U13", ThrottleConfig());
+    assert(engine.cancelOrder("U13", order2->getOrderId()));
+    
+    std::cout << "PASS: Per-User Order Throttling Test" << std::endl;
+    return true;
+}
+
+bool testKillSwitch() {
+    std::cout << "\n=== Test 12: Kill Switch ===" << std::endl;
+    
+    auto& engine = TradingEngine::getInstance();
+    TestObserver observer;
+    engine.registerObserver(&observer);
+    
+    auto user = std::make_shared<User>("U14", "Runaway", "1414141414", "runaway@test.com");
+    engine.registerUser(user);
+    
+    observer.reset();
+    
+    auto order1 = engine.placeOrder("U14", OrderType::BUY, "MARUTI", 10, 9000.0);
+    auto order2 = engine.placeOrder("U14", OrderType::SELL, "MARUTI", 10, 9500.0);
+    assert(order1 != nullptr && order2 != nullptr);
+    
+    // Freezing the user refuses new orders and modifications, and sweeps open orders
+    assert(engine.setUserKillSwitch("U14", true, true));
+    assert(order1->getStatus() == OrderStatus::CANCELLED);
+    assert(order2->getStatus() == OrderStatus::CANCELLED);
+    assert(engine.placeOrder("U14", OrderType::BUY, "MARUTI", 10, 9000.0) == nullptr);
+    assert(!engine.modifyOrder("U14", order1->getOrderId(), 20, 9100.0));
+    
+    assert(engine.setUserKillSwitch("U14", false));
+    assert(!engine.setUserKillSwitch("NOBODY", true));
+    assert(engine.placeOrder("U14", OrderType::BUY, "MARUTI", 10, 9000.0) != nullptr);
+    
+    // Venue-wide switch freezes everyone
+    engine.setKillSwitch(true);
+    assert(engine.isKillSwitchActive());
+    assert(engine.placeOrder("U14", OrderType::BUY, "MARUTI", 10, 9000.0) == nullptr);
+    engine.setKillSwitch(false);
+    assert(engine.placeOrder("U14", OrderType::BUY, "MARUTI", 10, 9000.0) != nullptr);
+    
+    engine.unregisterObserver(&observer);
+
+    // Orders in flight while the switch flips never outlive the sweep
+    engine.registerUser(std::make_shared<User>("U14R", "Racer", "1414141415", "racer@test.com"));
+    std::atomic<bool> started{false};
+    std::thread placer([&engine, &started] {
+        OrderRequest batch[4];
+        for (auto& request : batch) request = {"U14R", OrderType::BUY, "FREEZE", 1, 50.0};
+        std::shared_ptr<Order> results[4];
+        for (int i = 0; i < 2000; ++i) {
+            engine.placeOrder("U14R", OrderType::BUY, "FREEZE", 1, 50.0);
+            engine.placeOrders(batch, results);
+            started.store(true);
+        }
+    });
+    while (!started.load()) std::this_thread::yield();
+    assert(engine.setUserKillSwitch("U14R", true, true));
+    placer.join();
+    assert(engine.getBidDepth("FREEZE", 1).empty());
+    
+    std::cout << "PASS: Kill Switch Test" << std::endl;
+    return true;
+}
+
+bool testStopOrders() {
+    std::cout << "\n=== Test 13: Stop and Stop-Limit Orders ===" << std::endl;
+    
+    auto& engine = TradingEngine::getInstance();
+    TestObserver observer;
+    engine.registerObserver(&observer);
+    
+    auto user = std::make_shared<User>("U15", "Stopper", "1515151515", "stop@test.com");
+    engine.registerUser(user);
+    
+    observer.reset();
+    
+    engine.placeOrder("U15", OrderType::SELL, "ONGC", 10, 101.0);
+    engine.placeOrder("U15", OrderType::SELL, "ONGC", 10, 102.0);
+    engine.placeOrder("U15", OrderType::SELL, "ONGC", 10, 103.0);
+    
+    auto buyStop = engine.placeStopOrder("U15", OrderType::BUY, "ONGC", 10, 101.0);
+    auto buyStopLimit = engine.placeStopOrder("U15", OrderType::BUY, "ONGC", 10, 102.0, 102.0);
+    auto sellStop = engine.placeStopOrder("U15", OrderType::SELL, "ONGC", 10, 90.0);
+    assert(buyStop && buyStopLimit && sellStop);
+    assert(observer.tradeCount == 0);
+    
+    // Trade at 101 fires the 101 stop, whose fill at 102 fires the 102 stop-limit
+    engine.placeOrder("U15", OrderType::BUY, "ONGC", 10, 101.0);
+    assert(observer.tradeCount == 2);
+    assert(observer.executedTrades[1]->getBuyerOrderId() == buyStop->getOrderId());
+    assert(observer.executedTrades[1]->getPrice() == 102.0);
+    assert(buyStop->getStatus() == OrderStatus::FILLED);
+    
+    // The stop-limit is now resting at its limit; the sell stop is still parked
+    assert(static_cast<StopOrder&>(*buyStopLimit).isTriggered());
+    assert(buyStopLimit->getStatus() == OrderStatus::ACCEPTED);
+    assert(!static_cast<StopOrder&>(*sellStop).isTriggered());
+    
+    assert(engine.cancelOrder("U15", sellStop->getOrderId()));
+    assert(sellStop->getStatus() == OrderStatus::CANCELLED);
+    
+    engine.unregisterObserver(&observer);
+    std::cout << "PASS: Stop and Stop-Limit Orders Test" << std::endl;
+    return true;
+}
+
+bool testIcebergOrders() {
+    std::cout << "\n=== Test 14: Iceberg Orders ===" << std::endl;
+    
+    auto& engine = TradingEngine::getInstance();
+    TestObserver observer;
+    engine.registerObserver(&observer);
+    
+    auto user1 = std::make_shared<User>("U16", "Institution", "1616161616", "iceberg@test.com");
+    auto user2 = std::make_shared<User>("U17", "Taker", "1717171717", "taker@test.com");
+    engine.registerUser(user1);
+    engine.registerUser(user2);
+    
+    observer.reset();
+    
+    // 500 total, 100 shown; a plain order joins the same level behind it
+    auto iceberg = engine.placeIcebergOrder("U16", OrderType::SELL, "NTPC", 500, 200.0, 100);
+    auto plain = engine.placeOrder("U16", OrderType::SELL, "NTPC", 50, 200.0);
+    assert(iceberg != nullptr && plain != nullptr);
+    assert(iceberg->getDisplayedQuantity() == 100);
+    
+    auto depth = engine.getAskDepth("NTPC", 5);
+    assert(depth.size() == 1);
+    assert(depth[0].quantity == 150);
+    assert(depth[0].orderCount == 2);
+    
+    // Taking the tip refreshes it and sends the iceberg behind the plain order
+    engine.placeOrder("U17", OrderType::BUY, "NTPC", 120, 200.0);
+    assert(observer.tradeCount == 2);
+    assert(observer.executedTrades[0]->getSellerOrderId() == iceberg->getOrderId());
+    assert(observer.executedTrades[0]->getQuantity() == 100);
+    assert(observer.executedTrades[1]->getSellerOrderId() == plain->getOrderId());
+    assert(observer.executedTrades[1]->getQuantity() == 20);
+    assert(iceberg->getRemainingQuantity() == 400);
+    assert(iceberg->getDisplayedQuantity() == 100);
+    
+    depth = engine.getAskDepth("NTPC", 5);
+    assert(depth[0].quantity == 130);
+    
+    engine.unregisterObserver(&observer);
+    std::cout << "PASS: Iceberg Orders Test" << std::endl;
+    return true;
+}
+
+bool testPeggedOrders() {
+    std::cout << "\n=== Test 15: Pegged Orders ===" << std::endl;
+    
+    auto& engine = TradingEngine::getInstance();
+    TestObserver observer;
+    engine.registerObserver(&observer);
+    
+    auto user1 = std::make_shared<User>("U18", "Pegger", "1818181818", "peg@test.com");
+    auto user2 = std::make_shared<User>("U19", "Quoter", "1919191919", "quote@test.com");
+    engine.registerUser(user1);
+    engine.registerUser(user2);
+    
+    observer.reset();
+    
+    engine.placeOrder("U19", OrderType::BUY, "ITC", 100, 400.0);
+    engine.placeOrder("U19", OrderType::SELL, "ITC", 100, 410.0);
+    
+    // Primary peg one tick inside the bid
+    auto primary = engine.placePeggedOrder("U18", OrderType::BUY, "ITC", 50, PegType::PRIMARY, 1.0);
+    assert(primary != nullptr);
+    assert(observer.tradeCount == 0);
+    
+    auto bids = engine.getBidDepth("ITC", 5);
+    assert(bids.size() == 2);
+    assert(bids[0].price == 401.0 && bids[0].quantity == 50);
+    
+    // Raising the bid moves the reference: the peg follows to 403 without a re-sort
+    engine.placeOrder("U19", OrderType::BUY, "ITC", 100, 402.0);
+    bids = engine.getBidDepth("ITC", 5);
+    assert(bids[0].price == 403.0);
+    
+    // An incoming sell at 403 trades with the peg at its effective price
+    engine.placeOrder("U19", OrderType::SELL, "ITC", 50, 403.0);
+    assert(observer.tradeCount == 1);
+    assert(observer.executedTrades[0]->getBuyerOrderId() == primary->getOrderId());
+    assert(observer.executedTrades[0]->getPrice() == 403.0);
+    assert(primary->getPrice() == 403.0);
+    assert(primary->getStatus() == OrderStatus::FILLED);
+    
+    // Midpoint peg on the offer side sits between 402 and 410
+    auto midpoint = engine.placePeggedOrder("U18", OrderType::SELL, "ITC", 30, PegType::MIDPOINT);
+    assert(midpoint != nullptr);
+    auto asks = engine.getAskDepth("ITC", 5);
+    assert(asks[0].price == 406.0 && asks[0].quantity == 30);
+    
+    // A market buy sees the merged ladder and lifts the peg ahead of the 410 offer
+    engine.placeOrder("U19", OrderType::BUY, "ITC", 30);
+    assert(observer.tradeCount == 2);
+    assert(observer.executedTrades[1]->getSellerOrderId() == midpoint->getOrderId());
+    assert(observer.executedTrades[1]->getPrice() == 406.0);
+    
+    // A quantity-only modify keeps the peg, whether it passes no price or the
+    // price the peg shows; a fixed price is refused
+    auto resized = engine.placePeggedOrder("U18", OrderType::SELL, "ITC", 40, PegType::MIDPOINT);
+    assert(resized != nullptr);
+    assert(engine.modifyOrder("U18", resized->getOrderId(), 25, 0.0));
+    asks = engine.getAskDepth("ITC", 5);
+    assert(asks[0].price == 406.0 && asks[0].quantity == 25);
+    assert(engine.modifyOrder("U18", resized->getOrderId(), 20, 406.0));
+    assert(!engine.modifyOrder("U18", resized->getOrderId(), 20, 405.0));
+    auto live = engine.getOrderStatus("U18", resized->getOrderId());
+    assert(live->isPeggedOrder() && live->getQuantity() == 20);
+    asks = engine.getAskDepth("ITC", 5);
+    assert(asks[0].price == 406.0 && asks[0].quantity == 20);
+    assert(engine.cancelOrder("U18", resized->getOrderId()));
+    
+    engine.unregisterObserver(&observer);
+    std::cout << "PASS: Pegged Orders Test" << std::endl;
+    return true;
+}
+
+bool testOrderExpiry() {
+    std::cout << "\n=== Test 16: GTD and DAY Order Expiry ===" << std::endl;
+    
+    auto& engine = TradingEngine::getInstance();
+    TestObserver observer;
+    engine.registerObserver(&observer);
+    
+    auto user = std::make_shared<User>("U20", "Day Trader", "2020202020", "day@test.com");
+    engine.registerUser(user);
+    
+    observer.reset();
+    
+    auto now = getCurrentTimestamp();
+    auto gtd = engine.placeOrder("U20", OrderType::BUY, "ZOMATO", 100, 150.0,
+                                 OrderTimeInForce::GTD, now + std::chrono::seconds(2));
+    auto day = engine.placeOrder("U20", OrderType::SELL, "ZOMATO", 100, 160.0,
+                                 OrderTimeInForce::DAY);
+    auto gtc = engine.placeOrder("U20", OrderType::BUY, "ZOMATO", 100, 149.0);
+    assert(gtd && day && gtc);
+    
+    // GTD in the past is rejected up front
+    assert(engine.placeOrder("U20", OrderType::BUY, "ZOMATO", 100, 150.0,
+                             OrderTimeInForce::GTD, now - std::chrono::seconds(1)) == nullptr);
+    
+    // Expirations are driven by the supplied time, so no sleeping is needed
+    engine.processExpirations(now + std::chrono::seconds(1));
+    assert(gtd->getStatus() == OrderStatus::ACCEPTED);
+    engine.processExpirations(now + std::chrono::seconds(3));
+    assert(gtd->getStatus() == OrderStatus::EXPIRED);
+    assert(!engine.cancelOrder("U20", gtd->getOrderId()));
+    
+    assert(engine.endTradingSession() >= 1);
+    assert(day->getStatus() == OrderStatus::EXPIRED);
+    assert(gtc->getStatus() == OrderStatus::ACCEPTED);
+    assert(engine.getAskDepth("ZOMATO", 5).empty());
+
+    // A book created while its simulated clock is still at the epoch re-bases the
+    // wheel on the first GTD, and far-off timers jump straight to their cascade
+    SimulatedClock simClock;
+    OrderBook simBook("EXPIRY", simClock);
+    simClock.advanceTo(now);
+    auto hourly = std::make_shared<LimitOrder>("EX1", "U20", OrderType::BUY, "EXPIRY", 10, 99.0);
+    auto yearly = std::make_shared<LimitOrder>("EX2", "U20", OrderType::BUY, "EXPIRY", 10, 98.0);
+    assert(hourly->setTimeInForce(OrderTimeInForce::GTD, now + std::chrono::hours(1)));
+    assert(yearly->setTimeInForce(OrderTimeInForce::GTD, now + std::chrono::hours(24 * 365)));
+    assert(simBook.addOrder(hourly) && simBook.addOrder(yearly));
+    assert(hourly->getTimestamp() == now && &hourly->getClock() == &simClock);   // stamped by the book
+    assert(simBook.expireOrders(now + std::chrono::minutes(59)).empty());
+    assert(simBook.expireOrders(now + std::chrono::hours(1)).size() == 1);
+    assert(hourly->getStatus() == OrderStatus::EXPIRED);
+    assert(simBook.expireOrders(now + std::chrono::hours(24 * 365) - std::chrono::milliseconds(1)).empty());
+    assert(simBook.expireOrders(now + std::chrono::hours(24 * 365)).size() == 1);
+    assert(yearly->getStatus() == OrderStatus::EXPIRED);
+
+    engine.unregisterObserver(&observer);
+    std::cout << "PASS: GTD and DAY Order Expiry Test" << std::endl;
+    return true;
+}
+
+bool testCallAuction() {
+    std::cout << "\n=== Test 17: Call Auction Uncross ===" << std::endl;
+    
+    auto& engine = TradingEngine::getInstance();
+    TestObserver observer;
+    engine.registerObserver(&observer);
+    
+    auto user = std::make_shared<User>("U21", "Auction Trader", "2121212121", "auction@test.com");
+    engine.registerUser(user);
+    
+    observer.reset();
+    
+    engine.beginCallAuction("LT");
+    engine.placeOrder("U21", OrderType::BUY, "LT", 100, 101.0);
+    engine.placeOrder("U21", OrderType::BUY, "LT", 100, 100.0);
+    engine.placeOrder("U21", OrderType::BUY, "LT", 50, 99.0);
+    engine.placeOrder("U21", OrderType::SELL, "LT", 80, 98.0);
+    engine.placeOrder("U21", OrderType::SELL, "LT", 100, 100.0);
+    engine.placeOrder("U21", OrderType::SELL, "LT", 100, 102.0);
+    assert(observer.tradeCount == 0);
+    
+    // Volume is maximised at 100: bids >= 100 hold 200, asks <= 100 hold 180
+    auto indicative = engine.getIndicativeAuction("LT");
+    assert(indicative.price == 100.0);
+    assert(indicative.volume == 180);
+    assert(indicative.imbalance == 20);
+    
+    // A bid below every offer cannot trade and leaves the indicative unchanged
+    engine.placeOrder("U21", OrderType::BUY, "LT", 500, 90.0);
+    indicative = engine.getIndicativeAuction("LT");
+    assert(indicative.price == 100.0 && indicative.volume == 180);
+    
+    size_t tradeCount = engine.uncrossAuction("LT");
+    assert(tradeCount == 3);
+    Quantity executed = 0;
+    for (const auto& trade : observer.executedTrades) {
+        assert(trade->getPrice() == 100.0);
+        executed += trade->getQuantity();
+    }
+    assert(executed == 180);
+    
+    // Continuous trading resumes with the residual book
+    auto bids = engine.getBidDepth("LT", 1);
+    auto asks = engine.getAskDepth("LT", 1);
+    assert(bids[0].price == 100.0 && bids[0].quantity == 20);
+    assert(asks[0].price == 102.0);
+    
+    engine.unregisterObserver(&observer);
+    std::cout << "PASS: Call Auction Uncross Test" << std::endl;
+    return true;
+}
+
+bool testFrequentBatchAuction() {
+    std::cout << "\n=== Test 18: Frequent Batch Auction ===" << std::endl;
+    
+    auto& engine = TradingEngine::getInstance();
+    TestObserver observer;
+    engine.registerObserver(&observer);
+    
+    auto user = std::make_shared<User>("U22", "Batcher", "2222222223", "batch@test.com");
+    engine.registerUser(user);
+    
+    observer.reset();
+    
+    // A long interval keeps the batch open until it is flushed explicitly
+    engine.setBatchAuctionInterval("KOTAK", std::chrono::hours(1));
+    auto buy1 = engine.placeOrder("U22", OrderType::BUY, "KOTAK", 100, 1800.0);
+    auto buy2 = engine.placeOrder("U22", OrderType::BUY, "KOTAK", 100, 1790.0);
+    auto sell1 = engine.placeOrder("U22", OrderType::SELL, "KOTAK", 150, 1785.0);
+    auto sell2 = engine.placeOrder("U22", OrderType::SELL, "KOTAK", 50, 1780.0);
+    assert(buy1 && buy2 && sell1 && sell2);
+    assert(observer.tradeCount == 0);
+    assert(buy1->getStatus() == OrderStatus::PENDING);
+    assert(engine.runBatchAuctions() == 0);
+    
+    // Buffered orders can still be cancelled before the batch is cut
+    assert(engine.cancelOrder("U22", sell2->getOrderId()));
+    
+    // Switching back to continuous flushes the batch in one uncross at 1790:
+    // 200 bid at >= 1790 against 150 offered at <= 1790
+    engine.setBatchAuctionInterval("KOTAK", std::chrono::microseconds(0));
+    Quantity executed = 0;
+    for (const auto& trade : observer.executedTrades) {
+        assert(trade->getPrice() == 1790.0);
+        executed += trade->getQuantity();
+    }
+    assert(executed == 150);
+    assert(buy1->getStatus() == OrderStatus::FILLED);
+    assert(buy2->getRemainingQuantity() == 50);
+    assert(sell2->getStatus() == OrderStatus::CANCELLED);
+    
+    auto stats = engine.getBatchAuctionStats("KOTAK");
+    assert(stats.batches == 1);
+    assert(stats.ordersBatched == 3);
+
+    // Pegs take part in the uncross at their materialized price: an offer pegged
+    // two below the 101 ask sits at 99 and crosses the 99 bid
+    OrderBook pegBook("PEGBATCH");
+    pegBook.setBatchInterval(std::chrono::hours(1));
+    assert(pegBook.addOrder(std::make_shared<LimitOrder>("PB1", "U22", OrderType::BUY,
+                                                         "PEGBATCH", 10, 99.0)));
+    assert(pegBook.addOrder(std::make_shared<LimitOrder>("PS1", "U22", OrderType::SELL,
+                                                         "PEGBATCH", 10, 101.0)));
+    auto peg = std::make_shared<PeggedOrder>("PS2", "U22", OrderType::SELL, "PEGBATCH",
+                                             10, PegType::PRIMARY, -2.0);
+    assert(pegBook.addOrder(peg));
+    auto pegTrades = pegBook.runBatchAuction(true);
+    assert(pegTrades.size() == 1);
+    assert(pegTrades[0]->getSellerOrderId() == "PS2");
+    assert(pegTrades[0]->getPrice() == 99.0 && pegTrades[0]->getQuantity() == 10);
+    assert(peg->getStatus() == OrderStatus::FILLED);
+    assert(pegBook.getBidDepth(5).empty());
+    assert(pegBook.getAskDepth(5).size() == 1 && pegBook.getBestAsk() == 101.0);
+    
+    // A cancel racing the uncross always finds the order, in the batch buffer or
+    // already in the book, so it is never refused. A large batch keeps the cut busy
+    // sorting and inserting while the cancels arrive
+    {
+        OrderBook raceBook("BATCHRACE");
+        raceBook.setBatchInterval(std::chrono::hours(1));
+        std::vector<std::shared_ptr<Order>> resting;
+        for (int i = 0; i < 20000; ++i) {
+            resting.push_back(std::make_shared<LimitOrder>("BR" + std::to_string(i), "U22", OrderType::BUY,
+                                                           "BATCHRACE", 10, 90.0 + (i * 37 % 900) / 100.0));
+            assert(raceBook.addOrder(resting.back()));
+        }
+        std::thread cutter([&raceBook] { raceBook.runBatchAuction(true); });
+        for (const auto& order : resting) {
+            assert(raceBook.getOrder(order->getOrderId()) == order);
+            assert(raceBook.cancelOrder(order->getOrderId()));
+        }
+        cutter.join();
+        for (const auto& order : resting) assert(order->getStatus() == OrderStatus::CANCELLED);
+        assert(raceBook.getBidDepth(5).empty());
+    }
+    
+    // Batch entry of a run: the due uncross runs once after the run and its trades
+    // are all reported against the last order
+    OrderBook runBook("BATCHRUN");
+    runBook.setBatchInterval(std::chrono::microseconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    std::shared_ptr<Order> run[3] = {
+        std::make_shared<LimitOrder>("BRB", "U22", OrderType::BUY, "BATCHRUN", 10, 100.0),
+        std::make_shared<LimitOrder>("BRS", "U22", OrderType::SELL, "BATCHRUN", 10, 100.0),
+        std::make_shared<LimitOrder>("BRX", "U22", OrderType::SELL, "BATCHRUN", 5, 105.0),
+    };
+    std::vector<std::shared_ptr<Trade>> runTrades;
+    size_t runEnds[3];
+    assert(runBook.addOrders(run, 3, runTrades, runEnds) == 3);
+    assert(runTrades.size() == 1 && runTrades[0]->getQuantity() == 10);
+    assert(runEnds[0] == 0 && runEnds[1] == 0 && runEnds[2] == 1);
+
+    engine.unregisterObserver(&observer);
+    std::cout << "PASS: Frequent Batch Auction Test" << std::endl;
+    return true;
+}
+
+bool testProRataMatching() {
+    std::cout << "\n=== Test 19: Pro-Rata and FIFO+Pro-Rata Matching ===" << std::endl;
+    
+    auto& engine = TradingEngine::getInstance();
+    TestObserver observer;
+    engine.registerObserver(&observer);
+    
+    auto user = std::make_shared<User>("U23", "Allocator", "2222222224", "prorata@test.com");
+    engine.registerUser(user);
+    
+    observer.reset();
+    
+    // Pro-rata: 200 over 100/300/50 -> floors 44/133/22, the spare lot goes to the
+    // oldest order
+    engine.setMatchingAlgorithm("BAJAJ", MatchingAlgorithm::PRO_RATA);
+    auto sell1 = engine.placeOrder("U23", OrderType::SELL, "BAJAJ", 100, 500.0);
+    auto sell2 = engine.placeOrder("U23", OrderType::SELL, "BAJAJ", 300, 500.0);
+    auto sell3 = engine.placeOrder("U23", OrderType::SELL, "BAJAJ", 50, 500.0);
+    auto buy = engine.placeOrder("U23", OrderType::BUY, "BAJAJ", 200, 500.0);
+    assert(sell1 && sell2 && sell3 && buy);
+    assert(buy->getStatus() == OrderStatus::FILLED);
+    assert(observer.tradeCount == 3);
+    assert(sell1->getRemainingQuantity() == 55);
+    assert(sell2->getRemainingQuantity() == 167);
+    assert(sell3->getRemainingQuantity() == 28);
+    
+    // FIFO+pro-rata: the top order is filled first, the other 100 are shared
+    // between 300 and 50 -> 85/14 plus the spare lot to the older order
+    observer.reset();
+    engine.setMatchingAlgorithm("ASIANPAINT", MatchingAlgorithm::FIFO_PRO_RATA);
+    auto top = engine.placeOrder("U23", OrderType::SELL, "ASIANPAINT", 100, 3000.0);
+    auto large = engine.placeOrder("U23", OrderType::SELL, "ASIANPAINT", 300, 3000.0);
+    auto small = engine.placeOrder("U23", OrderType::SELL, "ASIANPAINT", 50, 3000.0);
+    auto sweep = engine.placeOrder("U23", OrderType::BUY, "ASIANPAINT", 200, 3000.0);
+    assert(top && large && small && sweep);
+    assert(sweep->getStatus() == OrderStatus::FILLED);
+    assert(top->getStatus() == OrderStatus::FILLED);
+    assert(large->getRemainingQuantity() == 214);
+    assert(small->getRemainingQuantity() == 36);
+    
+    auto depth = engine.getAskDepth("ASIANPAINT", 1);
+    assert(depth.size() == 1 && depth[0].quantity == 250 && depth[0].orderCount == 2);
+
+    // Auction uncrosses ration the surplus side with the same rule: two 10-lot
+    // bids against a 10-lot offer fill 5/5, not 10/0 in time priority
+    observer.reset();
+    engine.setMatchingAlgorithm("GAIL", MatchingAlgorithm::PRO_RATA);
+    engine.beginCallAuction("GAIL");
+    auto bid1 = engine.placeOrder("U23", OrderType::BUY, "GAIL", 10, 100.0);
+    auto bid2 = engine.placeOrder("U23", OrderType::BUY, "GAIL", 10, 100.0);
+    auto offer = engine.placeOrder("U23", OrderType::SELL, "GAIL", 10, 100.0);
+    assert(bid1 && bid2 && offer);
+    assert(engine.uncrossAuction("GAIL") == 2);
+    assert(offer->getStatus() == OrderStatus::FILLED);
+    assert(bid1->getRemainingQuantity() == 5);
+    assert(bid2->getRemainingQuantity() == 5);
+
+    engine.unregisterObserver(&observer);
+    std::cout << "PASS: Pro-Rata Matching Test" << std::endl;
+    return true;
+}
+
+// Same flow on every supported book combination; only the split of fills at a
+// level may differ between allocation policies
+template <typename Book>
+void exercisePolicyBook(const char* name) {
+    Book book("POLICY");
+    auto limit = [](const char* id, OrderType side, Quantity quantity, Price price) {
+        return std::make_shared<LimitOrder>(id, "U24", side, "POLICY", quantity, price);
+    };
+    auto tradedQuantity = [](const std::vector<std::shared_ptr<Trade>>& trades) {
+        Quantity total = 0;
+        for (const auto& trade : trades) total += trade->getQuantity();
+        return total;
+    };
+
+    assert(book.addOrder(limit("S1", OrderType::SELL, 100, 100.05)));
+    assert(book.addOrder(limit("S2", OrderType::SELL, 100, 100.05)));
+    assert(book.addOrder(limit("S3", OrderType::SELL, 50, 100.10)));
+    assert(book.getBestAsk() == 100.05);
+    
+    auto buy = limit("B1", OrderType::BUY, 120, 100.10);
+    assert(book.addOrder(buy));
+    auto trades = book.matchOrders();
+    assert(tradedQuantity(trades) == 120);
+    for (const auto& trade : trades) assert(trade->getPrice() == 100.05);
+    assert(buy->getStatus() == OrderStatus::FILLED);
+    
+    auto depth = book.getAskDepth(5);
+    assert(depth.size() == 2 && depth[0].price == 100.05 && depth[0].quantity == 80);
+    
+    // A market buy sweeps the rest of 100.05 and part of 100.10
+    assert(book.addOrder(std::make_shared<MarketOrder>("B2", "U24", OrderType::BUY, "POLICY", 100)));
+    trades = book.matchOrders();
+    assert(tradedQuantity(trades) == 100);
+    assert(book.getLastTradePrice() == 100.10);
+    assert(book.cancelOrder("S3"));
+    assert(book.getBestAsk() == 0.0);
+    
+    // Midpoint peg between 99.90 and 100.30
+    assert(book.addOrder(limit("B3", OrderType::BUY, 50, 99.90)));
+    assert(book.addOrder(limit("S4", OrderType::SELL, 50, 100.30)));
+    auto peg = std::make_shared<PeggedOrder>("B4", "U24", OrderType::BUY, "POLICY",
+                                             10, PegType::MIDPOINT, 0.0);
+    if constexpr (Book::FeatureSet::pegs) {
+        assert(book.addOrder(peg));
+        assert(std::abs(book.getBestBid() - 100.10) < 1e-9);
+        assert(book.getBuyOrders().size() == 2);
+    } else {
+        assert(!book.addOrder(peg));
+        assert(book.getBestBid() == 99.90 && book.getBuyOrders().size() == 1);
+    }
+    
+    // Books built without a feature turn its orders away and never enter its mode
+    auto stop = std::make_shared<StopOrder>("B5", "U24", OrderType::BUY, "POLICY", 10, 101.0);
+    assert(book.addOrder(stop) == Book::FeatureSet::stops);
+    auto gtd = limit("B6", OrderType::BUY, 10, 99.50);
+    gtd->setTimeInForce(OrderTimeInForce::GTD, std::chrono::system_clock::now() + std::chrono::hours(1));
+    assert(book.addOrder(gtd) == Book::FeatureSet::expiry);
+    assert(book.getScheduledExpiryCount() == (Book::FeatureSet::expiry ? 1u : 0u));
+    assert(book.setBatchInterval(std::chrono::milliseconds(1)) == Book::FeatureSet::batchAuctions);
+    assert(book.isBatchMode() == Book::FeatureSet::batchAuctions);
+    assert(book.setBatchInterval(std::chrono::microseconds(0)) && !book.isBatchMode());
+    
+    // Market orders meeting before any trade has printed: the newer one takes the
+    // limits behind the other side's market orders, which then trade at that price
+    auto market = [](const char* id, OrderType side, Quantity quantity) {
+        return std::make_shared<MarketOrder>(id, "U24", side, "OPENING", quantity);
+    };
+    Book opening("OPENING");
+    auto marketBuy = market("OB1", OrderType::BUY, 100);
+    assert(opening.addOrder(marketBuy) && opening.matchOrders().empty());
+    assert(opening.addOrder(market("OS1", OrderType::SELL, 50)) && opening.matchOrders().empty());
+    assert(opening.addOrder(std::make_shared<LimitOrder>("OS2", "U24", OrderType::SELL, "OPENING", 30, 101.0)));
+    trades = opening.matchOrders();
+    assert(trades.size() == 2 && tradedQuantity(trades) == 80);
+    assert(trades[0]->getPrice() == 101.0 && trades[0]->getQuantity() == 30);
+    assert(trades[1]->getPrice() == 101.0 && trades[1]->getSellerOrderId() == "OS1");
+    assert(marketBuy->getRemainingQuantity() == 20);
+    
+    // With no limits on the other side, the older one takes its own side's limits
+    Book reopening("OPENING");
+    auto marketSell = market("RS1", OrderType::SELL, 40);
+    assert(reopening.addOrder(marketSell) && reopening.matchOrders().empty());
+    assert(reopening.addOrder(market("RB1", OrderType::BUY, 40)) && reopening.matchOrders().empty());
+    assert(reopening.addOrder(std::make_shared<LimitOrder>("RB2", "U24", OrderType::BUY, "OPENING", 10, 99.0)));
+    trades = reopening.matchOrders();
+    assert(tradedQuantity(trades) == 40 && marketSell->getStatus() == OrderStatus::FILLED);
+    assert(trades[0]->getBuyerOrderId() == "RB2" && trades[0]->getPrice() == 99.0);
+    
+    std::cout << "  " << name << ": OK" << std::endl;
+}
+
+bool testPolicyOrderBooks() {
+    std::cout << "\n=== Test 20: Policy-Based Order Books ===" << std::endl;
+    
+    exercisePolicyBook<OrderBook>("tree / double / selectable / shared_mutex");
+    exercisePolicyBook<ShardOrderBook>("array ladder / ticks / FIFO / no locking");
+    exercisePolicyBook<SkipListOrderBook>("skip list / ticks / selectable / spin lock");
+    exercisePolicyBook<ProRataOrderBook>("tree / double / pro-rata / shared_mutex");
+    
+    // Fixed-policy books cannot be switched to another algorithm
+    ProRataOrderBook proRata("POLICY");
+    assert(proRata.getMatchingAlgorithm() == MatchingAlgorithm::PRO_RATA);
+    assert(!proRata.setMatchingAlgorithm(MatchingAlgorithm::FIFO));
+    
+    std::cout << "PASS: Policy-Based Order Book Test" << std::endl;
+    return true;
+}
+
+bool testLatencyHistograms() {
+    std::cout << "\n=== Test 21: Latency Histograms ===" << std::endl;
+    
+    // Values below 64 are exact; above that each power of two has 32 buckets
+    assert(LatencyHistogram::bucketOf(63) == 63);
+    assert(LatencyHistogram::bucketOf(64) == LatencyHistogram::bucketOf(65));
+    assert(LatencyHistogram::bucketOf(65) != LatencyHistogram::bucketOf(66));
+    assert(LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketOf(1000)) >= 1000);
+    assert(LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketOf(1000)) < 1032);
+    assert(LatencyHistogram::bucketOf(~CycleCount(0)) == LatencyHistogram::BUCKETS - 1);
+    
+    LatencyHistogram histogram;
+    for (CycleCount value = 1; value <= 1000; ++value) histogram.record(value);
+    histogram.record(1000000);
+    assert(histogram.getCount() == 1001);
+    assert(histogram.getMax() == 1000000);
+    CycleCount p50 = histogram.valueAtQuantile(0.50);
+    assert(p50 >= 501 && p50 <= 501 * 103 / 100);
+    assert(histogram.valueAtQuantile(1.0) == 1000000);
+
+#if TRADING_LATENCY_METRICS
+    auto& engine = TradingEngine::getInstance();
+    auto user = std::make_shared<User>("U25", "Timer", "2525252525", "timer@test.com");
+    engine.registerUser(user);
+    
+    LatencyMetrics::reset();
+    auto buy = engine.placeOrder("U25", OrderType::BUY, "LATENCY", 10, 100.0);
+    auto resting = engine.placeOrder("U25", OrderType::BUY, "LATENCY", 10, 99.0);
+    assert(buy && resting);
+    assert(engine.modifyOrder("U25", resting->getOrderId(), 20, 99.5));
+    assert(engine.cancelOrder("U25", buy->getOrderId()));
+    
+    // Samples recorded on another thread are merged into the same view
+    std::thread worker([] {
+        TradingEngine::getInstance().placeOrder("U25", OrderType::SELL, "LATENCY", 5, 101.0);
+    });
+    worker.join();
+    
+    assert(LatencyMetrics::snapshot(LatencyMetric::PLACE_ORDER).count == 3);
+    assert(LatencyMetrics::snapshot(LatencyMetric::CANCEL_ORDER).count == 1);
+    assert(LatencyMetrics::snapshot(LatencyMetric::MODIFY_ORDER).count == 1);
+    assert(LatencyMetrics::snapshot(LatencyMetric::MATCH_ORDERS).count >= 3);
+    assert(LatencyMetrics::snapshot(LatencyMetric::OBSERVER_DISPATCH).count > 0);
+    
+    LatencySnapshot place = LatencyMetrics::snapshot(LatencyMetric::PLACE_ORDER);
+    assert(place.p50Ns > 0 && place.p50Ns <= place.p99Ns);
+    assert(place.p99Ns <= place.p999Ns && place.p999Ns <= place.maxNs);
+    
+    std::ostringstream dump;
+    LatencyMetrics::dump(dump);
+    assert(dump.str().find("latency metric=place_order count=3") != std::string::npos);
+    
+    LatencyMetrics::reset();
+    assert(LatencyMetrics::snapshot(LatencyMetric::PLACE_ORDER).count == 0);
+#endif
+
+    std::cout << "PASS: Latency Histogram Test" << std::endl;
+    return true;
+}
+
+bool testTscClock() {
+    std::cout << "\n=== Test 22: Calibrated TSC Clock ===" << std::endl;
+    
+    const auto& calibration = TscClock::calibration();
+    assert(calibration.nsPerTick > 0.0);
+    
+    auto closeTo = [](std::int64_t a, std::int64_t b) { return std::llabs(a - b) < 2000000; };
+    auto systemNs = [](auto timePoint) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(timePoint.time_since_epoch()).count();
+    };
+
+    // Conversions agree with both kernel clocks to within a couple of milliseconds
+    CycleCount ticks = TscClock::now();
+    assert(closeTo(systemNs(TscClock::toTimestamp(ticks)), systemNs(std::chrono::system_clock::now())));
+    assert(closeTo(TscClock::toMonotonicNs(ticks), systemNs(std::chrono::steady_clock::now())));
+    
+    CycleCount before = TscClock::now();
+    auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(10);
+    while (std::chrono::steady_clock::now() < until) {}
+    auto elapsed = TscClock::toDuration(TscClock::now() - before);
+    assert(elapsed >= std::chrono::milliseconds(9) && elapsed < std::chrono::milliseconds(50));
+    
+    // Orders carry raw ticks from entry on; wall time is only produced when asked for
+    const Clock& realTime = RealTimeClock::instance();
+    LimitOrder first("TSC1", "U1", OrderType::BUY, "TSC", 10, 100.0);
+    LimitOrder second("TSC2", "U1", OrderType::BUY, "TSC", 10, 100.0);
+    assert(first.getEntryTicks() == 0);
+    first.stampEntry(realTime);
+    second.stampEntry(realTime);
+    assert(first.getEntryTicks() <= second.getEntryTicks());
+    assert(closeTo(systemNs(first.getTimestamp()), systemNs(std::chrono::system_clock::now())));
+    
+    // Re-anchoring keeps earlier stamps converting to the same instant, and a
+    // stamp taken after it never converts to an earlier one
+    auto stampBefore = systemNs(first.getTimestamp());
+    auto monotonicBefore = TscClock::toMonotonicNs(first.getEntryTicks());
+    for (size_t i = 0; i < TscClock::CALIBRATION_HISTORY / 2; ++i) TscClock::recalibrate();
+    LimitOrder third("TSC3", "U1", OrderType::BUY, "TSC", 10, 100.0);
+    third.stampEntry(realTime);
+    assert(systemNs(first.getTimestamp()) == stampBefore);
+    assert(TscClock::toMonotonicNs(first.getEntryTicks()) == monotonicBefore);
+    assert(systemNs(third.getTimestamp()) >= systemNs(second.getTimestamp()));
+    assert(closeTo(systemNs(third.getTimestamp()), systemNs(std::chrono::system_clock::now())));
+    
+    std::cout << "PASS: Calibrated TSC Clock Test" << std::endl;
+    return true;
+}
+
+// One scripted session on a private engine with simulated time; returns every
+// trade and order update as text so two runs can be compared byte for byte
+std::string runSimulatedSession() {
+    auto start = Timestamp(std::chrono::hours(24 * 365 * 50));
+    auto clock = std::make_shared<SimulatedClock>(start);
+    TradingEngine engine(clock, std::make_shared<SequentialIdGenerator>("SIM"));
+    TestObserver observer;
+    engine.registerObserver(&observer);
+    
+    engine.registerUser(std::make_shared<User>("S1", "Sim One", "1111111112", "s1@test.com"));
+    engine.registerUser(std::make_shared<User>("S2", "Sim Two", "1111111113", "s2@test.com"));
+    
+    auto gtd = engine.placeOrder("S1", OrderType::BUY, "SIM", 100, 99.0, OrderTimeInForce::GTD,
+                                 start + std::chrono::minutes(5));
+    assert(gtd && gtd->getOrderId() == "SIM-1");
+    assert(gtd->getTimestamp() == start);
+    
+    clock->advanceBy(std::chrono::seconds(1));
+    engine.placeOrder("S1", OrderType::BUY, "SIM", 100, 100.0);
+    clock->advanceBy(std::chrono::milliseconds(250));
+    engine.placeOrder("S2", OrderType::SELL, "SIM", 150, 99.0);
+    
+    // Expiry follows the simulated clock: an hour passes instantly
+    clock->advanceTo(start + std::chrono::hours(1));
+    assert(engine.processExpirations() == 1);
+    assert(gtd->getStatus() == OrderStatus::EXPIRED);
+    
+    // Throttling runs on simulated time too
+    engine.setUserThrottle("S2", ThrottleConfig{0.0, 1.0, 1.0, 1.0});
+    assert(engine.placeOrder("S2", OrderType::SELL, "SIM", 10, 101.0));
+    assert(!engine.placeOrder("S2", OrderType::SELL, "SIM", 10, 101.0));
+    clock->advanceBy(std::chrono::seconds(1));
+    assert(engine.placeOrder("S2", OrderType::SELL, "SIM", 10, 101.0));
+    
+    std::ostringstream out;
+    auto nanos = [](Timestamp t) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+    };
+    for (const auto& trade : observer.executedTrades) {
+        out << trade->getTradeId() << " " << trade->getBuyerOrderId() << " "
+            << trade->getSellerOrderId() << " " << trade->getQuantity() << "@"
+            << trade->getPrice() << " t=" << nanos(trade->getTimestamp()) << "\n";
+    }
+    for (const auto& order : observer.statusChangedOrders) {
+        out << order->getOrderId() << " " << static_cast<int>(order->getStatus())
+            << " t=" << nanos(order->getTimestamp()) << "\n";
+    }
+    
+    engine.unregisterObserver(&observer);
+    return out.str();
+}
+
+bool testDeterministicSimulation() {
+    std::cout << "\n=== Test 23: Deterministic Simulated Time and IDs ===" << std::endl;
+    
+    std::string first = runSimulatedSession();
+    std::string second = runSimulatedSession();
+    assert(!first.empty());
+    assert(first == second);
+    
+    // The first trade was stamped at the simulated instant it executed
+    auto executedAt = std::chrono::hours(24 * 365 * 50) + std::chrono::milliseconds(1250);
+    std::string expected = "SIM-4 SIM-2 SIM-3 100@99 t=" +
+        std::to_string(std::chrono::duration_cast<std::chrono::nanoseconds>(executedAt).count());
+    assert(first.compare(0, expected.size(), expected) == 0);
+    
+    std::cout << "PASS: Deterministic Simulation Test" << std::endl;
+    return true;
+}
+
+// Silent observer that renders every trade as one line
+class TradeTape : public TradeObserver {
+public:
+    std::string tape;
+    
+    void onTradeExecuted(const std::shared_ptr<Trade>& trade) override {
+        tape += trade->getTradeId() + " " + trade->getBuyerOrderId() + " " +
+                trade->getSellerOrderId() + " " + std::to_string(trade->getQuantity()) + "@" +
+                std::to_string(trade->getPrice()) + " t=" +
+                std::to_string(trade->getTimestamp().time_since_epoch().count()) + "\n";
+    }
+    void onOrderStatusChanged(const std::shared_ptr<Order>&) override {}
+};
+
+bool testIndependentEngines() {
+    std::cout << "\n=== Test 24: Independent Engine Instances ===" << std::endl;
+    
+    // Users, books and orders belong to one engine only
+    TradingEngine first;
+    TradingEngine second;
+    assert(first.registerUser(std::make_shared<User>("E1", "Engine One", "2424242424", "e1@test.com")));
+    assert(first.getUser("E1") && !second.getUser("E1"));
+    assert(!TradingEngine::getInstance().getUser("E1"));
+    auto order = first.placeOrder("E1", OrderType::BUY, "ENGINE", 10, 100.0);
+    assert(order);
+    assert(first.getBidDepth("ENGINE", 1).size() == 1);
+    assert(second.getBidDepth("ENGINE", 1).empty());
+    assert(!second.cancelOrder("E1", order->getOrderId()));
+    
+    // Engines on their own threads, each with its own clock and id space, replay the
+    // same flow to identical trade tapes
+    const int engines = 4;
+    std::vector<std::string> tapes(engines);
+    std::vector<std::thread> threads;
+    for (int e = 0; e < engines; ++e) {
+        threads.emplace_back([&tapes, e] {
+            auto clock = std::make_shared<SimulatedClock>();
+            TradingEngine engine(clock, std::make_shared<SequentialIdGenerator>("E"));
+            engine.registerUser(std::make_shared<User>("P1", "Buyer", "2424242425", "p1@test.com"));
+            engine.registerUser(std::make_shared<User>("P2", "Seller", "2424242426", "p2@test.com"));
+            TradeTape tape;
+            engine.registerObserver(&tape);
+            
+            for (int i = 0; i < 200; ++i) {
+                clock->advanceBy(std::chrono::milliseconds(1));
+                bool buy = i % 2 == 0;
+                engine.placeOrder(buy ? "P1" : "P2", buy ? OrderType::BUY : OrderType::SELL,
+                                  "PARALLEL", 10 + i % 7, 99.0 + (i % 5) * 0.5);
+            }
+            
+            engine.unregisterObserver(&tape);
+            tapes[e] = tape.tape;
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    
+    assert(!tapes[0].empty());
+    for (int e = 1; e < engines; ++e) assert(tapes[e] == tapes[0]);
+    
+    std::cout << "PASS: Independent Engine Instances Test" << std::endl;
+    return true;
+}
+
+bool testBacktestReplay() {
+    std::cout << "\n=== Test 25: Backtest Replay ===" << std::endl;
+    
+    auto event = [](std::int64_t ns, FlowAction action, const char* user, OrderType side,
+                    Quantity quantity, Price price, std::uint64_t reference) {
+        FlowEvent e;
+        e.timestampNs = ns;
+        e.action = action;
+        e.user = user;
+        e.symbol = "REPLAY";
+        e.side = side;
+        e.quantity = quantity;
+        e.price = price;
+        e.reference = reference;
+        return e;
+    };
+    const std::int64_t t0 = 1700000000000000000LL;
+    std::vector<FlowEvent> flow = {
+        event(t0 + 1000, FlowAction::NEW, "R1", OrderType::BUY, 100, 99.0, 1),
+        event(t0 + 2000, FlowAction::NEW, "R2", OrderType::SELL, 50, 99.0, 2),     // fills 50 @ 99
+        event(t0 + 3000, FlowAction::NEW, "R3", OrderType::BUY, 100, 98.0, 3),
+        event(t0 + 4000, FlowAction::MODIFY, "R3", OrderType::BUY, 80, 98.5, 3),
+        event(t0 + 5000, FlowAction::CANCEL, "R1", OrderType::BUY, 0, 0.0, 1),
+        event(t0 + 6000, FlowAction::NEW, "R2", OrderType::SELL, 200, 98.5, 6),    // fills 80 @ 98.5
+        event(t0 + 7000, FlowAction::CANCEL, "R1", OrderType::BUY, 0, 0.0, 1),     // already gone
+    };
+
+    const std::string csvPath = "/tmp/trading_system_backtest.csv";
+    const std::string binPath = "/tmp/trading_system_backtest.bin";
+    {
+        std::ofstream csv(csvPath, std::ios::trunc);
+        writeCsvFlow(csv, flow);
+        csv << "not,a,valid,line\n";
+        std::ofstream bin(binPath, std::ios::binary | std::ios::trunc);
+        writeBinaryFlow(bin, flow);
+    }
+    
+    // Both formats parse to the same events; the bad CSV line is counted, not fatal
+    {
+        MappedFile csvFile(csvPath), binFile(binPath);
+        OrderFlowReader csv(csvFile), bin(binFile);
+        assert(!csv.isBinary() && bin.isBinary());
+        FlowEvent a, b;
+        size_t count = 0;
+        while (csv.next(a)) {
+            assert(bin.next(b));
+            assert(a.timestampNs == b.timestampNs && a.action == b.action && a.user == b.user);
+            assert(a.symbol == b.symbol && a.quantity == b.quantity && a.price == b.price);
+            assert(a.reference == b.reference);
+            ++count;
+        }
+        assert(!bin.next(b));
+        assert(count == flow.size());
+        assert(csv.getMalformedCount() == 1 && bin.getMalformedCount() == 0);
+    }
+    
+    std::vector<BacktestScenario> scenarios;
+    for (const auto& input : {csvPath, binPath}) {
+        for (auto algorithm : {MatchingAlgorithm::FIFO, MatchingAlgorithm::PRO_RATA}) {
+            BacktestScenario scenario;
+            scenario.name = input + (algorithm == MatchingAlgorithm::FIFO ? "/fifo" : "/pro_rata");
+            scenario.inputPath = input;
+            scenario.matchingAlgorithm = algorithm;
+            scenario.tapePath = input + (algorithm == MatchingAlgorithm::FIFO ? ".fifo" : ".pro_rata") + ".trades";
+            scenarios.push_back(scenario);
+        }
+    }
+    BacktestScenario missing;
+    missing.name = "missing";
+    missing.inputPath = "/tmp/trading_system_backtest.does_not_exist";
+    scenarios.push_back(missing);
+    
+    auto results = BacktestRunner(2).run(scenarios);
+    assert(results.size() == scenarios.size());
+    for (size_t i = 0; i < 4; ++i) {
+        const auto& stats = results[i];
+        assert(stats.error.empty() && stats.scenario == scenarios[i].name);
+        assert(stats.events == flow.size());
+        assert(stats.rejected == 1);
+        assert(stats.trades == 2 && stats.volume == 130);
+        assert(std::abs(stats.vwap - (50 * 99.0 + 80 * 98.5) / 130) < 1e-9);
+    }
+    assert(!results[4].error.empty());
+    
+    // Replays are deterministic: same input, same tape, whatever the format or run
+    auto slurp = [](const std::string& path) {
+        std::ifstream in(path);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    };
+    std::string tape = slurp(scenarios[0].tapePath);
+    assert(std::count(tape.begin(), tape.end(), '\n') == 3);
+    assert(slurp(scenarios[2].tapePath) == tape);
+    BacktestRunner::runScenario(scenarios[0]);
+    assert(slurp(scenarios[0].tapePath) == tape);
+    
+    // A GTD order expires on replay time alone: no processExpirations call, yet the
+    // sells journalled after its expiry find nothing to trade with
+    {
+        auto clock = std::make_shared<SimulatedClock>(Timestamp(std::chrono::nanoseconds(t0)));
+        TradingEngine engine(clock, std::make_shared<SequentialIdGenerator>("GTD"));
+        TestObserver observer;
+        engine.registerObserver(&observer);
+        engine.registerUser(std::make_shared<User>("RG", "Replay GTD", "2525252525", "rg@test.com"));
+        auto gtd = engine.placeOrder("RG", OrderType::BUY, "REPLAY", 100, 99.0, OrderTimeInForce::GTD,
+                                     Timestamp(std::chrono::nanoseconds(t0 + 5000000)));
+        assert(gtd);
+        
+        std::vector<FlowEvent> late = {
+            event(t0 + 1000000, FlowAction::NEW, "R2", OrderType::SELL, 10, 99.0, 1),   // before expiry
+            event(t0 + 6000000, FlowAction::NEW, "R2", OrderType::SELL, 10, 99.0, 2),   // after it
+            event(t0 + 7000000, FlowAction::NEW, "R2", OrderType::SELL, 10, 99.0, 3),   // one run
+            event(t0 + 7000000, FlowAction::NEW, "R2", OrderType::SELL, 10, 98.0, 4),
+        };
+        std::ostringstream csv;
+        writeCsvFlow(csv, late);
+        std::string text = csv.str();
+        OrderFlowReader reader(text.data(), text.size());
+        OrderFlowLoader loader(engine, clock.get());
+        assert(loader.load(reader) == late.size());
+        
+        assert(gtd->getStatus() == OrderStatus::EXPIRED && gtd->getFilledQuantity() == 10);
+        assert(observer.executedTrades.size() == 1);
+        assert(engine.getBidDepth("REPLAY", 5).empty());
+        assert(engine.getAskDepth("REPLAY", 5).size() == 2);
+        engine.unregisterObserver(&observer);
+    }
+    
+    std::cout << "PASS: Backtest Replay Test" << std::endl;
+    return true;
+}
+
+bool testOrderFlowIngestion() {
+    std::cout << "\n=== Test 26: Order Flow Ingestion ===" << std::endl;
+    
+    // CRLF endings, a long id, a 17-digit reference, a signed timestamp that has to
+    // take the from_chars path, and no newline after the last line
+    const std::string csv =
+        "timestamp_ns,action,user,symbol,side,quantity,price,reference\r\n"
+        "1700000000000001000,N,I1,INGEST,B,100,101.25,12345678901234567\r\n"
+        "1700000000000002000,N,IngestUserWithALongName,INGEST,S,40,101.3,2\n"
+        "\n"
+        "1700000000000003000,N,I1,INGEST,X,10,101,3\n"                // bad side
+        "1700000000000003000,N,I1,INGEST,B,10,101,4,extra\n"          // too many fields
+        "17000000000000030x0,N,I1,INGEST,B,10,101,5\n"                // bad timestamp
+        "-5,M,I1,INGEST,,60,101.5,12345678901234567\n"
+        "1700000000000005000,C,I1,INGEST,,,,12345678901234567";
+        
+    OrderFlowReader reader(csv.data(), csv.size());
+    std::vector<FlowEvent> events;
+    FlowEvent event;
+    while (reader.next(event)) events.push_back(event);
+    assert(events.size() == 4);
+    assert(reader.getMalformedCount() == 3);
+    assert(events[0].timestampNs == 1700000000000001000LL && events[0].side == OrderType::BUY);
+    assert(events[0].quantity == 100 && events[0].price == 101.25);
+    assert(events[0].reference == 12345678901234567ULL && events[0].symbol == "INGEST");
+    assert(events[1].user == "IngestUserWithALongName" && events[1].price == 101.3);
+    assert(events[1].side == OrderType::SELL);
+    assert(events[2].timestampNs == -5 && events[2].action == FlowAction::MODIFY && events[2].price == 101.5);
+    assert(events[3].action == FlowAction::CANCEL && events[3].reference == events[0].reference);
+    
+    // Converted once to binary, the journal reads back the same; the event whose user
+    // id does not fit the 16-byte field is dropped with the malformed lines, not cut short
+    const std::string csvPath = "/tmp/trading_system_ingest_test.csv";
+    const std::string binPath = "/tmp/trading_system_ingest_test.bin";
+    {
+        std::ofstream out(csvPath, std::ios::trunc);
+        out << csv;
+    }
+    size_t dropped = 0;
+    assert(convertCsvToBinary(csvPath, binPath, &dropped) == events.size() - 1);
+    assert(dropped == 4);
+    MappedFile binFile(binPath);
+    OrderFlowReader binary(binFile);
+    assert(binary.isBinary());
+    for (const auto& expected : events) {
+        if (expected.user.size() > 16) continue;
+        assert(binary.next(event));
+        assert(event.timestampNs == expected.timestampNs && event.reference == expected.reference);
+        assert(event.price == expected.price && event.quantity == expected.quantity);
+        assert(event.user == expected.user);
+    }
+    assert(!binary.next(event));
+    {
+        std::ostringstream out;
+        bool threw = false;
+        try {
+            writeBinaryFlow(out, events);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    
+    // Loading in small batches gives the engine the same commands as one event at a time
+    TradingEngine engine;
+    OrderFlowLoader loader(engine, nullptr, 3);
+    OrderFlowReader replay(csv.data(), csv.size());
+    assert(loader.load(replay) == 4);
+    assert(loader.getSubmittedCount() == 4 && loader.getRejectedCount() == 0);
+    assert(loader.getSymbols().count("INGEST") == 1);
+    assert(engine.getUser("I1") && engine.getUser("IngestUserWithALongName"));
+    assert(engine.getBidDepth("INGEST", 5).empty());   // modify crossed the offer, cancel took the rest
+    assert(engine.getAskDepth("INGEST", 5).empty());
+    
+    // References of filled orders are forgotten too, so a long replay that never
+    // cancels keeps only its resting orders mapped
+    std::vector<FlowEvent> fills;
+    const std::int64_t t0 = 1700000000000000000LL;
+    for (std::uint64_t i = 0; i < 5000; ++i) {
+        FlowEvent fill;
+        fill.timestampNs = t0 + static_cast<std::int64_t>(i);
+        fill.user = "I2";
+        fill.symbol = "INGEST";
+        fill.side = i % 2 == 0 ? OrderType::BUY : OrderType::SELL;
+        fill.quantity = 10;
+        fill.price = 100.0;
+        fill.reference = 100 + i;
+        fills.push_back(fill);
+    }
+    for (const auto& fill : fills) loader.submit(&fill, 1);   // each buy rests until its sell
+    assert(loader.getOpenReferenceCount() < fills.size() / 4);
+    assert(engine.getBidDepth("INGEST", 5).empty() && engine.getAskDepth("INGEST", 5).empty());
+    
+    // A modify replaces the order, so the loader must follow the reference to the
+    // new object or a modified order that later fills is never recognised as done
+    TradingEngine modifyEngine;
+    OrderFlowLoader modifyLoader(modifyEngine);
+    const size_t modified = 3000;
+    for (std::uint64_t i = 0; i < modified; ++i) {
+        FlowEvent step;
+        step.timestampNs = t0 + static_cast<std::int64_t>(i);
+        step.user = "I3";
+        step.symbol = "INGEST";
+        step.price = 100.0;
+        step.reference = i;
+        step.side = OrderType::BUY;
+        step.quantity = 10;
+        modifyLoader.submit(&step, 1);
+        step.action = FlowAction::MODIFY;
+        step.quantity = 20;
+        modifyLoader.submit(&step, 1);
+        step.action = FlowAction::NEW;
+        step.side = OrderType::SELL;
+        step.reference = modified + i;
+        modifyLoader.submit(&step, 1);
+    }
+    assert(modifyLoader.getRejectedCount() == 0);
+    assert(modifyEngine.getBidDepth("INGEST", 5).empty());
+    assert(modifyLoader.getOpenReferenceCount() < modified / 2);
+    
+    std::cout << "PASS: Order Flow Ingestion Test" << std::endl;
+    return true;
+}
+
+bool testBatchOrderEntry() {
+    std::cout << "\n=== Test 27: Batch Order Entry ===" << std::endl;
+    
+    // Fills per symbol in execution order; ids differ between the two paths because
+    // a batch draws every order id before it matches
+    class SymbolTape : public TradeObserver {
+    public:
+        std::map<Symbol, std::string> fills;
+        size_t statusUpdates = 0;
+        void onTradeExecuted(const std::shared_ptr<Trade>& trade) override {
+            fills[trade->getSymbol()] += std::to_string(trade->getQuantity()) + "@" +
+                                         std::to_string(trade->getPrice()) + " ";
+        }
+        void onOrderStatusChanged(const std::shared_ptr<Order>&) override { ++statusUpdates; }
+    };
+
+    const std::vector<Symbol> symbols = {"BATCHA", "BATCHB", "BATCHC"};
+    std::vector<OrderRequest> requests;
+    for (int i = 0; i < 300; ++i) {
+        OrderRequest request;
+        request.userId = i % 3 ? "B1" : "B2";
+        request.symbol = symbols[(i * 7) % 3];
+        request.orderType = (i / 3) % 2 ? OrderType::SELL : OrderType::BUY;
+        request.quantity = 10 + i % 13;
+        request.price = 100.0 + ((i * 11) % 9 - 4) * 0.5;
+        if (i % 37 == 0) request.price = 0.0;              // market order
+        if (i % 41 == 0) request.userId = "NOBODY";        // unknown user
+        if (i % 43 == 0) request.price = -1.0;             // invalid price
+        if (i % 47 == 0) request.quantity = 0;             // invalid quantity
+        if (i % 53 == 0) request.timeInForce = OrderTimeInForce::DAY;
+        requests.push_back(request);
+    }
+    
+    auto makeEngine = [](TradingEngine& engine) {
+        engine.registerUser(std::make_shared<User>("B1", "Batch One", "2727272727", "b1@test.com"));
+        engine.registerUser(std::make_shared<User>("B2", "Batch Two", "2727272728", "b2@test.com"));
+    };
+    TradingEngine oneByOne(std::make_shared<SimulatedClock>(), std::make_shared<SequentialIdGenerator>("S"));
+    TradingEngine batched(std::make_shared<SimulatedClock>(), std::make_shared<SequentialIdGenerator>("B"));
+    makeEngine(oneByOne);
+    makeEngine(batched);
+    SymbolTape sequentialTape, batchTape;
+    oneByOne.registerObserver(&sequentialTape);
+    batched.registerObserver(&batchTape);
+    
+    std::vector<bool> placedOneByOne;
+    for (const auto& r : requests) {
+        placedOneByOne.push_back(oneByOne.placeOrder(r.userId, r.orderType, r.symbol, r.quantity,
+                                                     r.price, r.timeInForce, r.expireTime) != nullptr);
+    }
+    
+    // Uneven batch sizes, so runs of one symbol span batch boundaries
+    std::vector<std::shared_ptr<Order>> results(requests.size());
+    size_t placed = 0;
+    for (size_t offset = 0, size = 1; offset < requests.size(); offset += size, size = size * 2 + 1) {
+        size = std::min(size, requests.size() - offset);
+        placed += batched.placeOrders(std::span(requests).subspan(offset, size),
+                                      std::span(results).subspan(offset, size));
+    }
+    
+    size_t expectedPlaced = 0;
+    for (size_t i = 0; i < requests.size(); ++i) {
+        assert((results[i] != nullptr) == placedOneByOne[i]);
+        if (results[i]) {
+            assert(results[i]->getSymbol() == requests[i].symbol);
+            assert(batched.getOrderStatus(requests[i].userId, results[i]->getOrderId()) == results[i]);
+            ++expectedPlaced;
+        }
+    }
+    assert(placed == expectedPlaced && placed < requests.size());
+    
+    // Each book ends up exactly where one-by-one placement left it
+    for (const auto& symbol : symbols) {
+        assert(!sequentialTape.fills[symbol].empty());
+        assert(batchTape.fills[symbol] == sequentialTape.fills[symbol]);
+        auto expectBids = oneByOne.getBidDepth(symbol, 20), bids = batched.getBidDepth(symbol, 20);
+        auto expectAsks = oneByOne.getAskDepth(symbol, 20), asks = batched.getAskDepth(symbol, 20);
+        assert(bids.size() == expectBids.size() && asks.size() == expectAsks.size());
+        for (size_t l = 0; l < bids.size(); ++l) {
+            assert(bids[l].price == expectBids[l].price && bids[l].quantity == expectBids[l].quantity);
+        }
+        for (size_t l = 0; l < asks.size(); ++l) {
+            assert(asks[l].price == expectAsks[l].price && asks[l].quantity == expectAsks[l].quantity);
+        }
+    }
+    assert(batchTape.statusUpdates == placed);
+    
+    // Books run in the order their symbols first appear in the batch, whatever
+    // order they were created or allocated in
+    {
+        class SymbolOrder : public TradeObserver {
+        public:
+            std::vector<Symbol> symbols;
+            void onTradeExecuted(const std::shared_ptr<Trade>& trade) override {
+                symbols.push_back(trade->getSymbol());
+            }
+            void onOrderStatusChanged(const std::shared_ptr<Order>&) override {}
+        };
+        TradingEngine engine(std::make_shared<SimulatedClock>(), std::make_shared<SequentialIdGenerator>("O"));
+        makeEngine(engine);
+        const std::vector<Symbol> books = {"ORDERA", "ORDERB", "ORDERC", "ORDERD"};
+        for (const auto& symbol : books) assert(engine.placeOrder("B1", OrderType::SELL, symbol, 100, 100.0));
+        SymbolOrder order;
+        engine.registerObserver(&order);
+        std::vector<OrderRequest> crossing;
+        for (const auto& symbol : {"ORDERC", "ORDERA", "ORDERD", "ORDERA", "ORDERB", "ORDERC"}) {
+            OrderRequest request;
+            request.userId = "B2";
+            request.symbol = symbol;
+            request.quantity = 10;
+            request.price = 100.0;
+            crossing.push_back(request);
+        }
+        std::vector<std::shared_ptr<Order>> crossed(crossing.size());
+        assert(engine.placeOrders(crossing, crossed) == crossing.size());
+        assert((order.symbols == std::vector<Symbol>{"ORDERC", "ORDERC", "ORDERA", "ORDERA", "ORDERD", "ORDERB"}));
+        engine.unregisterObserver(&order);
+    }
+    
+    // Nothing is placed while the venue is halted
+    batched.setKillSwitch(true);
+    assert(batched.placeOrders(std::span(requests).first(10), results) == 0);
+    assert(!results[1]);
+    batched.setKillSwitch(false);
+    
+    oneByOne.unregisterObserver(&sequentialTape);
+    batched.unregisterObserver(&batchTape);
+    
+    std::cout << "PASS: Batch Order Entry Test" << std::endl;
+    return true;
+}
+
+bool testAsyncOrderGateway() {
+    std::cout << "\n=== Test 28: Asynchronous Order Gateway ===" << std::endl;
+    
+    TradingEngine engine;
+    engine.registerUser(std::make_shared<User>("G1", "Gateway Buyer", "2828282828", "g1@test.com"));
+    engine.registerUser(std::make_shared<User>("G2", "Gateway Seller", "2828282829", "g2@test.com"));
+    
+    std::vector<Completion> drained;
+    auto drain = [&drained](CompletionQueue& queue) {
+        drained.clear();
+        Completion batch[16];
+        while (size_t count = queue.poll(batch, 16)) {
+            drained.insert(drained.end(), batch, batch + count);
+        }
+        return drained.size();
+    };
+
+    AsyncOrderGateway gateway(engine, 2);
+    auto buyer = gateway.connect("G1");
+    auto seller = gateway.connect("G2");
+    assert(gateway.connect("G1") == buyer);
+    assert(gateway.submitOrder("G3", OrderType::BUY, "ASYNC", 10, 100.0) == 0);   // no session
+    
+    // A client keeps many orders in flight without waiting for any of them
+    std::vector<Ticket> buys;
+    for (int i = 0; i < 100; ++i) {
+        buys.push_back(gateway.submitOrder("G1", OrderType::BUY, "ASYNC", 10, 100.0));
+        assert(buys.back() != 0 && (i == 0 || buys[i] > buys[i - 1]));
+    }
+    Ticket sell = gateway.submitOrder("G2", OrderType::SELL, "ASYNC", 1000, 100.0);
+    Ticket badPrice = gateway.submitOrder("G2", OrderType::SELL, "ASYNC", 10, -1.0);
+    gateway.flush();
+    
+    // Every buy is acked before it is filled; fills carry the placing ticket
+    assert(drain(*buyer) == 200);
+    std::map<Ticket, int> state;   // 0 = nothing seen, 1 = acked, 2 = filled
+    for (const auto& completion : drained) {
+        if (completion.type == CompletionType::ACCEPTED) {
+            assert(state[completion.ticket] == 0 && !completion.orderId.empty());
+            state[completion.ticket] = 1;
+        } else {
+            assert(completion.type == CompletionType::FILL);
+            assert(state[completion.ticket] == 1 && completion.quantity == 10 && completion.price == 100.0);
+            state[completion.ticket] = 2;
+        }
+    }
+    for (Ticket ticket : buys) assert(state[ticket] == 2);
+    
+    drain(*seller);
+    Quantity sold = 0;
+    bool sellAcked = false, badRejected = false;
+    for (const auto& completion : drained) {
+        if (completion.ticket == sell && completion.type == CompletionType::ACCEPTED) sellAcked = true;
+        if (completion.ticket == sell && completion.type == CompletionType::FILL) sold += completion.quantity;
+        if (completion.ticket == badPrice) badRejected = completion.type == CompletionType::REJECTED;
+    }
+    assert(sellAcked && sold == 1000 && badRejected);
+    
+    // Cancels and modifies are answered with their own tickets
+    Ticket rest = gateway.submitOrder("G1", OrderType::BUY, "ASYNC", 50, 90.0);
+    assert(buyer->waitFor(std::chrono::seconds(5)));
+    gateway.flush();
+    assert(drain(*buyer) == 1 && drained[0].ticket == rest && drained[0].type == CompletionType::ACCEPTED);
+    OrderId restingId = drained[0].orderId;
+    
+    Ticket modify = gateway.submitModify("G1", restingId, 30, 91.0);
+    Ticket cancel = gateway.submitCancel("G1", restingId);
+    Ticket cancelAgain = gateway.submitCancel("G1", restingId);
+    Ticket foreignCancel = gateway.submitCancel("G2", restingId);
+    gateway.flush();
+    assert(drain(*buyer) == 3);
+    assert(drained[0].ticket == modify && drained[0].type == CompletionType::MODIFIED);
+    assert(drained[1].ticket == cancel && drained[1].type == CompletionType::CANCELLED);
+    assert(drained[2].ticket == cancelAgain && drained[2].type == CompletionType::REJECTED);
+    assert(drain(*seller) == 1 && drained[0].ticket == foreignCancel);
+    assert(drained[0].type == CompletionType::REJECTED);
+    assert(engine.getBidDepth("ASYNC", 5).empty());
+    
+    // Queued requests still run when the gateway shuts down
+    std::shared_ptr<CompletionQueue> late;
+    {
+        AsyncOrderGateway closing(engine);
+        late = closing.connect("G1");
+        for (int i = 0; i < 20; ++i) closing.submitOrder("G1", OrderType::BUY, "ASYNC", 1, 80.0);
+    }
+    assert(late->size() == 20);
+    
+    // Several workers on one symbol: a worker can fill another worker's new order
+    // before that order is acked, and the fill must still reach the placing ticket
+    {
+        TradingEngine shared;
+        AsyncOrderGateway crowd(shared, 4);
+        const int clients = 8;
+        const int perClient = 400;
+        std::vector<std::shared_ptr<CompletionQueue>> queues;
+        for (int c = 0; c < clients; ++c) {
+            UserId user = "GC" + std::to_string(c);
+            shared.registerUser(std::make_shared<User>(user, "Crowd", "2828282830", "gc@test.com"));
+            queues.push_back(crowd.connect(user));
+        }
+        std::map<Ticket, Quantity> submitted;
+        for (int i = 0; i < perClient; ++i) {
+            for (int c = 0; c < clients; ++c) {
+                OrderType side = (c + i) % 2 == 0 ? OrderType::BUY : OrderType::SELL;
+                Quantity quantity = 1 + (c * 7 + i) % 9;
+                Ticket ticket = crowd.submitOrder("GC" + std::to_string(c), side, "CROWD", quantity, 100.0);
+                submitted[ticket] = quantity;
+            }
+        }
+        crowd.flush();
+        
+        std::map<Ticket, Quantity> filled;
+        std::map<Ticket, std::pair<UserId, OrderId>> placed;
+        Quantity totalFilled = 0;
+        for (int c = 0; c < clients; ++c) {
+            drain(*queues[c]);
+            for (const auto& completion : drained) {
+                if (completion.type == CompletionType::ACCEPTED) {
+                    assert(!placed.count(completion.ticket));
+                    placed[completion.ticket] = {"GC" + std::to_string(c), completion.orderId};
+                } else {
+                    assert(completion.type == CompletionType::FILL && placed.count(completion.ticket));
+                    filled[completion.ticket] += completion.quantity;
+                    totalFilled += completion.quantity;
+                }
+            }
+        }
+        assert(placed.size() == submitted.size());
+        for (const auto& [ticket, where] : placed) {
+            auto order = shared.getOrderStatus(where.first, where.second);
+            assert(order && filled[ticket] == order->getFilledQuantity());
+            assert(filled[ticket] <= submitted[ticket]);
+        }
+        Quantity resting = 0;
+        for (const auto& level : shared.getBidDepth("CROWD", 5)) resting += level.quantity;
+        for (const auto& level : shared.getAskDepth("CROWD", 5)) resting += level.quantity;
+        Quantity total = 0;
+        for (const auto& [ticket, quantity] : submitted) total += quantity;
+        assert(totalFilled + resting == total);
+    }
+    
+    std::cout << "PASS: Asynchronous Order Gateway Test" << std::endl;
+    return true;
+}
+
+bool testCoroutineStrategies() {
+    std::cout << "\n=== Test 29: Coroutine Strategies ===" << std::endl;
+    
+    TradingEngine engine;
+    const int pairs = 50;
+    for (int i = 0; i < pairs; ++i) {
+        engine.registerUser(std::make_shared<User>("CB" + std::to_string(i), "Coroutine Buyer", "2929292929", "cb@test.com"));
+        engine.registerUser(std::make_shared<User>("CS" + std::to_string(i), "Coroutine Seller", "2929292930", "cs@test.com"));
+    }
+    
+    AsyncOrderGateway gateway(engine, 2);
+    StrategyScheduler scheduler(gateway);
+    
+    // Each seller rests an offer; its buyer lifts it in three clips and the seller
+    // awaits every fill. A hundred strategies share the test thread.
+    std::atomic<int> finished{0};
+    Quantity bought = 0, sold = 0;
+    auto seller = [&](StrategySession& session, Symbol symbol) -> StrategyTask {
+        OrderHandle offer = co_await session.place(OrderType::SELL, symbol, 30, 100.0);
+        assert(offer.isAccepted() && !offer.getOrderId().empty());
+        while (auto fill = co_await offer.nextFill()) {
+            assert(fill->price == 100.0);
+            sold += fill->quantity;
+        }
+        assert(!offer.isOpen() && offer.getFilledQuantity() == 30);
+        ++finished;
+    };
+    auto buyer = [&](StrategySession& session, Symbol symbol) -> StrategyTask {
+        for (int clip = 0; clip < 3; ++clip) {
+            OrderHandle bid = co_await session.place(OrderType::BUY, symbol, 10, 100.0);
+            assert(bid.isAccepted());
+            auto fill = co_await bid.nextFill();
+            assert(fill);
+            assert(fill->quantity == 10 && fill->price == 100.0);
+            assert(!(co_await bid.nextFill()));
+            bought += fill->quantity;
+        }
+        ++finished;
+    };
+    for (int i = 0; i < pairs; ++i) {
+        Symbol symbol = "CO" + std::to_string(i);
+        scheduler.spawn(seller(scheduler.session("CS" + std::to_string(i)), symbol));
+        scheduler.spawn(buyer(scheduler.session("CB" + std::to_string(i)), symbol));
+    }
+    assert(scheduler.getActiveCount() == 2 * pairs);
+    scheduler.run();
+    assert(finished == 2 * pairs && scheduler.getActiveCount() == 0);
+    assert(bought == 30 * pairs && sold == 30 * pairs);
+    
+    // Rejects, modifies and cancels resume the strategy with their outcome
+    auto lifecycle = [&](StrategySession& session) -> StrategyTask {
+        OrderHandle bad = co_await session.place(OrderType::BUY, "COLIFE", 10, -1.0);
+        assert(!bad.isAccepted() && !bad.isOpen() && !(co_await bad.nextFill()));
+        
+        OrderHandle bid = co_await session.place(OrderType::BUY, "COLIFE", 10, 50.0);
+        assert(bid.isAccepted());
+        assert(co_await session.modify(bid, 20, 51.0));
+        assert(co_await session.cancel(bid));
+        assert(!bid.isOpen() && !(co_await bid.nextFill()));
+        assert(!(co_await session.cancel(bid)));   // already closed
+        ++finished;
+    };
+    scheduler.spawn(lifecycle(scheduler.session("CB0")));
+    scheduler.run();
+    assert(finished == 2 * pairs + 1);
+    assert(engine.getBidDepth("COLIFE", 5).empty());
+    
+    // An exception escaping a strategy surfaces from run()
+    auto failing = [](StrategySession& session) -> StrategyTask {
+        co_await session.place(OrderType::BUY, "COFAIL", 1, 10.0);
+        throw std::runtime_error("strategy failed");
+    };
+    scheduler.spawn(failing(scheduler.session("CB1")));
+    bool thrown = false;
+    try {
+        scheduler.run();
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown && scheduler.getActiveCount() == 0);
+    
+    std::cout << "PASS: Coroutine Strategies Test" << std::endl;
+    return true;
+}
+
+bool testSymbolScheduler() {
+    std::cout << "\n=== Test 30: Work-Stealing Symbol Scheduler ===" << std::endl;
+    
+    // Each symbol's state is touched only by its own commands; `running` catches two
+    // workers inside the same symbol at once
+    struct SymbolState {
+        std::atomic<int> running{0};
+        std::vector<int> sequence;
+        std::set<int> workers;
+    };
+    const int symbols = 16;
+    std::vector<SymbolState> states(symbols);
+    std::vector<int> submitted(symbols, 0);
+    std::atomic<bool> overlap{false};
+    auto reset = [&] {
+        for (auto& state : states) {
+            state.sequence.clear();
+            state.workers.clear();
+        }
+        std::fill(submitted.begin(), submitted.end(), 0);
+    };
+    auto submit = [&](SymbolScheduler& scheduler, int symbol) {
+        int n = submitted[symbol]++;
+        scheduler.submit("WS" + std::to_string(symbol), [&, symbol, n] {
+            SymbolState& state = states[symbol];
+            if (state.running.fetch_add(1) != 0) overlap = true;
+            state.sequence.push_back(n);
+            state.workers.insert(scheduler.currentWorker());
+            state.running.fetch_sub(1);
+        });
+    };
+    auto checkOrder = [&] {
+        for (int s = 0; s < symbols; ++s) {
+            assert(states[s].sequence.size() == static_cast<size_t>(submitted[s]));
+            for (int i = 0; i < submitted[s]; ++i) assert(states[s].sequence[i] == i);
+        }
+        assert(!overlap);
+    };
+
+    SymbolSchedulerConfig config;
+    config.workers = 4;
+    config.quantum = 8;
+    std::mt19937 rng(30);
+    {
+        // Skewed flow, half of it on WS0: per-symbol order survives stealing
+        SymbolScheduler scheduler(config);
+        assert(scheduler.getWorkerCount() == 4 && scheduler.currentWorker() == -1);
+        for (int i = 0; i < 20000; ++i) submit(scheduler, rng() % 2 ? 0 : static_cast<int>(rng() % symbols));
+        scheduler.drain();
+        checkOrder();
+        SymbolSchedulerStats stats = scheduler.getStats();
+        assert(stats.executed == 20000 && stats.failed == 0);
+        
+        // The load window shows the hot symbol; with maxDedicated = 0 it is only reported
+        auto loads = scheduler.rebalance();
+        assert(loads.size() == symbols && loads[0].symbol == "WS0" && loads[0].share > 0.4);
+        assert(loads[0].dedicatedWorker == -1);
+        assert(scheduler.rebalance()[0].commands == 0);   // a new window
+        
+        // A pinned symbol runs only on its worker, and nothing else runs there
+        assert(scheduler.pin("WS0", 3) && scheduler.getDedicatedWorker("WS0") == 3);
+        assert(!scheduler.pin("WS1", 3) && !scheduler.pin("WS1", 4));
+        reset();
+        for (int i = 0; i < 5000; ++i) submit(scheduler, i % 2 ? 0 : static_cast<int>(1 + rng() % (symbols - 1)));
+        scheduler.drain();
+        checkOrder();
+        assert(states[0].workers == std::set<int>{3});
+        for (int s = 1; s < symbols; ++s) assert(!states[s].workers.count(3));
+        assert(scheduler.unpin("WS0") && !scheduler.unpin("WS0") && scheduler.getDedicatedWorker("WS0") == -1);
+        
+        // A throwing command is counted and the symbol keeps running
+        scheduler.submit("WS1", [] { throw std::runtime_error("command failed"); });
+        reset();
+        submit(scheduler, 1);
+        scheduler.drain();
+        assert(scheduler.getStats().failed == 1 && states[1].sequence.size() == 1);
+    }
+    
+    {
+        // Static partition: every symbol stays on one worker. rebalance() pins the hot
+        // symbol to the highest free worker and releases it once the flow evens out.
+        config.workStealing = false;
+        config.maxDedicated = 1;
+        SymbolScheduler scheduler(config);
+        reset();
+        for (int i = 0; i < 8000; ++i) submit(scheduler, i % 2 ? 5 : i / 2 % symbols);
+        scheduler.drain();
+        checkOrder();
+        for (int s = 0; s < symbols; ++s) assert(states[s].workers.size() == 1);
+        assert(scheduler.getStats().steals == 0);
+        
+        auto loads = scheduler.rebalance();
+        assert(loads[0].symbol == "WS5" && loads[0].dedicatedWorker == 3);
+        assert(scheduler.getDedicatedWorker("WS5") == 3);
+        assert(loads[1].dedicatedWorker == -1);   // maxDedicated reached
+        
+        for (int i = 0; i < 1600; ++i) submit(scheduler, i % symbols);
+        scheduler.drain();
+        scheduler.rebalance();
+        assert(scheduler.getDedicatedWorker("WS5") == -1);
+    }
+    
+    std::cout << "PASS: Work-Stealing Symbol Scheduler Test" << std::endl;
+    return true;
+}
+
+bool testThreadPlacement() {
+    std::cout << "\n=== Test 31: Thread Placement and Wait Strategies ===" << std::endl;
+    
+    // CPU lists and layouts
+    assert((ThreadPlacement::parseCpuList("0-2,5") == std::vector<int>{0, 1, 2, 5}));
+    bool rejected = false;
+    try { ThreadPlacement::parseCpuList("3-1"); } catch (const std::invalid_argument&) { rejected = true; }
+    assert(rejected);
+    
+    ThreadLayout layout = ThreadLayout::parse("shard=0-1 gateway=0 wait=busy-spin gateway.wait=block journal.numa=0");
+    assert((layout.group("shard").cpus == std::vector<int>{0, 1}));
+    assert(layout.group("shard").waitStrategy == WaitStrategy::BUSY_SPIN);   // default set after the role
+    assert(layout.group("gateway").waitStrategy == WaitStrategy::BLOCK);
+    assert(layout.group("journal").cpus.empty() && !layout.group("journal").numaLocalMemory);
+    assert(layout.group("publisher").waitStrategy == WaitStrategy::BUSY_SPIN);   // unnamed role
+    for (const char* bad : {"shard", "shard=x", "wait=sleepy", "shard.color=red"}) {
+        rejected = false;
+        try { ThreadLayout::parse(bad); } catch (const std::invalid_argument&) { rejected = true; }
+        assert(rejected);
+    }
+    assert(ThreadLayout::parse("").groups.empty());
+    assert(parseWaitStrategy(toString(WaitStrategy::SPIN_YIELD)) == WaitStrategy::SPIN_YIELD);
+    
+    // Pinning (checked on a scratch thread so the test thread keeps its affinity)
+    std::thread([] {
+        ThreadGroupConfig group;
+        group.cpus = {0};
+        assert(ThreadPlacement::apply(group, 7));
+        assert(ThreadPlacement::currentCpu() == 0);
+        assert(!ThreadPlacement::pinCurrentThread(ThreadPlacement::cpuCount() + 4096));
+        std::cout << "CPU 0 is on NUMA node " << ThreadPlacement::numaNodeOf(0) << std::endl;
+    }).join();
+    
+    // A blocked waiter wakes on notify, and times out without one
+    WorkSignal signal;
+    std::uint32_t seen = signal.epoch();
+    assert(!signal.wait(seen, WaitStrategy::BLOCK, std::chrono::microseconds(200)));
+    assert(!signal.wait(seen, WaitStrategy::BUSY_SPIN, std::chrono::microseconds::zero(), 100));
+    std::atomic<bool> woke{false};
+    std::thread waiter([&] {
+        while (!signal.wait(seen, WaitStrategy::BLOCK, std::chrono::microseconds::zero())) {}
+        woke = true;
+    });
+    while (!signal.hasBlockedWaiter()) std::this_thread::yield();
+    signal.notify();
+    waiter.join();
+    assert(woke && signal.epoch() != seen);
+    
+    // Shard and gateway workers behave the same under every wait strategy
+    for (WaitStrategy strategy : {WaitStrategy::BLOCK, WaitStrategy::SPIN_YIELD, WaitStrategy::BUSY_SPIN}) {
+        SymbolSchedulerConfig config;
+        config.workers = 2;
+        config.threads.cpus = {0};
+        config.threads.waitStrategy = strategy;
+        std::vector<std::vector<int>> seenBySymbol(4);
+        {
+            SymbolScheduler scheduler(config);
+            for (int i = 0; i < 2000; ++i) {
+                scheduler.submit("WAIT" + std::to_string(i % 4), [&seenBySymbol, i] { seenBySymbol[i % 4].push_back(i); });
+            }
+            scheduler.drain();
+        }
+        for (int s = 0; s < 4; ++s) {
+            assert(seenBySymbol[s].size() == 500);
+            for (size_t k = 0; k < 500; ++k) assert(seenBySymbol[s][k] == static_cast<int>(4 * k) + s);
+        }
+        
+        TradingEngine engine;
+        engine.registerUser(std::make_shared<User>("W1", "Waiting Trader", "3131313131", "w1@test.com"));
+        AsyncOrderGateway gateway(engine, 1, config.threads);
+        auto queue = gateway.connect("W1");
+        for (int i = 0; i < 50; ++i) gateway.submitOrder("W1", OrderType::BUY, "WAITS", 1, 50.0);
+        gateway.flush();
+        assert(queue->size() == 50);
+    }
+    
+    std::cout << "PASS: Thread Placement and Wait Strategies Test" << std::endl;
+    return true;
+}
+
+bool testRingQueues() {
+    std::cout << "\n=== Test 32: Lock-free Ring Queues ===" << std::endl;
+    
+    // Capacity rounds up to a power of two; a full ring takes only what fits
+    SpscRing<int> spsc(5);
+    assert(spsc.capacity() == 8 && spsc.empty());
+    int values[12];
+    for (int i = 0; i < 12; ++i) values[i] = i;
+    assert(spsc.tryPushBatch(values, 12) == 8);
+    assert(!spsc.tryPush(99) && spsc.size() == 8);
+    int out[12];
+    assert(spsc.tryPopBatch(out, 3) == 3 && out[0] == 0 && out[2] == 2);
+    assert(spsc.tryPushBatch(values + 8, 4) == 3);   // wraps around the end of the slots
+    assert(spsc.tryPopBatch(out, 12) == 8);
+    for (int i = 0; i < 8; ++i) assert(out[i] == i + 3);
+    assert(!spsc.tryPop(out[0]) && spsc.empty());
+    
+    // Move-only payloads, and the blocking pop with a timeout on an empty ring
+    MpscRing<std::unique_ptr<int>> owned(4);
+    assert(owned.tryPush(std::make_unique<int>(7)));
+    std::unique_ptr<int> item;
+    assert(owned.popBatch(&item, 1, WaitStrategy::BLOCK, std::chrono::microseconds(100)) == 1 && *item == 7);
+    assert(owned.popBatch(&item, 1, WaitStrategy::BLOCK, std::chrono::microseconds(100)) == 0);
+    
+    // Several producers through a small ring: each producer's items arrive in order
+    const int producers = 3, perProducer = 20000;
+    MpscRing<std::pair<int, int>> mpsc(16);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&mpsc, p] {
+            for (int i = 0; i < perProducer; ++i) mpsc.push({p, i});
+        });
+    }
+    std::vector<int> next(producers, 0);
+    std::pair<int, int> batch[8];
+    for (int received = 0; received < producers * perProducer;) {
+        size_t count = mpsc.popBatch(batch, 8);
+        for (size_t i = 0; i < count; ++i) assert(batch[i].second == next[batch[i].first]++);
+        received += static_cast<int>(count);
+    }
+    for (auto& thread : threads) thread.join();
+    for (int p = 0; p < producers; ++p) assert(next[p] == perProducer);
+    
+    // Gateway with a tiny command ring (submitters wait for room) and a publisher
+    // thread delivering the completions: same ordering guarantees as before
+    TradingEngine engine;
+    engine.registerUser(std::make_shared<User>("R1", "Ring Buyer", "3232323232", "r1@test.com"));
+    engine.registerUser(std::make_shared<User>("R2", "Ring Seller", "3232323233", "r2@test.com"));
+    GatewayConfig config;
+    config.workers = 2;
+    config.commandQueueCapacity = 8;
+    config.publisher = true;
+    config.eventQueueCapacity = 8;
+    std::shared_ptr<CompletionQueue> buyer, seller;
+    std::vector<Ticket> buys;
+    {
+        AsyncOrderGateway gateway(engine, config);
+        buyer = gateway.connect("R1");
+        seller = gateway.connect("R2");
+        for (int i = 0; i < 100; ++i) buys.push_back(gateway.submitOrder("R1", OrderType::BUY, "RINGS", 10, 100.0));
+        gateway.submitOrder("R2", OrderType::SELL, "RINGS", 1000, 100.0);
+        gateway.flush();
+        
+        assert(buyer->size() == 200);
+        std::map<Ticket, int> state;   // 0 = nothing seen, 1 = acked, 2 = filled
+        Completion completions[64];
+        while (size_t count = buyer->poll(completions, 64)) {
+            for (size_t i = 0; i < count; ++i) {
+                int expected = completions[i].type == CompletionType::ACCEPTED ? 0 : 1;
+                assert(state[completions[i].ticket] == expected);
+                state[completions[i].ticket] = expected + 1;
+            }
+        }
+        for (Ticket ticket : buys) assert(state[ticket] == 2);
+        assert(seller->size() == 101);   // ack plus one fill per buy
+        
+        // Requests still queued at shutdown are executed and published
+        for (int i = 0; i < 30; ++i) gateway.submitOrder("R1", OrderType::BUY, "RINGS", 1, 90.0);
+    }
+    assert(buyer->size() == 30);
+    
+    std::cout << "PASS: Lock-free Ring Queues Test" << std::endl;
+    return true;
+}
+
+// Holds the gateway worker inside the engine call that places an order on
+// `symbol`, so a test can queue requests behind it deterministically
+class WorkerGate : public TradeObserver {
+private:
+    Symbol symbol_;
+    std::promise<void> entered_;
+    std::shared_future<void> release_;
+    std::atomic<bool> armed_{true};
+
+public:
+    WorkerGate(Symbol symbol, std::shared_future<void> release)
+        : symbol_(std::move(symbol)), release_(std::move(release)) {}
+        
+    void waitUntilEntered() { entered_.get_future().wait(); }
+    
+    void onTradeExecuted(const std::shared_ptr<Trade>&) override {}
+    void onOrderStatusChanged(const std::shared_ptr<Order>& order) override {
+        if (order->getSymbol() != symbol_ || !armed_.exchange(false)) return;
+        entered_.set_value();
+        release_.wait();
+    }
+};
+
+bool testPriorityLanes() {
+    std::cout << "\n=== Test 33: Priority Lanes for Cancels ===" << std::endl;
+    
+    TradingEngine engine;
+    engine.registerUser(std::make_shared<User>("P1", "Lane Trader", "3333333333", "p1@test.com"));
+    GatewayConfig config;
+    config.priorityLanes = true;
+    config.priorityBurst = 4;
+    config.normalBurst = 2;
+    AsyncOrderGateway gateway(engine, config);
+    auto queue = gateway.connect("P1");
+    
+    std::vector<Completion> drained;
+    auto drain = [&drained, &queue] {
+        drained.clear();
+        Completion batch[64];
+        while (size_t count = queue->poll(batch, 64)) drained.insert(drained.end(), batch, batch + count);
+        return drained.size();
+    };
+
+    gateway.submitOrder("P1", OrderType::BUY, "LANES", 100, 50.0);
+    gateway.flush();
+    assert(drain() == 1 && drained[0].type == CompletionType::ACCEPTED);
+    OrderId resting = drained[0].orderId;
+    
+    // Burst of new orders queued behind a busy worker, then a cancel: the cancel
+    // runs first, ahead of the whole backlog
+    std::promise<void> release;
+    WorkerGate gate("LANEGATE", release.get_future().share());
+    engine.registerObserver(&gate);
+    gateway.submitOrder("P1", OrderType::BUY, "LANEGATE", 1, 10.0);
+    gate.waitUntilEntered();
+    
+    std::vector<Ticket> backlog;
+    for (int i = 0; i < 100; ++i) backlog.push_back(gateway.submitOrder("P1", OrderType::BUY, "LANES", 1, 40.0));
+    Ticket reduce = gateway.submitModify("P1", resting, 60, 50.0);     // same price, smaller: priority
+    Ticket reprice = gateway.submitModify("P1", resting, 60, 51.0);    // follows the queued reduce
+    Ticket cancel = gateway.submitCancel("P1", resting);
+    
+    GatewayStats stats = gateway.getStats();
+    assert(stats.priorityLane.size() == 1 && stats.normalLane.size() == 1);
+    assert(stats.priorityLane[0].depth == 3 && stats.normalLane[0].depth == 100);
+    
+    release.set_value();
+    gateway.flush();
+    engine.unregisterObserver(&gate);
+    assert(drain() == 104);
+    assert(drained[0].type == CompletionType::ACCEPTED);   // the gated order
+    assert(drained[1].ticket == reduce && drained[1].type == CompletionType::MODIFIED);
+    assert(drained[2].ticket == reprice && drained[2].type == CompletionType::MODIFIED);
+    assert(drained[3].ticket == cancel && drained[3].type == CompletionType::CANCELLED);
+    for (int i = 0; i < 100; ++i) assert(drained[4 + i].ticket == backlog[i]);
+    
+    stats = gateway.getStats();
+    assert(stats.priorityLane[0].depth == 0 && stats.normalLane[0].depth == 0);
+    assert(stats.priorityLane[0].peakDepth == 3 && stats.normalLane[0].peakDepth == 100);
+    assert(stats.priorityLane[0].executed == 3 && stats.normalLane[0].executed == 102);
+    
+    // A reduction queued behind a normal-lane modify of the same order must not
+    // overtake it: the order ends at the last requested quantity
+    gateway.submitOrder("P1", OrderType::BUY, "LANES", 10, 45.0);
+    gateway.flush();
+    assert(drain() == 1 && drained[0].type == CompletionType::ACCEPTED);
+    OrderId grown = drained[0].orderId;
+    std::promise<void> release3;
+    WorkerGate gate3("LANEGATE", release3.get_future().share());
+    engine.registerObserver(&gate3);
+    gateway.submitOrder("P1", OrderType::BUY, "LANEGATE", 1, 10.0);
+    gate3.waitUntilEntered();
+    Ticket grow = gateway.submitModify("P1", grown, 20, 45.0);      // larger: normal lane
+    Ticket shrink = gateway.submitModify("P1", grown, 5, 45.0);     // smaller, but must wait behind it
+    Ticket pull = gateway.submitCancel("P1", grown);                // likewise
+    stats = gateway.getStats();
+    assert(stats.priorityLane[0].depth == 0 && stats.normalLane[0].depth == 3);
+    release3.set_value();
+    gateway.flush();
+    engine.unregisterObserver(&gate3);
+    assert(drain() == 4);
+    assert(drained[1].ticket == grow && drained[1].type == CompletionType::MODIFIED);
+    assert(drained[2].ticket == shrink && drained[2].type == CompletionType::MODIFIED);
+    assert(drained[3].ticket == pull && drained[3].type == CompletionType::CANCELLED);
+    assert(engine.getOrderStatus("P1", grown)->getQuantity() == 5);
+    
+    // Fairness: under a flood of cancels the normal lane still gets normalBurst
+    // requests for every priorityBurst cancels
+    std::promise<void> release2;
+    WorkerGate gate2("LANEGATE", release2.get_future().share());
+    engine.registerObserver(&gate2);
+    gateway.submitOrder("P1", OrderType::BUY, "LANEGATE", 1, 10.0);
+    gate2.waitUntilEntered();
+    std::set<Ticket> cancels;
+    for (int i = 0; i < 10; ++i) {
+        cancels.insert(gateway.submitCancel("P1", "NO_SUCH_ORDER"));
+        gateway.submitOrder("P1", OrderType::BUY, "LANES", 1, 40.0);
+    }
+    release2.set_value();
+    gateway.flush();
+    engine.unregisterObserver(&gate2);
+    assert(drain() == 21);
+    std::string pattern;
+    for (size_t i = 1; i < drained.size(); ++i) pattern += cancels.count(drained[i].ticket) ? 'C' : 'N';
+    assert(pattern == "CCCCNNCCCCNNCCNNNNNN");
+    
+    // Without priority lanes everything keeps submission order in the normal lane
+    AsyncOrderGateway plain(engine);
+    auto plainQueue = plain.connect("P1");
+    plain.submitCancel("P1", "NO_SUCH_ORDER");
+    plain.flush();
+    GatewayStats plainStats = plain.getStats();
+    assert(plainStats.priorityLane[0].executed == 0 && plainStats.normalLane[0].executed == 1);
+    
+    std::cout << "PASS: Priority Lanes Test" << std::endl;
+    return true;
+}
+
 int main() {
     std::cout << "STARTING COMPREHENSIVE TRADING SYSTEM TESTS" << std::endl;
     std::cout << "===========================================" << std::endl;
@@ -394,6 +2310,29 @@ int main() {
         allTestsPassed &= testInvalidOrders();
         allTestsPassed &= testMarketDataQueries();
         allTestsPassed &= testMultipleSymbols();
+        allTestsPassed &= testOrderThrottling();
+        allTestsPassed &= testKillSwitch();
+        allTestsPassed &= testStopOrders();
+        allTestsPassed &= testIcebergOrders();
+        allTestsPassed &= testPeggedOrders();
+        allTestsPassed &= testOrderExpiry();
+        allTestsPassed &= testCallAuction();
+        allTestsPassed &= testFrequentBatchAuction();
+        allTestsPassed &= testProRataMatching();
+        allTestsPassed &= testPolicyOrderBooks();
+        allTestsPassed &= testLatencyHistograms();
+        allTestsPassed &= testTscClock();
+        allTestsPassed &= testDeterministicSimulation();
+        allTestsPassed &= testIndependentEngines();
+        allTestsPassed &= testBacktestReplay();
+        allTestsPassed &= testOrderFlowIngestion();
+        allTestsPassed &= testBatchOrderEntry();
+        allTestsPassed &= testAsyncOrderGateway();
+        allTestsPassed &= testCoroutineStrategies();
+        allTestsPassed &= testSymbolScheduler();
+        allTestsPassed &= testThreadPlacement();
+        allTestsPassed &= testRingQueues();
+        allTestsPassed &= testPriorityLanes();
         
         // Run concurrency test last
         allTestsPassed &= testConcurrency();